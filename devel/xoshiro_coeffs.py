@@ -148,3 +148,153 @@ print("2^160 =", ' '.join([f"0x{w:016x}" for w in gen_2p160]))
 # - If you need many different N, consider switching to the polynomial method:
 #     compute the characteristic/minimal polynomial P(x) once, then use
 #     x^N mod P(x) to get the coefficients without touching 256×256 matrices.
+
+# -----------------------------------------------------------------------------
+# Jump table for O(log n) jump-ahead (include/random/xoshiro_jump.hpp).
+#
+# The characteristic polynomial P(x) of T is recovered with Berlekamp-Massey
+# from the bit sequence e0^T T^k s. A jump of N steps is then x^N mod P(x), so
+# the jump polynomials for every power of two follow by repeated squaring and
+# any distance costs one multiplication per set bit. Polynomials are plain
+# Python integers here (bit i = coefficient of x^i).
+# -----------------------------------------------------------------------------
+
+def berlekamp_massey(bits):
+    """Connection polynomial (as int) and linear complexity of a GF(2) sequence."""
+    c, b = 1, 1
+    L, m = 0, 1
+    for n in range(len(bits)):
+        d = bits[n]
+        for i in range(1, L + 1):
+            d ^= ((c >> i) & 1) & bits[n - i]
+        if d == 0:
+            m += 1
+        elif 2 * L <= n:
+            c, b = c ^ (b << m), c
+            L, m = n + 1 - L, 1
+        else:
+            c ^= b << m
+            m += 1
+    return c, L
+
+
+def characteristic_polynomial():
+    s = [0x0123456789abcdef, 0x0fedcba987654321, 0x0f0f0f0f0f0f0f0f, 0x1111111111111111]
+    bits = []
+    for _ in range(1024):
+        bits.append(s[0] & 1)
+        s = next_state_u64(s)
+    c, L = berlekamp_massey(bits)
+    assert L == 256
+    # the characteristic polynomial is the reciprocal of the connection polynomial
+    return sum(1 << (256 - i) for i in range(257) if (c >> i) & 1)
+
+
+P = characteristic_polynomial()
+
+
+def poly_mulmod(a, b):
+    r = 0
+    for i in reversed(range(256)):
+        r <<= 1
+        if r >> 256:
+            r ^= P
+        if (b >> i) & 1:
+            r ^= a
+    return r
+
+
+def poly_words(p):
+    return [(p >> (64 * i)) & MASK64 for i in range(4)]
+
+
+JUMP_TABLE = [2]
+for _ in range(255):
+    JUMP_TABLE.append(poly_mulmod(JUMP_TABLE[-1], JUMP_TABLE[-1]))
+
+assert poly_words(JUMP_TABLE[128]) == REF_JUMP_2P128
+assert poly_words(JUMP_TABLE[192]) == REF_JUMP_2P192
+assert poly_words(JUMP_TABLE[160]) == gen_2p160
+
+
+def fmt_poly(p):
+    return "{" + ", ".join(f"0x{w:016x}" for w in poly_words(p)) + "}"
+
+
+print("XOSHIRO256_CHARPOLY =", fmt_poly(P & ((1 << 256) - 1)))
+print("XOSHIRO256_JUMP_TABLE =")
+for p in JUMP_TABLE:
+    print(f"    jump_poly{fmt_poly(p)},")
+
+# -----------------------------------------------------------------------------
+# xoshiro128 jump table (include/random/xoshiro_jump.hpp).
+#
+# Same construction on the 128-bit engine. Its period is 2^128 - 1, so
+# x^(2^128) = x and the table only needs 128 entries: a jump of k * 2^96 steps
+# wraps around to entry (96 + i) mod 128 for bit i of k.
+# -----------------------------------------------------------------------------
+
+MASK32 = (1 << 32) - 1
+
+
+def next_state_u32(s):
+    """One step of the xoshiro128 linear core, state [s0, s1, s2, s3] of uint32."""
+    s0, s1, s2, s3 = s
+    t = (s1 << 9) & MASK32
+    s2 ^= s0
+    s3 ^= s1
+    s1 ^= s2
+    s0 ^= s3
+    s2 ^= t
+    s3 = ((s3 << 11) | (s3 >> 21)) & MASK32
+    return [s0, s1, s2, s3]
+
+
+def characteristic_polynomial128():
+    s = [0x01234567, 0x89abcdef, 0x0f0f0f0f, 0x11111111]
+    bits = []
+    for _ in range(512):
+        bits.append(s[0] & 1)
+        s = next_state_u32(s)
+    c, L = berlekamp_massey(bits)
+    assert L == 128
+    return sum(1 << (128 - i) for i in range(129) if (c >> i) & 1)
+
+
+P128 = characteristic_polynomial128()
+
+
+def poly_mulmod128(a, b):
+    r = 0
+    for i in reversed(range(128)):
+        r <<= 1
+        if r >> 128:
+            r ^= P128
+        if (b >> i) & 1:
+            r ^= a
+    return r
+
+
+def poly_words128(p):
+    return [(p >> (32 * i)) & MASK32 for i in range(4)]
+
+
+JUMP_TABLE128 = [2]
+for _ in range(127):
+    JUMP_TABLE128.append(poly_mulmod128(JUMP_TABLE128[-1], JUMP_TABLE128[-1]))
+
+# reference jump() and long_jump() constants of xoshiro128
+assert poly_words128(JUMP_TABLE128[64]) == [0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b]
+assert poly_words128(JUMP_TABLE128[96]) == [0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662]
+# maximal period: squaring wraps around to x
+assert poly_mulmod128(JUMP_TABLE128[127], JUMP_TABLE128[127]) == 2
+
+
+def fmt_poly128(p):
+    return "{" + ", ".join(f"0x{w:08x}" for w in poly_words128(p)) + "}"
+
+
+print("XOSHIRO128_CHARPOLY =", fmt_poly128(P128 & ((1 << 128) - 1)))
+print("XOSHIRO128_JUMP_TABLE =")
+for p in JUMP_TABLE128:
+    print(f"    jump_poly128{fmt_poly128(p)},")
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+using aes_block = std::array<std::uint8_t, 16>;
+using aes_key = std::array<std::uint8_t, 16>;
+// AES-128 has ten rounds, hence eleven round keys
+using aes_round_keys = std::array<aes_block, 11>;
+
+inline constexpr std::array<std::uint8_t, 256> AES_SBOX = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+/**
+ * Multiplication by x in GF(2^8) modulo the AES polynomial.
+ */
+PRNG_ALWAYS_INLINE constexpr std::uint8_t aes_xtime(const std::uint8_t x) noexcept {
+  return static_cast<std::uint8_t>((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+/**
+ * The AES-128 key schedule (FIPS-197, section 5.2).
+ * @param key The 128-bit key.
+ * @return The eleven round keys.
+ */
+PRNG_ALWAYS_INLINE constexpr aes_round_keys aes_expand_key(const aes_key &key) noexcept {
+  aes_round_keys round_keys{};
+  round_keys[0] = key;
+  std::uint8_t rcon = 1;
+  for (auto round = std::size_t{1}; round < round_keys.size(); ++round) {
+    const auto &previous = round_keys[round - 1];
+    auto &current = round_keys[round];
+    // RotWord, SubWord and the round constant on the last word of the previous round key
+    const std::array<std::uint8_t, 4> temp = {
+      static_cast<std::uint8_t>(AES_SBOX[previous[13]] ^ rcon), AES_SBOX[previous[14]], AES_SBOX[previous[15]],
+      AES_SBOX[previous[12]]};
+    for (auto i = std::size_t{0}; i < 4; ++i) {
+      current[i] = static_cast<std::uint8_t>(previous[i] ^ temp[i]);
+    }
+    for (auto i = std::size_t{4}; i < 16; ++i) {
+      current[i] = static_cast<std::uint8_t>(previous[i] ^ current[i - 4]);
+    }
+    rcon = aes_xtime(rcon);
+  }
+  return round_keys;
+}
+
+/**
+ * One AES round, with the same semantics as the `aesenc` (`last` = false) and `aesenclast` (`last` = true)
+ * instructions: SubBytes, ShiftRows, MixColumns unless `last`, then AddRoundKey.
+ */
+PRNG_ALWAYS_INLINE constexpr aes_block aes_round(const aes_block &state, const aes_block &round_key,
+                                                 const bool last) noexcept {
+  aes_block shifted{};
+  // the state is column major: byte 4 * c + r is row r of column c, and row r is rotated left by r columns
+  for (auto c = std::size_t{0}; c < 4; ++c) {
+    for (auto r = std::size_t{0}; r < 4; ++r) {
+      shifted[4 * c + r] = AES_SBOX[state[4 * ((c + r) % 4) + r]];
+    }
+  }
+  aes_block result{};
+  for (auto c = std::size_t{0}; c < 4; ++c) {
+    const auto *const column = shifted.data() + 4 * c;
+    for (auto r = std::size_t{0}; r < 4; ++r) {
+      auto value = column[r];
+      if (!last) {
+        // 2 * a[r] ^ 3 * a[r + 1] ^ a[r + 2] ^ a[r + 3]
+        value = static_cast<std::uint8_t>(aes_xtime(column[r]) ^ aes_xtime(column[(r + 1) % 4]) ^
+                                          column[(r + 1) % 4] ^ column[(r + 2) % 4] ^ column[(r + 3) % 4]);
+      }
+      result[4 * c + r] = static_cast<std::uint8_t>(value ^ round_key[4 * c + r]);
+    }
+  }
+  return result;
+}
+
+/**
+ * Encrypts one block with the first `R` rounds of AES-128; `R` = 10 is standard AES-128.
+ * @tparam R The number of rounds, in [1, 10].
+ * @param block The plaintext block.
+ * @param round_keys The round keys from aes_expand_key().
+ * @return The ciphertext block.
+ */
+template <std::uint8_t R>
+PRNG_ALWAYS_INLINE constexpr aes_block aes_encrypt(const aes_block &block, const aes_round_keys &round_keys) noexcept {
+  static_assert(R >= 1 && R <= 10, "AES-128 has between 1 and 10 rounds");
+  aes_block state{};
+  for (auto i = std::size_t{0}; i < state.size(); ++i) {
+    state[i] = static_cast<std::uint8_t>(block[i] ^ round_keys[0][i]);
+  }
+  for (auto round = std::size_t{1}; round < R; ++round) {
+    state = aes_round(state, round_keys[round], false);
+  }
+  return aes_round(state, round_keys[R], true);
+}
+
+/**
+ * The counter block of AESCTR: the counter in bytes 0 to 7 and the nonce in bytes 8 to 15, both little-endian.
+ */
+PRNG_ALWAYS_INLINE constexpr aes_block aes_counter_block(const std::uint64_t counter,
+                                                         const std::uint64_t nonce) noexcept {
+  aes_block block{};
+  for (auto i = std::size_t{0}; i < 8; ++i) {
+    block[i] = static_cast<std::uint8_t>(counter >> (8 * i));
+    block[8 + i] = static_cast<std::uint8_t>(nonce >> (8 * i));
+  }
+  return block;
+}
+
+}
+
+/**
+ * @class AESCTR
+ * @brief Scalar AES-128 generator in counter mode, the portable reference of AESCTRDispatch.
+ *
+ * Block `c` is the encryption of the 128-bit block holding the 64-bit counter `c` in its low half and the nonce in its
+ * high half, both little-endian, and gives two 64-bit outputs, the first 8 ciphertext bytes first. The counter wraps
+ * modulo 2^64 and the nonce never changes. With `R` = 10 this is AES-128; fewer rounds trade security margin for speed,
+ * like Random123's ARS, which passes BigCrush with 5 rounds of the AES round function.
+ *
+ * @tparam R The number of AES rounds, in [1, 10].
+ */
+template <std::uint8_t R = 10> class AESCTR {
+public:
+  using result_type = std::uint64_t;
+  using input_word = std::uint64_t;
+  using key_type = internal::aes_key;
+  using block_type = std::array<result_type, 2>;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return (std::numeric_limits<result_type>::min)(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return (std::numeric_limits<result_type>::max)(); }
+
+  /**
+   * @brief Construct an AES-CTR generator with given key, counter and nonce.
+   * @param key The 128-bit AES key.
+   * @param counter Initial value of the counter.
+   * @param nonce The nonce.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit AESCTR(const key_type &key, const input_word counter,
+                                               const input_word nonce) noexcept
+      : m_round_keys{internal::aes_expand_key(key)}, m_counter{counter}, m_nonce{nonce} {}
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE constexpr result_type operator()() noexcept {
+    if (m_index == m_block.size()) [[unlikely]] {
+      m_block = next_block();
+      m_index = 0;
+    }
+    return m_block[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr double uniform() noexcept {
+    return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * @brief Returns the counter of the block the next output comes from, or of the current block if it is not used up.
+   * @return The block counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr input_word getCounter() const noexcept {
+    return m_index < m_block.size() ? m_counter - 1 : m_counter;
+  }
+
+  /**
+   * @brief Sets the block counter. The next output is the first word of block `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_counter(const input_word counter) noexcept {
+    m_counter = counter;
+    m_index = static_cast<std::uint8_t>(m_block.size());
+  }
+
+  /**
+   * @brief Returns the nonce.
+   * @return The nonce.
+   */
+  PRNG_ALWAYS_INLINE constexpr input_word getNonce() const noexcept { return m_nonce; }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(const input_word n) noexcept {
+    const auto word = (m_index < m_block.size() ? m_index : 0) + n % 2;
+    set_counter(getCounter() + n / 2 + word / 2);
+    if (word % 2 != 0) {
+      operator()();
+    }
+  }
+
+private:
+  internal::aes_round_keys m_round_keys;
+  input_word m_counter;
+  input_word m_nonce;
+  block_type m_block{};
+  std::uint8_t m_index = 2;
+
+  PRNG_ALWAYS_INLINE constexpr block_type next_block() noexcept {
+    const auto cipher = internal::aes_encrypt<R>(internal::aes_counter_block(m_counter++, m_nonce), m_round_keys);
+    block_type block{};
+    for (auto i = std::size_t{0}; i < 8; ++i) {
+      block[0] |= static_cast<result_type>(cipher[i]) << (8 * i);
+      block[1] |= static_cast<result_type>(cipher[8 + i]) << (8 * i);
+    }
+    return block;
+  }
+};
+
+// AESCTR10 is AES-128 in counter mode; AESCTR5 keeps the round count of Random123's ARS-5.
+using AESCTR5 = AESCTR<5>;
+using AESCTR10 = AESCTR<10>;
+
+}
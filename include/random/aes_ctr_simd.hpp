@@ -0,0 +1,533 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <type_traits>
+#include <variant>
+#include <xsimd/xsimd.hpp>
+
+#include "random/aes_ctr.hpp"
+#include "random/cache_fill.hpp"
+#include "random/chacha_simd.hpp"
+#include "random/macros.hpp"
+#include "random/simd_uniform.hpp"
+
+#if defined(__AES__) || defined(__VAES__)
+#include <immintrin.h>
+#endif
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Returns whether the CPU executes the AES-NI instructions.
+ */
+bool cpu_has_aes() noexcept;
+
+/**
+ * Returns whether the CPU executes the VAES instructions, i.e. AES rounds on 256- and 512-bit registers.
+ */
+bool cpu_has_vaes() noexcept;
+
+/**
+ * Architecture tag of the AES-CTR kernels used on CPUs without AES-NI: the AES rounds are computed in software.
+ */
+struct aes_software {};
+
+/**
+ * The state the AES-CTR kernels work on: the round keys, the counter of the next block and the nonce.
+ */
+struct AESCTRState {
+  aes_round_keys round_keys;
+  std::uint64_t counter;
+  std::uint64_t nonce;
+};
+
+/**
+ * Entry points of one AESCTRDispatch target. They generate `n` blocks from the state, two 64-bit outputs each, and
+ * advance its counter past them.
+ */
+struct AESCTRTable {
+  using result_type = std::uint64_t;
+  void (*blocks)(AESCTRState *state, result_type *out, std::size_t n) noexcept;
+  void (*uniform_blocks)(AESCTRState *state, double *out, std::size_t n) noexcept;
+};
+
+/**
+ * Number of AES blocks one register holds for `Arch` with the instructions enabled at compile time: 4 with VAES on
+ * AVX-512, 2 with VAES on AVX2, 1 with AES-NI and 0 when the rounds are computed in software.
+ */
+template <class Arch> constexpr std::size_t aes_lane_blocks() noexcept {
+  if constexpr (std::is_same_v<Arch, aes_software>) {
+    return 0;
+  } else {
+#if defined(__VAES__) && defined(__AVX512F__)
+    if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+      return 4;
+    }
+#endif
+#if defined(__VAES__) && defined(__AVX2__)
+    if constexpr (std::is_base_of_v<xsimd::avx2, Arch>) {
+      return 2;
+    }
+#endif
+#if defined(__AES__)
+    return 1;
+#else
+    return 0;
+#endif
+  }
+}
+
+/**
+ * Implementations of the AESCTRTable entry points. The counter blocks of a group are encrypted together, with enough
+ * independent registers in flight to hide the latency of the AES round instructions.
+ *
+ * @tparam R The number of AES rounds.
+ * @tparam Arch The architecture type for SIMD operations, or aes_software.
+ */
+template <std::uint8_t R, class Arch> struct AESCTRKernels {
+  using result_type = AESCTRTable::result_type;
+  static constexpr auto LANE_BLOCKS = aes_lane_blocks<Arch>();
+  // aesenc has a latency of 3 to 4 cycles at a throughput of 1 to 2 per cycle
+  static constexpr auto REGISTERS = std::size_t{LANE_BLOCKS > 1 ? 4 : 8};
+  static constexpr auto GROUP_BLOCKS = (LANE_BLOCKS > 1 ? LANE_BLOCKS : 1) * REGISTERS;
+  static constexpr auto BLOCK_RESULTS = std::size_t{2};
+  static constexpr auto GROUP_RESULTS = GROUP_BLOCKS * BLOCK_RESULTS;
+
+  /**
+   * Generates `n` blocks as 64-bit outputs in operator() order.
+   */
+  static void blocks(AESCTRState *state, result_type *out, std::size_t n) noexcept {
+    for (; n >= GROUP_BLOCKS; n -= GROUP_BLOCKS, out += GROUP_RESULTS) {
+      encrypt_group(*state, out);
+      state->counter += GROUP_BLOCKS;
+    }
+    if (n != 0) {
+      // the last group is encrypted whole, but the counter only moves past the blocks that are used
+      alignas(64) std::array<result_type, GROUP_RESULTS> results;
+      encrypt_group(*state, results.data());
+      std::memcpy(out, results.data(), n * BLOCK_RESULTS * sizeof(result_type));
+      state->counter += n;
+    }
+  }
+
+  /**
+   * Generates `n` blocks as uniform doubles in [0, 1).
+   */
+  static void uniform_blocks(AESCTRState *state, double *out, std::size_t n) noexcept {
+    alignas(64) std::array<result_type, GROUP_RESULTS> results;
+    while (n != 0) {
+      const auto count = n < GROUP_BLOCKS ? n : GROUP_BLOCKS;
+      encrypt_group(*state, results.data());
+      if constexpr (LANE_BLOCKS == 0) {
+        for (auto i = std::size_t{0}; i < count * BLOCK_RESULTS; ++i) {
+          out[i] = to_uniform(results[i]);
+        }
+      } else {
+        using word_batch = xsimd::batch<result_type, Arch>;
+        alignas(64) std::array<double, GROUP_RESULTS> uniforms;
+        for (auto i = std::size_t{0}; i < GROUP_RESULTS; i += word_batch::size) {
+          to_uniform(word_batch::load_aligned(results.data() + i)).store_aligned(uniforms.data() + i);
+        }
+        std::memcpy(out, uniforms.data(), count * BLOCK_RESULTS * sizeof(double));
+      }
+      state->counter += count;
+      out += count * BLOCK_RESULTS;
+      n -= count;
+    }
+  }
+
+  static constexpr AESCTRTable table{&blocks, &uniform_blocks};
+
+private:
+  /**
+   * Encrypts the GROUP_BLOCKS counter blocks starting at the state's counter and stores them one after the other.
+   */
+  static PRNG_ALWAYS_INLINE void encrypt_group(const AESCTRState &state, result_type *out) noexcept {
+    const auto &keys = state.round_keys;
+    if constexpr (LANE_BLOCKS == 4) {
+#if defined(__VAES__) && defined(__AVX512F__)
+      std::array<__m512i, R + 1> round_keys;
+      for (auto round = std::size_t{0}; round <= R; ++round) {
+        round_keys[round] =
+          _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys[round].data())));
+      }
+      const auto first = _mm512_set_epi64(
+        static_cast<long long>(state.nonce), static_cast<long long>(state.counter + 3),
+        static_cast<long long>(state.nonce), static_cast<long long>(state.counter + 2),
+        static_cast<long long>(state.nonce), static_cast<long long>(state.counter + 1),
+        static_cast<long long>(state.nonce), static_cast<long long>(state.counter));
+      std::array<__m512i, REGISTERS> x;
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        // only the counter lanes are offset, and they wrap modulo 2^64 like the scalar counter
+        const auto offset = _mm512_set_epi64(0, static_cast<long long>(4 * i), 0, static_cast<long long>(4 * i), 0,
+                                             static_cast<long long>(4 * i), 0, static_cast<long long>(4 * i));
+        x[i] = _mm512_xor_si512(_mm512_add_epi64(first, offset), round_keys[0]);
+      }
+      for (auto round = std::size_t{1}; round < R; ++round) {
+        for (auto &block : x) {
+          block = _mm512_aesenc_epi128(block, round_keys[round]);
+        }
+      }
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        _mm512_storeu_si512(out + i * 4 * BLOCK_RESULTS, _mm512_aesenclast_epi128(x[i], round_keys[R]));
+      }
+#endif
+    } else if constexpr (LANE_BLOCKS == 2) {
+#if defined(__VAES__) && defined(__AVX2__)
+      std::array<__m256i, R + 1> round_keys;
+      for (auto round = std::size_t{0}; round <= R; ++round) {
+        round_keys[round] =
+          _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys[round].data())));
+      }
+      const auto first =
+        _mm256_set_epi64x(static_cast<long long>(state.nonce), static_cast<long long>(state.counter + 1),
+                          static_cast<long long>(state.nonce), static_cast<long long>(state.counter));
+      std::array<__m256i, REGISTERS> x;
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        const auto offset = _mm256_set_epi64x(0, static_cast<long long>(2 * i), 0, static_cast<long long>(2 * i));
+        x[i] = _mm256_xor_si256(_mm256_add_epi64(first, offset), round_keys[0]);
+      }
+      for (auto round = std::size_t{1}; round < R; ++round) {
+        for (auto &block : x) {
+          block = _mm256_aesenc_epi128(block, round_keys[round]);
+        }
+      }
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i * 2 * BLOCK_RESULTS),
+                            _mm256_aesenclast_epi128(x[i], round_keys[R]));
+      }
+#endif
+    } else if constexpr (LANE_BLOCKS == 1) {
+#if defined(__AES__)
+      std::array<__m128i, R + 1> round_keys;
+      for (auto round = std::size_t{0}; round <= R; ++round) {
+        round_keys[round] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys[round].data()));
+      }
+      std::array<__m128i, REGISTERS> x;
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        x[i] = _mm_xor_si128(
+          _mm_set_epi64x(static_cast<long long>(state.nonce), static_cast<long long>(state.counter + i)),
+          round_keys[0]);
+      }
+      for (auto round = std::size_t{1}; round < R; ++round) {
+        for (auto &block : x) {
+          block = _mm_aesenc_si128(block, round_keys[round]);
+        }
+      }
+      for (auto i = std::size_t{0}; i < REGISTERS; ++i) {
+        const auto block = _mm_aesenclast_si128(x[i], round_keys[R]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * BLOCK_RESULTS), block);
+      }
+#endif
+    } else {
+      for (auto i = std::size_t{0}; i < GROUP_BLOCKS; ++i) {
+        const auto cipher = aes_encrypt<R>(aes_counter_block(state.counter + i, state.nonce), keys);
+        std::memcpy(out + i * BLOCK_RESULTS, cipher.data(), cipher.size());
+      }
+    }
+  }
+};
+
+}
+
+/**
+ * Returns the AESCTRDispatch entry points for the CPU, selected on the first call only: VAES on AVX-512 or AVX2 when
+ * available, AES-NI otherwise, and software AES rounds on CPUs without AES-NI.
+ *
+ * @tparam R The number of AES rounds. 5 and 10 are instantiated.
+ * @return The dispatch table.
+ */
+template <std::uint8_t R> const internal::AESCTRTable &aes_ctr_table() noexcept;
+
+/**
+ * @class AESCTRDispatch
+ * @brief AES-128 generator in counter mode running on AES-NI or VAES, selected at runtime like ChaChaDispatch. The
+ * output is identical to AESCTR<R>. Without AES-NI the same stream is computed in software, which is much slower; use
+ * CryptoDispatch to fall back to ChaCha20 instead.
+ *
+ * @tparam R The number of AES rounds, 5 or 10.
+ */
+template <std::uint8_t R = 10> class AESCTRDispatch {
+public:
+  using result_type = internal::AESCTRTable::result_type;
+  using input_word = std::uint64_t;
+  using key_type = internal::aes_key;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return (std::numeric_limits<result_type>::min)(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return (std::numeric_limits<result_type>::max)(); }
+
+  /**
+   * @brief Construct a runtime-dispatched AES-CTR generator with given key, counter and nonce.
+   * @param key The 128-bit AES key.
+   * @param counter Initial value of the counter.
+   * @param nonce The nonce.
+   */
+  explicit AESCTRDispatch(const key_type &key, const input_word counter, const input_word nonce) noexcept
+      : m_state{internal::aes_expand_key(key), counter, nonce}, m_table{&aes_ctr_table<R>()} {}
+
+  /**
+   * @brief Returns whether the AES rounds run on AES-NI or VAES rather than in software.
+   * @return True when the CPU has AES-NI.
+   */
+  static PRNG_ALWAYS_INLINE bool accelerated() noexcept { return internal::cpu_has_aes(); }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * blocks are generated straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+      [this]() noexcept { populate_cache(); },
+      [this](result_type *dst, const std::size_t count) noexcept {
+        m_table->blocks(&m_state, dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+      [this]() noexcept { populate_cache(); },
+      [this](double *dst, const std::size_t count) noexcept {
+        m_table->uniform_blocks(&m_state, dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Returns the counter of the block the next output comes from, or of the current block if it is not used up.
+   * @return The block counter.
+   */
+  PRNG_ALWAYS_INLINE input_word getCounter() const noexcept {
+    // cached blocks that are not fully consumed yet
+    const auto pending = (CACHE_SIZE - m_index + BLOCK_RESULTS - 1) / BLOCK_RESULTS;
+    return m_state.counter - pending;
+  }
+
+  /**
+   * @brief Sets the block counter and drops the cache. The next output is the first word of block `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE void set_counter(const input_word counter) noexcept {
+    m_state.counter = counter;
+    m_index = CACHE_SIZE;
+  }
+
+  /**
+   * @brief Returns the nonce.
+   * @return The nonce.
+   */
+  PRNG_ALWAYS_INLINE input_word getNonce() const noexcept { return m_state.nonce; }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE void discard(const input_word n) noexcept {
+    const auto word = m_index % BLOCK_RESULTS + n % BLOCK_RESULTS;
+    set_counter(getCounter() + n / BLOCK_RESULTS + word / BLOCK_RESULTS);
+    if (word % BLOCK_RESULTS != 0) {
+      operator()();
+    }
+  }
+
+protected:
+  static constexpr auto BLOCK_RESULTS = std::size_t{2};
+  // the same 1 KiB cache as ChaChaDispatch
+  static constexpr auto CACHE_BLOCKCOUNT = std::size_t{64};
+  static constexpr auto CACHE_SIZE = CACHE_BLOCKCOUNT * BLOCK_RESULTS;
+
+  /**
+   * Refills the whole cache with one call into the dispatched implementation.
+   */
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept { m_table->blocks(&m_state, m_cache.data(), CACHE_BLOCKCOUNT); }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  internal::AESCTRState m_state;
+  const internal::AESCTRTable *m_table;
+  std::uint32_t m_index{CACHE_SIZE};
+};
+
+using AESCTR5Dispatch = AESCTRDispatch<5>;
+using AESCTR10Dispatch = AESCTRDispatch<10>;
+
+static_assert(std::is_trivially_copyable_v<AESCTR10Dispatch>);
+
+/**
+ * The cipher a CryptoDispatch generator runs on.
+ */
+enum class CryptoCipher { aes128, chacha20 };
+
+/**
+ * @class CryptoDispatch
+ * @brief Crypto-strength generator on the fastest cipher the CPU accelerates: AES-128 in counter mode when it has
+ * AES-NI, ChaCha20 otherwise.
+ *
+ * The key has the ChaCha layout. With AES-NI the generator is `AESCTR<10>` keyed with the first four key words as
+ * little-endian bytes, otherwise it is `ChaCha<20>(key, counter, nonce)`, so the stream depends on the CPU; cipher()
+ * tells which one is in use. Pick one of the two engines directly when the output must be reproducible everywhere.
+ */
+class CryptoDispatch {
+public:
+  using result_type = std::uint64_t;
+  using input_word = std::uint64_t;
+  using key_type = std::array<std::uint32_t, 8>;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return (std::numeric_limits<result_type>::min)(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return (std::numeric_limits<result_type>::max)(); }
+
+  /**
+   * @brief Construct the generator on the cipher selected for this CPU.
+   * @param key A 256-bit key, divided up into eight 32-bit words. AES-128 uses the first four words.
+   * @param counter Initial value of the counter.
+   * @param nonce The nonce.
+   */
+  explicit CryptoDispatch(const key_type &key, const input_word counter, const input_word nonce) noexcept
+      : m_engine{make_engine(key, counter, nonce)} {}
+
+  /**
+   * @brief Returns the cipher the generator runs on.
+   * @return The cipher.
+   */
+  PRNG_ALWAYS_INLINE CryptoCipher cipher() const noexcept {
+    return m_engine.index() == 0 ? CryptoCipher::aes128 : CryptoCipher::chacha20;
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (auto *const aes = std::get_if<0>(&m_engine)) [[likely]] {
+      return (*aes)();
+    }
+    return (*std::get_if<1>(&m_engine))();
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs, identical to calling operator() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, const std::size_t n) noexcept {
+    std::visit([out, n](auto &engine) noexcept { engine.fill(out, n); }, m_engine);
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1), identical to calling uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, const std::size_t n) noexcept {
+    std::visit([out, n](auto &engine) noexcept { engine.fill_uniform(out, n); }, m_engine);
+  }
+
+private:
+  using engine_type = std::variant<AESCTRDispatch<10>, ChaChaDispatch<20>>;
+
+  engine_type m_engine;
+
+  static engine_type make_engine(const key_type &key, const input_word counter, const input_word nonce) noexcept {
+    if (internal::cpu_has_aes()) {
+      internal::aes_key aes_key{};
+      for (auto i = std::size_t{0}; i < aes_key.size(); ++i) {
+        aes_key[i] = static_cast<std::uint8_t>(key[i / 4] >> (8 * (i % 4)));
+      }
+      return engine_type{std::in_place_index<0>, aes_key, counter, nonce};
+    }
+    return engine_type{std::in_place_index<1>, key, counter, nonce};
+  }
+};
+
+namespace internal {
+
+/**
+ * Functor returning the AESCTRDispatch entry points compiled for one architecture.
+ *
+ * @tparam R The number of AES rounds.
+ */
+template <std::uint8_t R> struct AESCTRTableCreator {
+  /**
+   * Operator that returns the AESCTRDispatch entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @return The dispatch table.
+   */
+  template <class Arch> const AESCTRTable *operator()(Arch) const noexcept;
+};
+
+template <std::uint8_t R>
+template <class Arch>
+const AESCTRTable *AESCTRTableCreator<R>::operator()(Arch) const noexcept {
+  return &AESCTRKernels<R, Arch>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points of every round count for one architecture.
+#define PRNG_AES_CTR_TABLES(PREFIX, ARCH)                                                                             \
+  PREFIX template const AESCTRTable *AESCTRTableCreator<5>::operator()<ARCH>(ARCH) const noexcept;                    \
+  PREFIX template const AESCTRTable *AESCTRTableCreator<10>::operator()<ARCH>(ARCH) const noexcept;
+
+PRNG_AES_CTR_TABLES(extern, xsimd::sse2)
+PRNG_AES_CTR_TABLES(extern, xsimd::sse4_2)
+PRNG_AES_CTR_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_AES_CTR_TABLES(extern, xsimd::avx512f)
+
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Bulk-fill driver shared by the cached generators. It drains what is left in the cache, lets `fill_batches` write
+ * whole SIMD batches straight into the destination and serves the remainder from a freshly populated cache, so the
+ * output is identical to calling operator() `n` times.
+ *
+ * @param cache The generator cache.
+ * @param index The generator cache index; `cache.size()` means the cache is exhausted.
+ * @param out Pointer to the destination buffer.
+ * @param n The number of values to generate.
+ * @param convert Callable mapping a cached value to the output type.
+ * @param populate_cache Callable refilling the cache.
+ * @param fill_batches Callable writing whole batches into a buffer and returning how many values it wrote.
+ */
+template <class Cache, class Index, class Out, class Convert, class Populate, class FillBatches>
+PRNG_ALWAYS_INLINE void fill_through_cache(Cache &cache, Index &index, Out *out, std::size_t n, Convert &&convert,
+                                           Populate &&populate_cache, FillBatches &&fill_batches) noexcept {
+  const auto available = cache.size() - index;
+  const auto count = n < available ? n : available;
+  std::transform(cache.data() + index, cache.data() + index + count, out, convert);
+  index = static_cast<Index>(index + count);
+  out += count;
+  n -= count;
+  if (n == 0) {
+    return;
+  }
+  const auto written = fill_batches(out, n);
+  out += written;
+  n -= written;
+  if (n != 0) {
+    populate_cache();
+    std::transform(cache.data(), cache.data() + n, out, convert);
+    index = static_cast<Index>(n);
+  }
+}
+
+} // namespace internal
+
+} // namespace prng
@@ -105,6 +105,52 @@ public:
     return state;
   }
 
+  /**
+   * @brief Sets the block counter. The next output is the first word of block `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_counter(const input_word counter) noexcept {
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
+  }
+
+  /**
+   * @brief Sets the nonce and restarts at the current block, like set_counter(getState() counter).
+   * @param nonce The new nonce.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_nonce(const input_word nonce) noexcept {
+    const auto state = getState();
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+    set_counter((static_cast<input_word>(state[13]) << 32) | state[12]);
+  }
+
+  /**
+   * @brief Positions the generator so that the next output is 64-bit word `word` of block `block`, in constant time.
+   * @param block The block counter.
+   * @param word The 64-bit word within the block. Words past the end of the block carry into the following blocks.
+   */
+  PRNG_ALWAYS_INLINE constexpr void seek(const input_word block, const std::uint8_t word) noexcept {
+    set_counter(block + word / m_result_cache.size());
+    if (word % m_result_cache.size() != 0) {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = static_cast<std::uint8_t>(word % m_result_cache.size());
+    }
+  }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(const input_word n) noexcept {
+    const auto state = getState();
+    const auto block = (static_cast<input_word>(state[13]) << 32) | state[12];
+    const auto word = (m_result_index < m_result_cache.size() ? m_result_index : 0) + n % m_result_cache.size();
+    seek(block + n / m_result_cache.size() + word / m_result_cache.size(),
+         static_cast<std::uint8_t>(word % m_result_cache.size()));
+  }
+
 private:
   matrix_type m_state;
   result_cache_type m_result_cache{};
@@ -224,4 +270,8 @@ private:
   }
 };
 
+using ChaCha8 = ChaCha<8>;
+using ChaCha12 = ChaCha<12>;
+using ChaCha20 = ChaCha<20>;
+
 }
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <vector>
+#include <xsimd/xsimd.hpp>
+
+#include "random/chacha.hpp"
+#include "random/chacha_simd.hpp"
+#include "random/macros.hpp"
+
+namespace prng {
+
+/**
+ * @class ChaChaBank
+ * @brief A bank of independent ChaCha streams sharing one key, one stream per SIMD lane.
+ *
+ * ChaChaSIMD spreads consecutive counters of a single stream across the lanes. The bank instead loads a different
+ * counter and nonce into each lane of the state rows 12 to 15, so one SIMD batch advances `simd_type::size` streams
+ * by one block at once. Stream `i` produces exactly the keystream of `ChaCha<R>(key, counter(i), nonce(i))`.
+ *
+ * A stream costs 16 bytes (its 64-bit counter and nonce) and there is no block cache: each call to next_blocks()
+ * hands out one whole block per stream, so thousands of per-entity streams fit in a few pages.
+ *
+ * @tparam R The number of rounds.
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <std::uint8_t R = 20, class Arch = xsimd::best_arch>
+class ChaChaBank {
+protected:
+  static constexpr auto MATRIX_WORDCOUNT = std::uint8_t{16};
+  static constexpr auto KEY_WORDCOUNT = std::uint8_t{8};
+
+public:
+  using result_type = std::uint64_t;
+  using input_word = std::uint64_t;
+  using matrix_word = std::uint32_t;
+  using matrix_type = std::array<matrix_word, MATRIX_WORDCOUNT>;
+  using simd_type = xsimd::batch<matrix_word, Arch>;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept {
+    return (std::numeric_limits<result_type>::min)();
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept {
+    return (std::numeric_limits<result_type>::max)();
+  }
+
+  /**
+   * @brief Construct a bank of streams with one nonce each, all starting at the same counter.
+   * @param key A 256-bit key shared by every stream, divided up into eight 32-bit words.
+   * @param nonces The nonce of each stream; the bank holds `nonces.size()` streams.
+   * @param counter Initial value of every counter.
+   */
+  explicit ChaChaBank(
+    const std::array<matrix_word, KEY_WORDCOUNT> key,
+    const std::vector<input_word>& nonces,
+    const input_word counter = 0
+  ) : m_key{key}, m_size{nonces.size()}, m_lanes(groups() * LANE_ROWS * SIMD_WIDTH) {
+    for (auto stream = std::size_t{0}; stream < m_size; ++stream) {
+      set_nonce(stream, nonces[stream]);
+      set_counter(stream, counter);
+    }
+  }
+
+  /**
+   * @brief Construct a bank of `streams` streams where stream `i` uses nonce `i`.
+   * @param key A 256-bit key shared by every stream, divided up into eight 32-bit words.
+   * @param streams The number of streams.
+   * @param counter Initial value of every counter.
+   */
+  explicit ChaChaBank(
+    const std::array<matrix_word, KEY_WORDCOUNT> key,
+    const std::size_t streams,
+    const input_word counter = 0
+  ) : m_key{key}, m_size{streams}, m_lanes(groups() * LANE_ROWS * SIMD_WIDTH) {
+    for (auto stream = std::size_t{0}; stream < m_size; ++stream) {
+      set_nonce(stream, stream);
+      set_counter(stream, counter);
+    }
+  }
+
+  /**
+   * @brief Returns the number of streams in the bank.
+   * @return The number of streams.
+   */
+  PRNG_ALWAYS_INLINE std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @brief Returns the bytes of state kept per stream, not counting the padding of the last SIMD group.
+   * @return The per-stream footprint in bytes.
+   */
+  static constexpr PRNG_ALWAYS_INLINE std::size_t stream_bytes() noexcept { return LANE_ROWS * sizeof(matrix_word); }
+
+  /**
+   * @brief Returns the block counter of a stream: the block its next output comes from.
+   * @param stream The stream index.
+   * @return The block counter.
+   */
+  PRNG_ALWAYS_INLINE input_word counter(const std::size_t stream) const noexcept {
+    return combine(lane(stream, COUNTER_HIGH), lane(stream, COUNTER_LOW));
+  }
+
+  /**
+   * @brief Returns the nonce of a stream.
+   * @param stream The stream index.
+   * @return The nonce.
+   */
+  PRNG_ALWAYS_INLINE input_word nonce(const std::size_t stream) const noexcept {
+    return combine(lane(stream, NONCE_HIGH), lane(stream, NONCE_LOW));
+  }
+
+  /**
+   * @brief Sets the block counter of a stream, e.g. to seek it in constant time.
+   * @param stream The stream index.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE void set_counter(const std::size_t stream, const input_word counter) noexcept {
+    lane(stream, COUNTER_LOW) = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    lane(stream, COUNTER_HIGH) = static_cast<matrix_word>(counter >> 32);
+  }
+
+  /**
+   * @brief Sets the nonce of a stream. Its counter is kept.
+   * @param stream The stream index.
+   * @param nonce The new nonce.
+   */
+  PRNG_ALWAYS_INLINE void set_nonce(const std::size_t stream, const input_word nonce) noexcept {
+    lane(stream, NONCE_LOW) = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    lane(stream, NONCE_HIGH) = static_cast<matrix_word>(nonce >> 32);
+  }
+
+  /**
+   * @brief Returns a scalar generator positioned at the current block of one stream, for sequential draws from a
+   * single entity. The bank itself is not advanced.
+   * @param stream The stream index.
+   * @return The scalar generator.
+   */
+  PRNG_ALWAYS_INLINE ChaCha<R> stream(const std::size_t stream) const noexcept {
+    return ChaCha<R>(m_key, counter(stream), nonce(stream));
+  }
+
+  /**
+   * @brief Generates the next block of every stream and advances every counter by one.
+   * @param out Destination of size() blocks; `out[i]` receives the block of stream `i`.
+   */
+  void next_blocks(matrix_type* out) noexcept {
+    const auto full_groups = m_size / SIMD_WIDTH;
+    for (auto group = std::size_t{0}; group < full_groups; ++group) {
+      typename engine_type::working_state_type x;
+      gen_group(x, group);
+      engine_type::template store_block_batch<false>(x, reinterpret_cast<std::byte*>(out + group * SIMD_WIDTH));
+    }
+    if (const auto rest = m_size % SIMD_WIDTH; rest != 0) {
+      // the padding lanes of the last group are computed too, but only the real streams are copied out
+      typename engine_type::working_state_type x;
+      std::array<matrix_type, SIMD_WIDTH> blocks;
+      gen_group(x, full_groups);
+      engine_type::template store_block_batch<false>(x, reinterpret_cast<std::byte*>(blocks.data()));
+      std::memcpy(out + full_groups * SIMD_WIDTH, blocks.data(), rest * sizeof(matrix_type));
+    }
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Generates the next block of every stream into a span of at least size() blocks.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void next_blocks(const std::span<matrix_type> out) noexcept { next_blocks(out.data()); }
+#endif
+
+private:
+  using engine_type = ChaChaSIMD<R, Arch>;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+  // per-stream words, stored row by row for each group of SIMD_WIDTH streams
+  static constexpr auto COUNTER_LOW = std::size_t{0};
+  static constexpr auto COUNTER_HIGH = std::size_t{1};
+  static constexpr auto NONCE_LOW = std::size_t{2};
+  static constexpr auto NONCE_HIGH = std::size_t{3};
+  static constexpr auto LANE_ROWS = std::size_t{4};
+
+  std::array<matrix_word, KEY_WORDCOUNT> m_key;
+  std::size_t m_size;
+  std::vector<matrix_word> m_lanes;
+
+  PRNG_ALWAYS_INLINE std::size_t groups() const noexcept { return (m_size + SIMD_WIDTH - 1) / SIMD_WIDTH; }
+
+  PRNG_ALWAYS_INLINE matrix_word& lane(const std::size_t stream, const std::size_t row) noexcept {
+    return m_lanes[(stream / SIMD_WIDTH * LANE_ROWS + row) * SIMD_WIDTH + stream % SIMD_WIDTH];
+  }
+
+  PRNG_ALWAYS_INLINE matrix_word lane(const std::size_t stream, const std::size_t row) const noexcept {
+    return m_lanes[(stream / SIMD_WIDTH * LANE_ROWS + row) * SIMD_WIDTH + stream % SIMD_WIDTH];
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE input_word combine(const matrix_word high, const matrix_word low) noexcept {
+    return (static_cast<input_word>(high) << 32) | low;
+  }
+
+  /**
+   * Runs the rounds on the current block of the streams of one group, one stream per lane, and advances their
+   * counters.
+   */
+  PRNG_ALWAYS_INLINE void gen_group(typename engine_type::working_state_type& x, const std::size_t group) noexcept {
+    auto* const rows = m_lanes.data() + group * LANE_ROWS * SIMD_WIDTH;
+    typename engine_type::working_state_type input;
+    input[0] = simd_type::broadcast(0x61707865);
+    input[1] = simd_type::broadcast(0x3320646e);
+    input[2] = simd_type::broadcast(0x79622d32);
+    input[3] = simd_type::broadcast(0x6b206574);
+    for (auto i = std::size_t{0}; i < KEY_WORDCOUNT; ++i) {
+      input[4 + i] = simd_type::broadcast(m_key[i]);
+    }
+    for (auto row = std::size_t{0}; row < LANE_ROWS; ++row) {
+      input[12 + row] = simd_type::load_unaligned(rows + row * SIMD_WIDTH);
+    }
+
+    x = input;
+    for (auto i = 0; i < R; i += 2) {
+      engine_type::column_round(x);
+      engine_type::diagonal_round(x);
+    }
+    for (auto i = std::size_t{0}; i < MATRIX_WORDCOUNT; ++i) {
+      x[i] += input[i];
+    }
+
+    const auto low = input[12] + simd_type::broadcast(1);
+    const auto high =
+      input[13] + xsimd::select(low == simd_type::broadcast(0), simd_type::broadcast(1), simd_type::broadcast(0));
+    low.store_unaligned(rows + COUNTER_LOW * SIMD_WIDTH);
+    high.store_unaligned(rows + COUNTER_HIGH * SIMD_WIDTH);
+  }
+};
+
+}
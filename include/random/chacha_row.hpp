@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <xsimd/xsimd.hpp>
+
+#include "random/macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * The 128-bit instruction set a single ChaCha row is held in: the richest one enabled at compile time.
+ */
+#if XSIMD_WITH_SSE4_2
+using chacha_row_arch = xsimd::sse4_2;
+#elif XSIMD_WITH_SSSE3
+using chacha_row_arch = xsimd::ssse3;
+#elif XSIMD_WITH_NEON64
+using chacha_row_arch = xsimd::neon64;
+#else
+using chacha_row_arch = xsimd::sse2;
+#endif
+
+}
+
+/**
+ * @class ChaChaRow
+ * @brief ChaCha generator computing one block at a time with the 4x4 state held in four 128-bit rows.
+ *
+ * A column round works on the four rows directly. For the diagonal round rows 1, 2 and 3 are rotated by 1, 2 and 3
+ * lanes so that the diagonals line up as columns, and rotated back afterwards. The output is bit-identical to
+ * `ChaCha<R>`; unlike ChaChaSIMD, which needs a whole batch of blocks before the first output, the first word is
+ * ready after a single block, which suits short-lived generators and small draws.
+ *
+ * @tparam R The number of rounds.
+ * @tparam Arch A 128-bit architecture holding four 32-bit words per batch.
+ */
+template <std::uint8_t R = 20, class Arch = internal::chacha_row_arch>
+class ChaChaRow {
+protected:
+  static constexpr auto MATRIX_WORDCOUNT = std::uint8_t{16};
+  static constexpr auto KEY_WORDCOUNT = std::uint8_t{8};
+
+public:
+  using result_type = std::uint64_t;
+  using input_word = std::uint64_t;
+  using matrix_word = std::uint32_t;
+  using matrix_type = std::array<matrix_word, MATRIX_WORDCOUNT>;
+  using row_type = xsimd::batch<matrix_word, Arch>;
+  using result_cache_type = std::array<result_type, MATRIX_WORDCOUNT / 2>;
+
+  static_assert(row_type::size == 4, "ChaChaRow needs a 128-bit architecture");
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept {
+    return (std::numeric_limits<result_type>::min)();
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept {
+    return (std::numeric_limits<result_type>::max)();
+  }
+
+  /**
+   * @brief Construct a row-vectorized ChaCha generator with given key, counter and nonce
+   * @param key A 256-bit key, divided up into eight 32-bit words.
+   * @param counter Initial value of the counter.
+   * @param nonce Initial value of the nonce.
+   */
+  PRNG_ALWAYS_INLINE explicit ChaChaRow(
+    const std::array<matrix_word, KEY_WORDCOUNT> key,
+    const input_word counter,
+    const input_word nonce
+  ) noexcept {
+    // "expand 32-byte k" in ASCII (little-endian)
+    m_state[0] = 0x61707865;
+    m_state[1] = 0x3320646e;
+    m_state[2] = 0x79622d32;
+    m_state[3] = 0x6b206574;
+
+    for (auto i = 0; i < 8; ++i) {
+      m_state[4 + i] = key[i];
+    }
+
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type(operator())() noexcept { return next_result(); }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept {
+    return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * @brief Generates the next 64-byte ChaCha block.
+   * @return The next 64-byte ChaCha block.
+   */
+  PRNG_ALWAYS_INLINE matrix_type block() noexcept {
+    if (m_result_index < m_result_cache.size()) {
+      auto cached_block = results_to_block(m_result_cache);
+      m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
+      return cached_block;
+    }
+    return next_block();
+  }
+
+  /**
+   * @brief Returns the state of the generator; a 4x4 matrix.
+   * @return State of the generator.
+   */
+  PRNG_ALWAYS_INLINE constexpr matrix_type getState() const noexcept {
+    matrix_type state = m_state;
+    if (m_result_index < m_result_cache.size()) {
+      const input_word current_counter = counter() - 1;
+      state[12] = static_cast<matrix_word>(current_counter & 0xFFFFFFFF);
+      state[13] = static_cast<matrix_word>(current_counter >> 32);
+    }
+    return state;
+  }
+
+  /**
+   * @brief Sets the block counter. The next output is the first word of block `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_counter(const input_word counter) noexcept {
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
+  }
+
+  /**
+   * @brief Sets the nonce and restarts at the current block, like set_counter(getState() counter).
+   * @param nonce The new nonce.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_nonce(const input_word nonce) noexcept {
+    const auto state = getState();
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+    set_counter((static_cast<input_word>(state[13]) << 32) | state[12]);
+  }
+
+  /**
+   * @brief Positions the generator so that the next output is 64-bit word `word` of block `block`, in constant time.
+   * @param block The block counter.
+   * @param word The 64-bit word within the block. Words past the end of the block carry into the following blocks.
+   */
+  PRNG_ALWAYS_INLINE void seek(const input_word block, const std::uint8_t word) noexcept {
+    set_counter(block + word / m_result_cache.size());
+    if (word % m_result_cache.size() != 0) {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = static_cast<std::uint8_t>(word % m_result_cache.size());
+    }
+  }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE void discard(const input_word n) noexcept {
+    const auto state = getState();
+    const auto block = (static_cast<input_word>(state[13]) << 32) | state[12];
+    const auto word = (m_result_index < m_result_cache.size() ? m_result_index : 0) + n % m_result_cache.size();
+    seek(block + n / m_result_cache.size() + word / m_result_cache.size(),
+         static_cast<std::uint8_t>(word % m_result_cache.size()));
+  }
+
+private:
+  alignas(16) matrix_type m_state;
+  result_cache_type m_result_cache{};
+  std::uint8_t m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
+
+  constexpr PRNG_ALWAYS_INLINE input_word counter() const noexcept {
+    return (static_cast<input_word>(m_state[13]) << 32) | static_cast<input_word>(m_state[12]);
+  }
+
+  /**
+   * @brief Performs the four quarter rounds of a column (or, after diagonalize(), diagonal) round at once.
+   * @param a Row 0 of the working state.
+   * @param b Row 1 of the working state.
+   * @param c Row 2 of the working state.
+   * @param d Row 3 of the working state.
+   */
+  static PRNG_ALWAYS_INLINE void quarter_rounds(row_type &a, row_type &b, row_type &c, row_type &d) noexcept {
+    a += b; d ^= a; d = xsimd::rotl<16>(d);
+    c += d; b ^= c; b = xsimd::rotl<12>(b);
+    a += b; d ^= a; d = xsimd::rotl<8>(d);
+    c += d; b ^= c; b = xsimd::rotl<7>(b);
+  }
+
+  /**
+   * @brief Rotates rows 1, 2 and 3 left by 1, 2 and 3 lanes, so that the diagonals (0,5,10,15), (1,6,11,12),
+   * (2,7,8,13) and (3,4,9,14) become the columns.
+   */
+  static PRNG_ALWAYS_INLINE void diagonalize(row_type &b, row_type &c, row_type &d) noexcept {
+    b = xsimd::swizzle(b, xsimd::batch_constant<matrix_word, Arch, 1, 2, 3, 0>{});
+    c = xsimd::swizzle(c, xsimd::batch_constant<matrix_word, Arch, 2, 3, 0, 1>{});
+    d = xsimd::swizzle(d, xsimd::batch_constant<matrix_word, Arch, 3, 0, 1, 2>{});
+  }
+
+  /**
+   * @brief Undoes diagonalize().
+   */
+  static PRNG_ALWAYS_INLINE void undiagonalize(row_type &b, row_type &c, row_type &d) noexcept {
+    b = xsimd::swizzle(b, xsimd::batch_constant<matrix_word, Arch, 3, 0, 1, 2>{});
+    c = xsimd::swizzle(c, xsimd::batch_constant<matrix_word, Arch, 2, 3, 0, 1>{});
+    d = xsimd::swizzle(d, xsimd::batch_constant<matrix_word, Arch, 1, 2, 3, 0>{});
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE result_cache_type block_to_results(const matrix_type& block) noexcept {
+#if __cplusplus >= 202002L
+    return std::bit_cast<result_cache_type>(block);
+#else
+    result_cache_type results{};
+    for (auto i = std::size_t{0}; i < results.size(); ++i) {
+      results[i] =
+        static_cast<result_type>(block[2 * i]) |
+        (static_cast<result_type>(block[2 * i + 1]) << 32);
+    }
+    return results;
+#endif
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE matrix_type results_to_block(const result_cache_type& results) noexcept {
+#if __cplusplus >= 202002L
+    return std::bit_cast<matrix_type>(results);
+#else
+    matrix_type block{};
+    for (auto i = std::size_t{0}; i < results.size(); ++i) {
+      block[2 * i] = static_cast<matrix_word>(results[i] & 0xFFFFFFFF);
+      block[2 * i + 1] = static_cast<matrix_word>(results[i] >> 32);
+    }
+    return block;
+#endif
+  }
+
+  PRNG_ALWAYS_INLINE result_type next_result() noexcept {
+    if (m_result_index >= m_result_cache.size()) [[unlikely]] {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = 0;
+    }
+    return m_result_cache[m_result_index++];
+  }
+
+  /**
+   * @brief Returns the output for the current state, then increases the state's counter by 1.
+   * @return The output for the current internal state.
+   */
+  PRNG_FLATTEN PRNG_ALWAYS_INLINE matrix_type next_block() noexcept {
+    const auto a0 = row_type::load_aligned(m_state.data());
+    const auto b0 = row_type::load_aligned(m_state.data() + 4);
+    const auto c0 = row_type::load_aligned(m_state.data() + 8);
+    const auto d0 = row_type::load_aligned(m_state.data() + 12);
+    auto a = a0;
+    auto b = b0;
+    auto c = c0;
+    auto d = d0;
+
+    // As in ChaCha, an odd number of rounds is rounded up to the next double round.
+    for (auto i = 0; i < R; i += 2) {
+      quarter_rounds(a, b, c, d);
+      diagonalize(b, c, d);
+      quarter_rounds(a, b, c, d);
+      undiagonalize(b, c, d);
+    }
+
+    matrix_type x;
+    (a + a0).store_unaligned(x.data());
+    (b + b0).store_unaligned(x.data() + 4);
+    (c + c0).store_unaligned(x.data() + 8);
+    (d + d0).store_unaligned(x.data() + 12);
+
+    if (++m_state[12] == 0) {
+      ++m_state[13];
+    }
+
+    return x;
+  }
+};
+
+}
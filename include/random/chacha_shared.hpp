@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <xsimd/xsimd.hpp>
+
+#include "random/chacha_simd.hpp"
+#include "random/macros.hpp"
+#include "random/simd_uniform.hpp"
+
+namespace prng {
+
+/**
+ * @class SharedChaChaStream
+ * @brief One logical ChaCha keystream drawn from by many threads without locks.
+ *
+ * ChaCha is counter based, so threads do not need to share a generator: each thread takes a Cursor, which claims a
+ * chunk of consecutive blocks with an atomic `fetch_add` on the shared block counter and generates it locally with
+ * ChaChaSIMD. The blocks of the stream are handed out exactly once, so the union of everything the cursors return is
+ * a prefix of the keystream of `ChaCha<R>(key, counter, nonce)`, split into chunks in claim order. Each cursor records
+ * the ranges it consumed, which lets an audit replay which thread saw which part of the sequence.
+ *
+ * The stream must outlive its cursors.
+ *
+ * @tparam R The number of rounds.
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <std::uint8_t R = 20, class Arch = xsimd::best_arch>
+class SharedChaChaStream {
+protected:
+  static constexpr auto KEY_WORDCOUNT = std::uint8_t{8};
+
+public:
+  using engine_type = ChaChaSIMD<R, Arch>;
+  using result_type = typename engine_type::result_type;
+  using input_word = typename engine_type::input_word;
+  using matrix_word = typename engine_type::matrix_word;
+
+  /**
+   * A range of consecutive blocks of the stream.
+   */
+  struct Range {
+    input_word first; ///< Counter of the first block.
+    input_word count; ///< Number of blocks.
+  };
+
+  /**
+   * @brief Construct a shared stream.
+   * @param key A 256-bit key, divided up into eight 32-bit words.
+   * @param counter Counter of the first block of the stream.
+   * @param nonce The nonce.
+   * @param chunk_blocks Number of blocks a cursor claims at once. Larger chunks mean fewer atomic operations, smaller
+   * chunks waste less of the stream when cursors are dropped early.
+   */
+  explicit SharedChaChaStream(
+    const std::array<matrix_word, KEY_WORDCOUNT> key,
+    const input_word counter,
+    const input_word nonce,
+    const input_word chunk_blocks = 1024
+  ) noexcept : m_key{key}, m_nonce{nonce}, m_first{counter}, m_chunk_blocks{chunk_blocks ? chunk_blocks : 1},
+               m_next{counter} {}
+
+  SharedChaChaStream(const SharedChaChaStream &) = delete;
+  SharedChaChaStream &operator=(const SharedChaChaStream &) = delete;
+
+  /**
+   * @brief Atomically claims the next `blocks` blocks of the stream.
+   * @param blocks The number of blocks.
+   * @return The claimed range.
+   */
+  PRNG_ALWAYS_INLINE Range claim(const input_word blocks) noexcept {
+    return Range{m_next.fetch_add(blocks, std::memory_order_relaxed), blocks};
+  }
+
+  /**
+   * @brief Returns the blocks claimed so far by all cursors, always one contiguous range from the first block.
+   * @return The claimed range.
+   */
+  PRNG_ALWAYS_INLINE Range claimed() const noexcept {
+    return Range{m_first, m_next.load(std::memory_order_relaxed) - m_first};
+  }
+
+  /**
+   * @brief Returns the number of blocks a cursor claims at once.
+   * @return The chunk size in blocks.
+   */
+  PRNG_ALWAYS_INLINE input_word chunk_blocks() const noexcept { return m_chunk_blocks; }
+
+  /**
+   * @class Cursor
+   * @brief A thread-local view of the stream. It behaves like a ChaChaSIMD generator whose blocks jump to a freshly
+   * claimed chunk whenever the current one is used up. A cursor is not thread safe; use one per thread.
+   */
+  class Cursor {
+  public:
+    using result_type = SharedChaChaStream::result_type;
+
+    static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept {
+      return (std::numeric_limits<result_type>::min)();
+    }
+
+    static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept {
+      return (std::numeric_limits<result_type>::max)();
+    }
+
+    /**
+     * @brief Construct a cursor over a shared stream. Nothing is claimed before the first output.
+     * @param stream The shared stream.
+     */
+    explicit Cursor(SharedChaChaStream &stream) noexcept
+        : m_stream{&stream}, m_engine{stream.m_key, stream.m_first, stream.m_nonce} {}
+
+    // a copy would emit the blocks this cursor already claimed a second time, so a move hands them over and leaves
+    // the source to claim a fresh chunk
+    Cursor(const Cursor &) = delete;
+    Cursor &operator=(const Cursor &) = delete;
+
+    Cursor(Cursor &&other) noexcept
+        : m_stream{other.m_stream}, m_engine{other.m_engine}, m_remaining{other.m_remaining},
+          m_ranges{std::move(other.m_ranges)} {
+      other.release();
+    }
+
+    Cursor &operator=(Cursor &&other) noexcept {
+      if (this != &other) {
+        m_stream = other.m_stream;
+        m_engine = other.m_engine;
+        m_remaining = other.m_remaining;
+        m_ranges = std::move(other.m_ranges);
+        other.release();
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Generates the next 64-bit output. Claiming a chunk records its range, which may allocate.
+     * @return The next 64-bit output.
+     */
+    PRNG_ALWAYS_INLINE result_type operator()() {
+      if (m_remaining == 0) [[unlikely]] {
+        claim_chunk();
+      }
+      --m_remaining;
+      return m_engine();
+    }
+
+    /**
+     * @brief Generates a uniform random number in the range [0, 1).
+     * @return A uniform random number.
+     */
+    PRNG_ALWAYS_INLINE double uniform() { return internal::to_uniform(operator()()); }
+
+    /**
+     * @brief Fills a buffer with 64-bit outputs, identical to calling operator() `n` times.
+     * @param out Pointer to the destination buffer.
+     * @param n The number of values to generate.
+     */
+    void fill(result_type *out, std::size_t n) {
+      while (n != 0) {
+        if (m_remaining == 0) {
+          claim_chunk();
+        }
+        const auto count = n < m_remaining ? n : static_cast<std::size_t>(m_remaining);
+        m_engine.fill(out, count);
+        m_remaining -= count;
+        out += count;
+        n -= count;
+      }
+    }
+
+    /**
+     * @brief Returns the ranges this cursor consumed, in order. The last one is trimmed to the blocks actually used.
+     * @return The consumed ranges.
+     */
+    std::vector<Range> ranges() const {
+      auto ranges = m_ranges;
+      if (!ranges.empty()) {
+        const auto unused_words = m_remaining;
+        ranges.back().count -= unused_words / BLOCK_RESULTS;
+      }
+      return ranges;
+    }
+
+  private:
+    static constexpr auto BLOCK_RESULTS = input_word{8};
+
+    SharedChaChaStream *m_stream;
+    engine_type m_engine;
+    // outputs left in the current chunk
+    input_word m_remaining = 0;
+    std::vector<Range> m_ranges;
+
+    void release() noexcept {
+      m_remaining = 0;
+      m_ranges.clear();
+    }
+
+    void claim_chunk() {
+      const auto range = m_stream->claim(m_stream->m_chunk_blocks);
+      m_engine.set_counter(range.first);
+      m_remaining = range.count * BLOCK_RESULTS;
+      if (!m_ranges.empty() && m_ranges.back().first + m_ranges.back().count == range.first) {
+        m_ranges.back().count += range.count;
+      } else {
+        m_ranges.push_back(range);
+      }
+    }
+  };
+
+  /**
+   * @brief Returns a new cursor over this stream.
+   * @return The cursor.
+   */
+  PRNG_ALWAYS_INLINE Cursor cursor() noexcept { return Cursor{*this}; }
+
+private:
+  std::array<matrix_word, KEY_WORDCOUNT> m_key;
+  input_word m_nonce;
+  input_word m_first;
+  input_word m_chunk_blocks;
+  // the counter shared by all threads sits on its own cache line
+  alignas(64) std::atomic<input_word> m_next;
+};
+
+}
@@ -4,17 +4,66 @@
 #if __cplusplus >= 202002L
 #include <bit>
 #endif
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 #include <type_traits>
 #include <xsimd/xsimd.hpp>
 
+#include "random/cache_fill.hpp"
 #include "random/macros.hpp"
+#include "random/simd_uniform.hpp"
 #include "xsimd/types/xsimd_api.hpp"
 
 namespace prng {
 
-template <std::uint8_t R, class Arch>
+template <std::uint8_t R, class Arch> class ChaChaBank;
+
+namespace internal {
+template <std::uint8_t R, class Arch> struct ChaChaSIMDKernels;
+
+/**
+ * Default number of SIMD batches ChaChaSIMD runs through the rounds together: two on AVX-512, whose 32 registers hold
+ * both working states, one elsewhere.
+ */
+template <class Arch> constexpr std::uint8_t chacha_default_depth() noexcept {
+  if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+    return 2;
+  } else {
+    return 1;
+  }
+}
+}
+
+/**
+ * Output order of ChaChaSIMD.
+ *
+ * `standard` is the ChaCha keystream, identical to ChaCha<R>. `lane_interleaved` skips the transpose of the working
+ * state and emits it in register order: for each batch of W = SIMD width blocks starting at counter c, the 32-bit
+ * words come out as word 0 of blocks c, c+1, ..., c+W-1, then word 1 of the same blocks, up to word 15, and each
+ * 64-bit output joins two consecutive words of that sequence, the first one in the low half. A batch holds the same
+ * words as the standard keystream, in a different order, so the statistical quality is unchanged, but the sequence
+ * depends on W and is not a standard keystream; it is only reproducible for the same architecture. In this order a
+ * block counter names a 64-byte chunk of the output, batches stay aligned to the counter last passed to the
+ * constructor or to set_counter(), and block() is not available.
+ */
+enum class ChaChaOrder { standard, lane_interleaved };
+
+/**
+ * ChaCha generator computing SIMD-width consecutive blocks at once, one block per lane.
+ *
+ * @tparam R The number of rounds.
+ * @tparam Arch The architecture type for SIMD operations.
+ * @tparam Depth The number of batches whose rounds are interleaved, which keeps more independent additions and
+ * rotations in flight at the cost of registers. The keystream does not depend on it.
+ * @tparam Order The output order, see ChaChaOrder.
+ */
+template <std::uint8_t R, class Arch, std::uint8_t Depth = internal::chacha_default_depth<Arch>(),
+          ChaChaOrder Order = ChaChaOrder::standard>
 class ChaChaSIMD {
 protected:
   static constexpr auto MATRIX_WORDCOUNT = std::uint8_t{16};
@@ -28,6 +77,8 @@ public:
   using simd_type = xsimd::batch<matrix_word, Arch>;
   using working_state_type = std::array<simd_type, MATRIX_WORDCOUNT>;
   using result_cache_type = std::array<result_type, MATRIX_WORDCOUNT / 2>;
+  using batch_type = xsimd::batch<result_type, Arch>;
+  using uniform_batch_type = xsimd::batch<double, Arch>;
 
   static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept {
     return (std::numeric_limits<result_type>::min)();
@@ -64,15 +115,8 @@ protected:
   static_assert(MATRIX_WORDCOUNT % SIMD_WIDTH == 0, "ChaCha state must divide evenly into SIMD segments");
   static constexpr std::uint8_t SIMD_WIDTH_MASK = std::uint8_t{SIMD_WIDTH - 1};
   static constexpr std::uint8_t BLOCK_SEGMENTCOUNT = std::uint8_t{MATRIX_WORDCOUNT / SIMD_WIDTH};
-  static constexpr std::uint8_t cache_batchcount() noexcept {
-    if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
-      return 2;
-    } else {
-      return 1;
-    }
-  }
-
-  static constexpr auto CACHE_BATCHCOUNT = cache_batchcount();
+  static_assert(Depth >= 1 && Depth * SIMD_WIDTH < 256, "ChaCha batch depth must fit the 8-bit cache index");
+  static constexpr auto CACHE_BATCHCOUNT = Depth;
   static constexpr auto CACHE_BLOCKCOUNT = std::uint8_t{CACHE_BATCHCOUNT * SIMD_WIDTH};
   using cache_block_type = std::array<simd_type, BLOCK_SEGMENTCOUNT>;
   using cache_batch_type = std::array<cache_block_type, SIMD_WIDTH>;
@@ -135,11 +179,132 @@ public:
     return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
   }
 
+  /**
+   * @brief Generates the next batch_type::size outputs as one SIMD batch. Unlike the xoshiro generators the keystream
+   * order is kept: the batch holds exactly the values the next batch_type::size calls to operator() would return.
+   * @return The next batch of 64-bit outputs.
+   */
+  PRNG_ALWAYS_INLINE batch_type next_batch() noexcept {
+    static_assert(std::tuple_size_v<result_cache_type> % batch_type::size == 0,
+                  "A ChaCha block must hold a whole number of batches");
+    if (m_result_index + batch_type::size > m_result_cache.size()) [[unlikely]] {
+      if (m_result_index < m_result_cache.size()) {
+        // the batch straddles two blocks, only after mixing with operator()
+        std::array<result_type, batch_type::size> values;
+        for (auto &value : values) {
+          value = operator()();
+        }
+        return batch_type::load_unaligned(values.data());
+      }
+      m_result_cache = block_to_results(next_block());
+      m_result_index = 0;
+    }
+    const auto values = batch_type::load_unaligned(m_result_cache.data() + m_result_index);
+    m_result_index = static_cast<std::uint8_t>(m_result_index + batch_type::size);
+    return values;
+  }
+
+  /**
+   * @brief Generates the next batch_type::size uniform random numbers in the range [0, 1), in keystream order.
+   * @return The next batch of uniform random numbers.
+   */
+  PRNG_ALWAYS_INLINE uniform_batch_type next_uniform_batch() noexcept { return internal::to_uniform(next_batch()); }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times, but whole blocks are converted with SIMD instructions.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(double *PRNG_RESTRICT out, std::size_t n) noexcept {
+    using word_batch = xsimd::batch<result_type, Arch>;
+    for (; n != 0 && m_result_index < m_result_cache.size(); --n) {
+      *out++ = internal::to_uniform(m_result_cache[m_result_index++]);
+    }
+    for (; n >= m_result_cache.size(); n -= m_result_cache.size(), out += m_result_cache.size()) {
+      const auto results = block_to_results(next_block());
+      for (auto i = std::size_t{0}; i < results.size(); i += word_batch::size) {
+        internal::to_uniform(word_batch::load_unaligned(results.data() + i)).store_unaligned(out + i);
+      }
+    }
+    if (n != 0) {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = 0;
+      for (; n != 0; --n) {
+        *out++ = internal::to_uniform(m_result_cache[m_result_index++]);
+      }
+    }
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * batches of blocks are transposed straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill(result_type* out, const std::size_t n) noexcept {
+    apply_keystream<false>(reinterpret_cast<std::byte*>(out), n * sizeof(result_type));
+  }
+
+  /**
+   * @brief Writes the next `n` keystream bytes into a buffer. Consecutive fill_bytes() and xor_keystream() calls
+   * continue the byte stream where the previous one stopped, so a message can be processed in chunks of any size.
+   * The unused bytes of a last partial 64-bit word are kept for them. operator() and the other word-level functions
+   * continue after that word without touching the kept bytes, so the next byte-level call returns those bytes first,
+   * ahead of the words drawn in between. Repositioning drops them.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of bytes to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill_bytes(std::byte* out, const std::size_t n) noexcept {
+    apply_bytes<false>(out, n);
+  }
+
+  /**
+   * @brief XORs the next `n` keystream bytes into a buffer, e.g. to encrypt it or to apply a one-time pad. The stream
+   * advances exactly like fill_bytes().
+   * @param data Pointer to the buffer.
+   * @param n The number of bytes to process.
+   */
+  PRNG_ALWAYS_INLINE void xor_keystream(std::byte* data, const std::size_t n) noexcept {
+    apply_bytes<true>(data, n);
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with keystream bytes.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_bytes(const std::span<std::byte> out) noexcept { fill_bytes(out.data(), out.size()); }
+
+  /**
+   * @brief XORs the keystream into a span.
+   * @param data The span to process.
+   */
+  PRNG_ALWAYS_INLINE void xor_keystream(const std::span<std::byte> data) noexcept {
+    xor_keystream(data.data(), data.size());
+  }
+#endif
+
   /**
    * @brief Generates the next 64-byte ChaCha block.
    * @return The next 64-byte ChaCha block.
    */
   PRNG_ALWAYS_INLINE constexpr matrix_type block() noexcept {
+    static_assert(Order == ChaChaOrder::standard, "The lane-interleaved order does not produce whole ChaCha blocks");
     if (m_result_index < m_result_cache.size()) {
       auto cached_block = results_to_block(m_result_cache);
       m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
@@ -149,7 +314,8 @@ public:
   }
 
   /**
-   * @brief Returns the state of the generator; a 4x4 matrix.
+   * @brief Returns the state of the generator; a 4x4 matrix. In lane-interleaved order the counter words hold the
+   * index of the current 64-byte chunk instead of a block counter.
    * @return State of the generator.
    */
   PRNG_ALWAYS_INLINE constexpr matrix_type getState() const noexcept {
@@ -166,6 +332,67 @@ public:
     return state;
   }
 
+  /**
+   * @brief Sets the block counter and drops every cached block and byte. The next output is the first word of block
+   * `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_counter(const input_word counter) noexcept {
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_cache_index = CACHE_BLOCKCOUNT;
+    m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
+    m_byte_count = 0;
+  }
+
+  /**
+   * @brief Sets the nonce and restarts at the current block, like seek(getState() counter, 0).
+   * @param nonce The new nonce.
+   */
+  PRNG_ALWAYS_INLINE constexpr void set_nonce(const input_word nonce) noexcept {
+    const auto state = getState();
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+    seek((static_cast<input_word>(state[13]) << 32) | state[12], 0);
+  }
+
+  /**
+   * @brief Positions the generator so that the next output is 64-bit word `word` of block `block`, in constant time.
+   * In lane-interleaved order `block` is a 64-byte chunk of the output and the batch alignment is kept.
+   * @param block The block counter.
+   * @param word The 64-bit word within the block. Words past the end of the block carry into the following blocks.
+   */
+  PRNG_ALWAYS_INLINE constexpr void seek(const input_word block, const std::uint8_t word) noexcept {
+    if constexpr (Order == ChaChaOrder::lane_interleaved) {
+      // the counter stays a whole number of batches away from where the stream started, so regenerate the batch
+      // holding the chunk and skip to it
+      const auto target = block + word / m_result_cache.size();
+      const auto chunk = static_cast<std::uint8_t>((target - m_state[12]) & SIMD_WIDTH_MASK);
+      set_counter(target - chunk);
+      if (chunk != 0) {
+        gen_next_blocks_in_cache();
+        m_cache_index = chunk;
+      }
+    } else {
+      set_counter(block + word / m_result_cache.size());
+    }
+    if (word % m_result_cache.size() != 0) {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = static_cast<std::uint8_t>(word % m_result_cache.size());
+    }
+  }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(const input_word n) noexcept {
+    const auto state = getState();
+    const auto block = (static_cast<input_word>(state[13]) << 32) | state[12];
+    const auto word = (m_result_index < m_result_cache.size() ? m_result_index : 0) + n % m_result_cache.size();
+    seek(block + n / m_result_cache.size() + word / m_result_cache.size(),
+         static_cast<std::uint8_t>(word % m_result_cache.size()));
+  }
 
 private:
   matrix_type m_state;
@@ -174,6 +401,9 @@ private:
   std::uint8_t m_result_index = static_cast<std::uint8_t>(m_result_cache.size());
   // Initialize to "past end of the cache" since cache starts empty.
   std::uint8_t m_cache_index = CACHE_BLOCKCOUNT;
+  // the last m_byte_count bytes of m_byte_cache are the byte stream's unused part of a 64-bit word
+  std::array<std::byte, sizeof(result_type)> m_byte_cache{};
+  std::uint8_t m_byte_count = 0;
 
   static inline constexpr std::array<matrix_word, SIMD_WIDTH> LANE_OFFSETS = [] {
     std::array<matrix_word, SIMD_WIDTH> offsets{};
@@ -197,7 +427,7 @@ private:
     for (auto i = std::size_t{1}; i < SIMD_WIDTH; ++i) {
       incs[i] = static_cast<matrix_word>(overflow_index < i);
     }
-    return xsimd::load_unaligned(incs.data());
+    return simd_type::load_unaligned(incs.data());
   }
 
   static constexpr PRNG_ALWAYS_INLINE result_cache_type block_to_results(const matrix_type& block) noexcept {
@@ -245,7 +475,16 @@ private:
     x[13] += higher_counter_inc;
   }
 
+  /**
+   * Writes a batch into the cache in output order: transposed to whole blocks, or as is in lane-interleaved order.
+   */
   static void transpose_into_cache(cache_batch_type& cache, working_state_type& x) noexcept {
+    if constexpr (Order == ChaChaOrder::lane_interleaved) {
+      for (auto i = std::size_t{0}; i < MATRIX_WORDCOUNT; ++i) {
+        cache[i / BLOCK_SEGMENTCOUNT][i % BLOCK_SEGMENTCOUNT] = x[i];
+      }
+      return;
+    }
     auto* PRNG_RESTRICT cache_lanes = cache.data();
     auto* PRNG_RESTRICT working = x.data();
     for (auto segment = std::size_t{0}; segment < BLOCK_SEGMENTCOUNT; ++segment) {
@@ -269,137 +508,300 @@ private:
    * Generates `SIMD_WIDTH` new ChaCha blocks into one cache batch.
    */
   PRNG_ALWAYS_INLINE static void gen_block_batch(cache_batch_type& cache, const matrix_type& state) noexcept {
-    const auto lower_counter_inc = xsimd::load_unaligned(LANE_OFFSETS.data());
-    matrix_word overflow_index = std::numeric_limits<matrix_word>::max() - state[12];
-    const auto higher_counter_inc = make_higher_counter_inc(overflow_index);
-
     working_state_type x;
-    init_state_batches(x, state, lower_counter_inc, higher_counter_inc);
+    gen_working_state(x, state);
+    transpose_into_cache(cache, x);
+  }
+
+  /**
+   * Stores `SIMD_WIDTH` consecutive keystream blocks straight into a byte buffer, or XORs them into it, without going
+   * through the cache. In lane-interleaved order the registers are stored as they are.
+   * @param x The working state of a batch, one block per lane.
+   * @param out Destination of SIMD_WIDTH * 64 bytes, in any alignment.
+   */
+  template <bool Xor>
+  PRNG_ALWAYS_INLINE static void store_block_batch(working_state_type& x, std::byte* PRNG_RESTRICT out) noexcept {
+    if constexpr (Order == ChaChaOrder::lane_interleaved) {
+      for (auto i = std::size_t{0}; i < MATRIX_WORDCOUNT; ++i) {
+        auto* const destination = reinterpret_cast<matrix_word*>(out) + i * SIMD_WIDTH;
+        if constexpr (Xor) {
+          (simd_type::load_unaligned(destination) ^ x[i]).store_unaligned(destination);
+        } else {
+          x[i].store_unaligned(destination);
+        }
+      }
+      return;
+    }
+    for (auto segment = std::size_t{0}; segment < BLOCK_SEGMENTCOUNT; ++segment) {
+      auto* PRNG_RESTRICT segment_begin = x.data() + segment * SIMD_WIDTH;
+      xsimd::transpose(segment_begin, segment_begin + SIMD_WIDTH);
+      for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+        auto* const destination =
+          reinterpret_cast<matrix_word*>(out + lane * sizeof(matrix_type)) + segment * SIMD_WIDTH;
+        if constexpr (Xor) {
+          (simd_type::load_unaligned(destination) ^ segment_begin[lane]).store_unaligned(destination);
+        } else {
+          segment_begin[lane].store_unaligned(destination);
+        }
+      }
+    }
+  }
+
+  /**
+   * Copies or XORs `count` keystream bytes into a buffer.
+   */
+  template <bool Xor>
+  PRNG_ALWAYS_INLINE static void combine(std::byte* PRNG_RESTRICT out, const void* keystream,
+                                         const std::size_t count) noexcept {
+    if constexpr (Xor) {
+      const auto* const bytes = static_cast<const std::byte*>(keystream);
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        out[i] ^= bytes[i];
+      }
+    } else {
+      std::memcpy(out, keystream, count);
+    }
+  }
+
+  /**
+   * Writes (or XORs) the next `n` bytes of the byte stream into `out`: the unused bytes left by the previous call, then
+   * whole 64-bit words, then a last partial word whose unused bytes are kept for the next call.
+   */
+  template <bool Xor>
+  PRNG_ALWAYS_INLINE void apply_bytes(std::byte* PRNG_RESTRICT out, std::size_t n) noexcept {
+    constexpr auto word_bytes = sizeof(result_type);
+    const auto leftover = n < m_byte_count ? n : std::size_t{m_byte_count};
+    combine<Xor>(out, m_byte_cache.data() + word_bytes - m_byte_count, leftover);
+    m_byte_count = static_cast<std::uint8_t>(m_byte_count - leftover);
+    out += leftover;
+    n -= leftover;
+    const auto tail = n % word_bytes;
+    apply_keystream<Xor>(out, n - tail);
+    if (tail != 0) {
+      const auto word = operator()();
+      std::memcpy(m_byte_cache.data(), &word, word_bytes);
+      combine<Xor>(out + n - tail, m_byte_cache.data(), tail);
+      m_byte_count = static_cast<std::uint8_t>(word_bytes - tail);
+    }
+  }
+
+  /**
+   * Writes (or XORs) the next `n` keystream bytes into `out`. Cached values are used first, whole batches are then
+   * transposed straight into the buffer and the tail goes through the cache again. The stream advances by whole
+   * 64-bit words, the unused bytes of a last partial word are dropped.
+   */
+  template <bool Xor>
+  PRNG_ALWAYS_INLINE void apply_keystream(std::byte* PRNG_RESTRICT out, std::size_t n) noexcept {
+    constexpr auto word_bytes = sizeof(result_type);
+    constexpr auto block_bytes = sizeof(matrix_type);
+    constexpr auto batch_bytes = block_bytes * CACHE_BLOCKCOUNT;
+    // the rest of a partially consumed block
+    while (n != 0 && m_result_index < m_result_cache.size()) {
+      const auto count = n < word_bytes ? n : word_bytes;
+      combine<Xor>(out, &m_result_cache[m_result_index++], count);
+      out += count;
+      n -= count;
+    }
+    while (n >= block_bytes) {
+      if (m_cache_index >= CACHE_BLOCKCOUNT && n >= batch_bytes) {
+        // nothing left in the cache, so whole batches skip it
+        std::array<working_state_type, CACHE_BATCHCOUNT> x;
+        gen_working_states<CACHE_BATCHCOUNT>(x.data(), m_state);
+        for (auto batch = std::size_t{0}; batch < CACHE_BATCHCOUNT; ++batch) {
+          store_block_batch<Xor>(x[batch], out + batch * block_bytes * SIMD_WIDTH);
+          advance_counter(m_state);
+        }
+        out += batch_bytes;
+        n -= batch_bytes;
+        continue;
+      }
+      const auto block = next_block();
+      combine<Xor>(out, block.data(), block_bytes);
+      out += block_bytes;
+      n -= block_bytes;
+    }
+    if (n != 0) {
+      m_result_cache = block_to_results(next_block());
+      m_result_index = 0;
+      while (n != 0) {
+        const auto count = n < word_bytes ? n : word_bytes;
+        combine<Xor>(out, &m_result_cache[m_result_index++], count);
+        out += count;
+        n -= count;
+      }
+    }
+  }
+
+  /**
+   * Column round: quarter rounds on (0,4,8,12), (1,5,9,13), (2,6,10,14) and (3,7,11,15) of every lane.
+   */
+  PRNG_ALWAYS_INLINE static void column_round(working_state_type& x) noexcept {
+    x[0] += x[4];
+    x[1] += x[5];
+    x[2] += x[6];
+    x[3] += x[7];
+
+    x[12] ^= x[0];
+    x[13] ^= x[1];
+    x[14] ^= x[2];
+    x[15] ^= x[3];
+
+    x[12] = xsimd::rotl<16>(x[12]);
+    x[13] = xsimd::rotl<16>(x[13]);
+    x[14] = xsimd::rotl<16>(x[14]);
+    x[15] = xsimd::rotl<16>(x[15]);
+
+    x[8] += x[12];
+    x[9] += x[13];
+    x[10] += x[14];
+    x[11] += x[15];
+
+    x[4] ^= x[8];
+    x[5] ^= x[9];
+    x[6] ^= x[10];
+    x[7] ^= x[11];
+
+    x[4] = xsimd::rotl<12>(x[4]);
+    x[5] = xsimd::rotl<12>(x[5]);
+    x[6] = xsimd::rotl<12>(x[6]);
+    x[7] = xsimd::rotl<12>(x[7]);
+
+    x[0] += x[4];
+    x[1] += x[5];
+    x[2] += x[6];
+    x[3] += x[7];
+
+    x[12] ^= x[0];
+    x[13] ^= x[1];
+    x[14] ^= x[2];
+    x[15] ^= x[3];
+
+    x[12] = xsimd::rotl<8>(x[12]);
+    x[13] = xsimd::rotl<8>(x[13]);
+    x[14] = xsimd::rotl<8>(x[14]);
+    x[15] = xsimd::rotl<8>(x[15]);
+
+    x[8] += x[12];
+    x[9] += x[13];
+    x[10] += x[14];
+    x[11] += x[15];
+
+    x[4] ^= x[8];
+    x[5] ^= x[9];
+    x[6] ^= x[10];
+    x[7] ^= x[11];
+
+    x[4] = xsimd::rotl<7>(x[4]);
+    x[5] = xsimd::rotl<7>(x[5]);
+    x[6] = xsimd::rotl<7>(x[6]);
+    x[7] = xsimd::rotl<7>(x[7]);
+  }
+
+  /**
+   * Diagonal round: quarter rounds on (0,5,10,15), (1,6,11,12), (2,7,8,13) and (3,4,9,14) of every lane.
+   */
+  PRNG_ALWAYS_INLINE static void diagonal_round(working_state_type& x) noexcept {
+    x[0] += x[5];
+    x[1] += x[6];
+    x[2] += x[7];
+    x[3] += x[4];
+
+    x[15] ^= x[0];
+    x[12] ^= x[1];
+    x[13] ^= x[2];
+    x[14] ^= x[3];
+
+    x[15] = xsimd::rotl<16>(x[15]);
+    x[12] = xsimd::rotl<16>(x[12]);
+    x[13] = xsimd::rotl<16>(x[13]);
+    x[14] = xsimd::rotl<16>(x[14]);
+
+    x[10] += x[15];
+    x[11] += x[12];
+    x[8] += x[13];
+    x[9] += x[14];
+
+    x[5] ^= x[10];
+    x[6] ^= x[11];
+    x[7] ^= x[8];
+    x[4] ^= x[9];
+
+    x[5] = xsimd::rotl<12>(x[5]);
+    x[6] = xsimd::rotl<12>(x[6]);
+    x[7] = xsimd::rotl<12>(x[7]);
+    x[4] = xsimd::rotl<12>(x[4]);
+
+    x[0] += x[5];
+    x[1] += x[6];
+    x[2] += x[7];
+    x[3] += x[4];
+
+    x[15] ^= x[0];
+    x[12] ^= x[1];
+    x[13] ^= x[2];
+    x[14] ^= x[3];
+
+    x[15] = xsimd::rotl<8>(x[15]);
+    x[12] = xsimd::rotl<8>(x[12]);
+    x[13] = xsimd::rotl<8>(x[13]);
+    x[14] = xsimd::rotl<8>(x[14]);
+
+    x[10] += x[15];
+    x[11] += x[12];
+    x[8] += x[13];
+    x[9] += x[14];
+
+    x[5] ^= x[10];
+    x[6] ^= x[11];
+    x[7] ^= x[8];
+    x[4] ^= x[9];
+
+    x[5] = xsimd::rotl<7>(x[5]);
+    x[6] = xsimd::rotl<7>(x[6]);
+    x[7] = xsimd::rotl<7>(x[7]);
+    x[4] = xsimd::rotl<7>(x[4]);
+  }
+
+  /**
+   * Runs the ChaCha rounds on `Batches * SIMD_WIDTH` consecutive blocks, one block per lane, and adds the input state.
+   * The batches go through each round together so that their independent instructions can overlap.
+   * @param x The `Batches` working states, the first one starting at the counter of `state`.
+   * @param state The input state.
+   */
+  template <std::size_t Batches>
+  PRNG_ALWAYS_INLINE static void gen_working_states(working_state_type* PRNG_RESTRICT x,
+                                                    const matrix_type& state) noexcept {
+    const auto lower_counter_inc = simd_type::load_unaligned(LANE_OFFSETS.data());
+    std::array<matrix_type, Batches> states;
+    std::array<simd_type, Batches> higher_counter_inc;
+    for (auto batch = std::size_t{0}; batch < Batches; ++batch) {
+      states[batch] = batch == 0 ? state : states[batch - 1];
+      if (batch != 0) {
+        advance_counter(states[batch]);
+      }
+      higher_counter_inc[batch] = make_higher_counter_inc(std::numeric_limits<matrix_word>::max() - states[batch][12]);
+      init_state_batches(x[batch], states[batch], lower_counter_inc, higher_counter_inc[batch]);
+    }
 
     for (auto i = 0; i < R; i += 2) {
-      x[0] += x[4];
-      x[1] += x[5];
-      x[2] += x[6];
-      x[3] += x[7];
-
-      x[12] ^= x[0];
-      x[13] ^= x[1];
-      x[14] ^= x[2];
-      x[15] ^= x[3];
-
-      x[12] = xsimd::rotl<16>(x[12]);
-      x[13] = xsimd::rotl<16>(x[13]);
-      x[14] = xsimd::rotl<16>(x[14]);
-      x[15] = xsimd::rotl<16>(x[15]);
-
-      x[8] += x[12];
-      x[9] += x[13];
-      x[10] += x[14];
-      x[11] += x[15];
-
-      x[4] ^= x[8];
-      x[5] ^= x[9];
-      x[6] ^= x[10];
-      x[7] ^= x[11];
-
-      x[4] = xsimd::rotl<12>(x[4]);
-      x[5] = xsimd::rotl<12>(x[5]);
-      x[6] = xsimd::rotl<12>(x[6]);
-      x[7] = xsimd::rotl<12>(x[7]);
-
-      x[0] += x[4];
-      x[1] += x[5];
-      x[2] += x[6];
-      x[3] += x[7];
-
-      x[12] ^= x[0];
-      x[13] ^= x[1];
-      x[14] ^= x[2];
-      x[15] ^= x[3];
-
-      x[12] = xsimd::rotl<8>(x[12]);
-      x[13] = xsimd::rotl<8>(x[13]);
-      x[14] = xsimd::rotl<8>(x[14]);
-      x[15] = xsimd::rotl<8>(x[15]);
-
-      x[8] += x[12];
-      x[9] += x[13];
-      x[10] += x[14];
-      x[11] += x[15];
-
-      x[4] ^= x[8];
-      x[5] ^= x[9];
-      x[6] ^= x[10];
-      x[7] ^= x[11];
-
-      x[4] = xsimd::rotl<7>(x[4]);
-      x[5] = xsimd::rotl<7>(x[5]);
-      x[6] = xsimd::rotl<7>(x[6]);
-      x[7] = xsimd::rotl<7>(x[7]);
-
-      x[0] += x[5];
-      x[1] += x[6];
-      x[2] += x[7];
-      x[3] += x[4];
-
-      x[15] ^= x[0];
-      x[12] ^= x[1];
-      x[13] ^= x[2];
-      x[14] ^= x[3];
-
-      x[15] = xsimd::rotl<16>(x[15]);
-      x[12] = xsimd::rotl<16>(x[12]);
-      x[13] = xsimd::rotl<16>(x[13]);
-      x[14] = xsimd::rotl<16>(x[14]);
-
-      x[10] += x[15];
-      x[11] += x[12];
-      x[8] += x[13];
-      x[9] += x[14];
-
-      x[5] ^= x[10];
-      x[6] ^= x[11];
-      x[7] ^= x[8];
-      x[4] ^= x[9];
-
-      x[5] = xsimd::rotl<12>(x[5]);
-      x[6] = xsimd::rotl<12>(x[6]);
-      x[7] = xsimd::rotl<12>(x[7]);
-      x[4] = xsimd::rotl<12>(x[4]);
-
-      x[0] += x[5];
-      x[1] += x[6];
-      x[2] += x[7];
-      x[3] += x[4];
-
-      x[15] ^= x[0];
-      x[12] ^= x[1];
-      x[13] ^= x[2];
-      x[14] ^= x[3];
-
-      x[15] = xsimd::rotl<8>(x[15]);
-      x[12] = xsimd::rotl<8>(x[12]);
-      x[13] = xsimd::rotl<8>(x[13]);
-      x[14] = xsimd::rotl<8>(x[14]);
-
-      x[10] += x[15];
-      x[11] += x[12];
-      x[8] += x[13];
-      x[9] += x[14];
-
-      x[5] ^= x[10];
-      x[6] ^= x[11];
-      x[7] ^= x[8];
-      x[4] ^= x[9];
-
-      x[5] = xsimd::rotl<7>(x[5]);
-      x[6] = xsimd::rotl<7>(x[6]);
-      x[7] = xsimd::rotl<7>(x[7]);
-      x[4] = xsimd::rotl<7>(x[4]);
-    }
-
-    add_original_state(x, state, lower_counter_inc, higher_counter_inc);
-    transpose_into_cache(cache, x);
+      for (auto batch = std::size_t{0}; batch < Batches; ++batch) {
+        column_round(x[batch]);
+      }
+      for (auto batch = std::size_t{0}; batch < Batches; ++batch) {
+        diagonal_round(x[batch]);
+      }
+    }
+
+    for (auto batch = std::size_t{0}; batch < Batches; ++batch) {
+      add_original_state(x[batch], states[batch], lower_counter_inc, higher_counter_inc[batch]);
+    }
+  }
+
+  /**
+   * Runs the ChaCha rounds on `SIMD_WIDTH` consecutive blocks, one block per lane, and adds the input state.
+   */
+  PRNG_ALWAYS_INLINE static void gen_working_state(working_state_type& x, const matrix_type& state) noexcept {
+    gen_working_states<1>(&x, state);
   }
 
   PRNG_ALWAYS_INLINE constexpr matrix_type next_block() noexcept {
@@ -426,15 +828,373 @@ private:
   }
 
   /**
-   * Generates one or two SIMD batches, depending on the target ISA, and writes them into the cache.
+   * Generates `Depth` SIMD batches with interleaved rounds and writes them into the cache.
    */
   PRNG_ALWAYS_INLINE constexpr void gen_next_blocks_in_cache() noexcept {
-    auto state = m_state;
-    for (auto batch = std::uint8_t{0}; batch < CACHE_BATCHCOUNT; ++batch) {
-      gen_block_batch(m_cache[batch], state);
-      advance_counter(state);
+    std::array<working_state_type, CACHE_BATCHCOUNT> x;
+    gen_working_states<CACHE_BATCHCOUNT>(x.data(), m_state);
+    for (auto batch = std::size_t{0}; batch < CACHE_BATCHCOUNT; ++batch) {
+      transpose_into_cache(m_cache[batch], x[batch]);
+      advance_counter(m_state);
+    }
+  }
+
+  template <std::uint8_t, class> friend struct internal::ChaChaSIMDKernels;
+  template <std::uint8_t, class> friend class ChaChaBank;
+};
+
+namespace internal {
+
+/**
+ * Entry points of one ChaChaDispatch target. They generate whole keystream blocks from a state matrix passed by
+ * pointer and advance its counter, so the generator needs neither a heap allocation nor virtual calls.
+ */
+struct ChaChaSIMDTable {
+  using result_type = std::uint64_t;
+  using matrix_word = std::uint32_t;
+  void (*blocks)(matrix_word *state, result_type *out, std::size_t n) noexcept;
+  void (*uniform_blocks)(matrix_word *state, double *out, std::size_t n) noexcept;
+};
+
+/**
+ * Implementations of the ChaChaSIMDTable entry points on top of ChaChaSIMD<R, Arch>.
+ *
+ * @tparam R The number of rounds.
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <std::uint8_t R, class Arch> struct ChaChaSIMDKernels {
+  using engine_type = ChaChaSIMD<R, Arch>;
+  using result_type = ChaChaSIMDTable::result_type;
+  using matrix_word = ChaChaSIMDTable::matrix_word;
+  using matrix_type = typename engine_type::matrix_type;
+  static constexpr auto SIMD_WIDTH = std::size_t{engine_type::SIMD_WIDTH};
+  static constexpr auto BLOCK_RESULTS = std::size_t{engine_type::MATRIX_WORDCOUNT / 2};
+
+  /**
+   * Generates `n` consecutive blocks, as 64-bit outputs in operator() order, and advances the counter past them.
+   */
+  static void blocks(matrix_word *state, result_type *out, std::size_t n) noexcept {
+    // whole batches are transposed straight into the buffer
+    matrix_type matrix;
+    std::memcpy(matrix.data(), state, sizeof(matrix_type));
+    for (; n >= SIMD_WIDTH; n -= SIMD_WIDTH, out += SIMD_WIDTH * BLOCK_RESULTS) {
+      typename engine_type::working_state_type x;
+      engine_type::gen_working_state(x, matrix);
+      engine_type::template store_block_batch<false>(x, reinterpret_cast<std::byte *>(out));
+      engine_type::advance_counter(matrix);
+    }
+    std::memcpy(state, matrix.data(), sizeof(matrix_type));
+    for_each_batch(state, n, [&out](const result_type *results, const std::size_t count) {
+      std::memcpy(out, results, count * sizeof(result_type));
+      out += count;
+    });
+  }
+
+  /**
+   * Generates `n` consecutive blocks as uniform doubles in [0, 1), converted in registers.
+   */
+  static void uniform_blocks(matrix_word *state, double *out, std::size_t n) noexcept {
+    using word_batch = xsimd::batch<result_type, Arch>;
+    for_each_batch(state, n, [&out](const result_type *results, const std::size_t count) {
+      for (auto i = std::size_t{0}; i < count; i += word_batch::size) {
+        to_uniform(word_batch::load_aligned(results + i)).store_unaligned(out + i);
+      }
+      out += count;
+    });
+  }
+
+  static constexpr ChaChaSIMDTable table{&blocks, &uniform_blocks};
+
+private:
+  /**
+   * Generates `n` blocks one SIMD batch at a time and hands the outputs of each batch to `consume`.
+   */
+  template <class Consume>
+  static PRNG_ALWAYS_INLINE void for_each_batch(matrix_word *state, std::size_t n, Consume &&consume) noexcept {
+    matrix_type matrix;
+    std::memcpy(matrix.data(), state, sizeof(matrix_type));
+    alignas(Arch::alignment()) std::array<result_type, SIMD_WIDTH * BLOCK_RESULTS> results;
+    typename engine_type::cache_batch_type batch;
+    while (n != 0) {
+      const auto count = n < SIMD_WIDTH ? n : SIMD_WIDTH;
+      engine_type::gen_block_batch(batch, matrix);
+      std::memcpy(results.data(), batch.data(), count * sizeof(matrix_type));
+      consume(results.data(), count * BLOCK_RESULTS);
+      auto counter = (static_cast<std::uint64_t>(matrix[13]) << 32 | matrix[12]) + count;
+      matrix[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+      matrix[13] = static_cast<matrix_word>(counter >> 32);
+      n -= count;
+    }
+    std::memcpy(state, matrix.data(), sizeof(matrix_type));
+  }
+};
+
+}
+
+/**
+ * Returns the ChaChaDispatch entry points of the best architecture the CPU supports, detected on the first call only.
+ *
+ * @tparam R The number of rounds. 8, 12 and 20 are instantiated.
+ * @return The dispatch table.
+ */
+template <std::uint8_t R> const internal::ChaChaSIMDTable &chacha_simd_table() noexcept;
+
+/**
+ * ChaCha generator that selects the SIMD implementation at runtime, like XoshiroSIMD. The output is the keystream in
+ * the same order as ChaCha<R> and ChaChaSIMD<R, Arch>, whatever architecture is selected.
+ *
+ * @tparam R The number of rounds.
+ */
+template <std::uint8_t R = 20>
+class ChaChaDispatch {
+protected:
+  static constexpr auto MATRIX_WORDCOUNT = std::uint8_t{16};
+  static constexpr auto KEY_WORDCOUNT = std::uint8_t{8};
+
+public:
+  using result_type = internal::ChaChaSIMDTable::result_type;
+  using input_word = std::uint64_t;
+  using matrix_word = internal::ChaChaSIMDTable::matrix_word;
+  using matrix_type = std::array<matrix_word, MATRIX_WORDCOUNT>;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept {
+    return (std::numeric_limits<result_type>::min)();
+  }
+
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept {
+    return (std::numeric_limits<result_type>::max)();
+  }
+
+  /**
+   * @brief Construct a runtime-dispatched ChaCha generator with given key, counter and nonce
+   * @param key A 256-bit key, divided up into eight 32-bit words.
+   * @param counter Initial value of the counter.
+   * @param nonce Initial value of the nonce.
+   */
+  explicit ChaChaDispatch(
+    const std::array<matrix_word, KEY_WORDCOUNT> key,
+    const input_word counter,
+    const input_word nonce
+  ) noexcept : m_table{&chacha_simd_table<R>()} {
+    // "expand 32-byte k" in ASCII (little-endian)
+    m_state[0] = 0x61707865;
+    m_state[1] = 0x3320646e;
+    m_state[2] = 0x79622d32;
+    m_state[3] = 0x6b206574;
+
+    for (auto i = std::size_t{0}; i < KEY_WORDCOUNT; ++i) {
+      m_state[4 + i] = key[i];
+    }
+
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * blocks are generated straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+      [this]() noexcept { populate_cache(); },
+      [this](result_type *dst, const std::size_t count) noexcept {
+        m_table->blocks(m_state.data(), dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+      [this]() noexcept { populate_cache(); },
+      [this](double *dst, const std::size_t count) noexcept {
+        m_table->uniform_blocks(m_state.data(), dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Generates the next 64-byte ChaCha block. A partially consumed block is returned whole, like ChaCha<R>.
+   * @return The next 64-byte ChaCha block.
+   */
+  PRNG_ALWAYS_INLINE matrix_type block() noexcept {
+    if (m_index == CACHE_SIZE) {
+      populate_cache();
+      m_index = 0;
+    }
+    const auto first = m_index - m_index % BLOCK_RESULTS;
+    matrix_type block;
+    std::memcpy(block.data(), m_cache.data() + first, sizeof(matrix_type));
+    m_index = static_cast<std::uint32_t>(first + BLOCK_RESULTS);
+    return block;
+  }
+
+  /**
+   * @brief Returns the state of the generator; a 4x4 matrix whose counter is the block currently being consumed.
+   * @return State of the generator.
+   */
+  PRNG_ALWAYS_INLINE matrix_type getState() const noexcept {
+    matrix_type state = m_state;
+    // cached blocks that are not fully consumed yet
+    const auto pending = (CACHE_SIZE - m_index + BLOCK_RESULTS - 1) / BLOCK_RESULTS;
+    const auto counter = ((static_cast<input_word>(state[13]) << 32) | state[12]) - pending;
+    state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    state[13] = static_cast<matrix_word>(counter >> 32);
+    return state;
+  }
+
+  /**
+   * @brief Sets the block counter and drops the cache. The next output is the first word of block `counter`.
+   * @param counter The new block counter.
+   */
+  PRNG_ALWAYS_INLINE void set_counter(const input_word counter) noexcept {
+    m_state[12] = static_cast<matrix_word>(counter & 0xFFFFFFFF);
+    m_state[13] = static_cast<matrix_word>(counter >> 32);
+    m_index = CACHE_SIZE;
+  }
+
+  /**
+   * @brief Sets the nonce and restarts at the current block, like set_counter(getState() counter).
+   * @param nonce The new nonce.
+   */
+  PRNG_ALWAYS_INLINE void set_nonce(const input_word nonce) noexcept {
+    const auto state = getState();
+    m_state[14] = static_cast<matrix_word>(nonce & 0xFFFFFFFF);
+    m_state[15] = static_cast<matrix_word>(nonce >> 32);
+    set_counter((static_cast<input_word>(state[13]) << 32) | state[12]);
+  }
+
+  /**
+   * @brief Positions the generator so that the next output is 64-bit word `word` of block `block`, in constant time.
+   * @param block The block counter.
+   * @param word The 64-bit word within the block. Words past the end of the block carry into the following blocks.
+   */
+  PRNG_ALWAYS_INLINE void seek(const input_word block, const std::uint8_t word) noexcept {
+    set_counter(block + word / BLOCK_RESULTS);
+    if (word % BLOCK_RESULTS != 0) {
+      populate_cache();
+      m_index = static_cast<std::uint32_t>(word % BLOCK_RESULTS);
     }
-    m_state = state;
   }
+
+  /**
+   * @brief Advances the generator by n outputs, equivalent to n calls to operator() but in constant time.
+   * @param n The number of outputs to skip.
+   */
+  PRNG_ALWAYS_INLINE void discard(const input_word n) noexcept {
+    const auto state = getState();
+    const auto block = (static_cast<input_word>(state[13]) << 32) | state[12];
+    const auto word = m_index % BLOCK_RESULTS + n % BLOCK_RESULTS;
+    seek(block + n / BLOCK_RESULTS + word / BLOCK_RESULTS, static_cast<std::uint8_t>(word % BLOCK_RESULTS));
+  }
+
+protected:
+  static constexpr auto BLOCK_RESULTS = std::size_t{MATRIX_WORDCOUNT / 2};
+  // one batch of the widest supported register: 16 blocks of 32-bit lanes
+  static constexpr auto CACHE_BLOCKCOUNT = std::size_t{16};
+  static constexpr auto CACHE_SIZE = CACHE_BLOCKCOUNT * BLOCK_RESULTS;
+
+  /**
+   * Refills the whole cache with one call into the dispatched implementation.
+   */
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept {
+    m_table->blocks(m_state.data(), m_cache.data(), CACHE_BLOCKCOUNT);
+  }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  matrix_type m_state;
+  const internal::ChaChaSIMDTable *m_table;
+  std::uint32_t m_index{CACHE_SIZE};
+};
+
+// Reduced-round presets: ChaCha8 and ChaCha12 trade security margin for speed, ChaCha20 is the standard cipher.
+using ChaCha8SIMD = ChaChaSIMD<8, xsimd::best_arch>;
+using ChaCha12SIMD = ChaChaSIMD<12, xsimd::best_arch>;
+using ChaCha20SIMD = ChaChaSIMD<20, xsimd::best_arch>;
+using ChaCha8Dispatch = ChaChaDispatch<8>;
+using ChaCha12Dispatch = ChaChaDispatch<12>;
+using ChaCha20Dispatch = ChaChaDispatch<20>;
+
+static_assert(std::is_trivially_copyable_v<ChaCha20Dispatch>);
+
+namespace internal {
+
+/**
+ * Functor used by xsimd::dispatch to select the ChaChaDispatch entry points.
+ *
+ * @tparam R The number of rounds.
+ */
+template <std::uint8_t R> struct ChaChaSIMDTableCreator {
+  /**
+   * Operator that returns the ChaChaDispatch entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @param arch The architecture tag.
+   * @return The dispatch table.
+   */
+  template <class Arch> const ChaChaSIMDTable *operator()(Arch) const noexcept;
 };
+
+template <std::uint8_t R>
+template <class Arch>
+const ChaChaSIMDTable *ChaChaSIMDTableCreator<R>::operator()(Arch) const noexcept {
+  return &ChaChaSIMDKernels<R, Arch>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points of every round count for one architecture.
+#define PRNG_CHACHA_SIMD_TABLES(PREFIX, ARCH)                                                                         \
+  PREFIX template const ChaChaSIMDTable *ChaChaSIMDTableCreator<8>::operator()<ARCH>(ARCH) const noexcept;            \
+  PREFIX template const ChaChaSIMDTable *ChaChaSIMDTableCreator<12>::operator()<ARCH>(ARCH) const noexcept;           \
+  PREFIX template const ChaChaSIMDTable *ChaChaSIMDTableCreator<20>::operator()<ARCH>(ARCH) const noexcept;
+
+PRNG_CHACHA_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_CHACHA_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_CHACHA_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_CHACHA_SIMD_TABLES(extern, xsimd::avx512f)
+
+}
+
 }
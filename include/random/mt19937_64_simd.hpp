@@ -0,0 +1,323 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <xsimd/xsimd.hpp>
+
+#include "random/cache_fill.hpp"
+#include "random/macros.hpp"
+#include "random/simd_uniform.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * MT19937-64 parameters, as in `std::mersenne_twister_engine` for `std::mt19937_64`.
+ */
+inline constexpr std::size_t MT_N = 312;
+inline constexpr std::size_t MT_M = 156;
+inline constexpr std::uint64_t MT_MATRIX = 0xB5026F5AA96619E9;
+inline constexpr std::uint64_t MT_UPPER_MASK = 0xFFFFFFFF80000000;
+inline constexpr std::uint64_t MT_LOWER_MASK = 0x000000007FFFFFFF;
+inline constexpr std::uint64_t MT_INIT_MULTIPLIER = 6364136223846793005;
+inline constexpr std::uint64_t MT_DEFAULT_SEED = 5489;
+
+/**
+ * Entry points of one MT19937_64Dispatch target. Each regenerates the `MT_N` words of `state` in place and writes
+ * their `MT_N` tempered outputs to `out`. `state` must be aligned to 64 bytes, the widest register dispatched to;
+ * `out` may have any alignment.
+ */
+struct MT19937_64SIMDTable {
+  using result_type = std::uint64_t;
+  void (*generate)(std::uint64_t *state, result_type *out) noexcept;
+  void (*generate_uniform)(std::uint64_t *state, double *out) noexcept;
+};
+
+/**
+ * MT19937-64 block regeneration with SIMD. The twist of word `i` reads words `i + 1` and `i + M` (modulo N), so a
+ * batch of consecutive words only depends on words that are either not updated yet or updated by an earlier batch,
+ * and only the words around the wrap-around are computed one at a time.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch> struct MT19937_64SIMDKernels {
+  using result_type = MT19937_64SIMDTable::result_type;
+  using simd_type = xsimd::batch<std::uint64_t, Arch>;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+  static_assert(MT_N % SIMD_WIDTH == 0 && MT_N - MT_M >= SIMD_WIDTH);
+
+  static void generate(std::uint64_t *state, result_type *out) noexcept {
+    twist(state);
+    for (auto i = std::size_t{0}; i < MT_N; i += SIMD_WIDTH) {
+      temper(simd_type::load_aligned(state + i)).store_unaligned(out + i);
+    }
+  }
+
+  static void generate_uniform(std::uint64_t *state, double *out) noexcept {
+    twist(state);
+    for (auto i = std::size_t{0}; i < MT_N; i += SIMD_WIDTH) {
+      to_uniform(temper(simd_type::load_aligned(state + i))).store_unaligned(out + i);
+    }
+  }
+
+  static constexpr MT19937_64SIMDTable table{&generate, &generate_uniform};
+
+private:
+  static PRNG_ALWAYS_INLINE std::uint64_t twist_word(const std::uint64_t current, const std::uint64_t next,
+                                                     const std::uint64_t shifted) noexcept {
+    const auto x = (current & MT_UPPER_MASK) | (next & MT_LOWER_MASK);
+    return shifted ^ (x >> 1) ^ ((x & 1) ? MT_MATRIX : 0);
+  }
+
+  /**
+   * Twists words `[begin, end)`, reading word `i + offset` as the shifted word of word `i`.
+   */
+  static PRNG_ALWAYS_INLINE void twist_range(std::uint64_t *state, std::size_t i, const std::size_t end,
+                                             const std::ptrdiff_t offset) noexcept {
+    const auto upper = simd_type::broadcast(MT_UPPER_MASK);
+    const auto lower = simd_type::broadcast(MT_LOWER_MASK);
+    const auto matrix = simd_type::broadcast(MT_MATRIX);
+    const auto one = simd_type::broadcast(1);
+    for (; i + SIMD_WIDTH <= end; i += SIMD_WIDTH) {
+      const auto current = simd_type::load_unaligned(state + i);
+      const auto x = (current & upper) | (simd_type::load_unaligned(state + i + 1) & lower);
+      // the matrix is applied where the low bit is set: 0 - 1 is all ones
+      const auto y = (x >> 1) ^ ((simd_type::broadcast(0) - (x & one)) & matrix);
+      (simd_type::load_unaligned(state + i + offset) ^ y).store_unaligned(state + i);
+    }
+    for (; i < end; ++i) {
+      state[i] = twist_word(state[i], state[i + 1], *(state + i + offset));
+    }
+  }
+
+  static PRNG_ALWAYS_INLINE void twist(std::uint64_t *state) noexcept {
+    // words [0, N - M) read the old words [M, N); words [N - M, N - 1) read the new words [0, M - 1)
+    constexpr auto shift = static_cast<std::ptrdiff_t>(MT_M);
+    twist_range(state, 0, MT_N - MT_M, shift);
+    twist_range(state, MT_N - MT_M, MT_N - 1, shift - static_cast<std::ptrdiff_t>(MT_N));
+    state[MT_N - 1] = twist_word(state[MT_N - 1], state[0], state[MT_M - 1]);
+  }
+
+  static PRNG_ALWAYS_INLINE simd_type temper(simd_type y) noexcept {
+    y ^= (y >> 29) & simd_type::broadcast(0x5555555555555555);
+    y ^= (y << 17) & simd_type::broadcast(0x71D67FFFEDA60000);
+    y ^= (y << 37) & simd_type::broadcast(0xFFF7EEE000000000);
+    return y ^ (y >> 43);
+  }
+};
+
+}
+
+/**
+ * Returns the MT19937_64Dispatch entry points of the best architecture the CPU supports, detected on the first call
+ * only.
+ * @return The dispatch table.
+ */
+const internal::MT19937_64SIMDTable &mt19937_64_simd_table() noexcept;
+
+namespace internal {
+
+/**
+ * Kernels of MT19937_64Dispatch, forwarding to the table selected at runtime.
+ */
+struct MT19937_64DispatchKernels {
+  using result_type = MT19937_64SIMDTable::result_type;
+
+  static PRNG_ALWAYS_INLINE void generate(std::uint64_t *state, result_type *out) noexcept {
+    mt19937_64_simd_table().generate(state, out);
+  }
+
+  static PRNG_ALWAYS_INLINE void generate_uniform(std::uint64_t *state, double *out) noexcept {
+    mt19937_64_simd_table().generate_uniform(state, out);
+  }
+};
+
+}
+
+/**
+ * @class BasicMT19937_64SIMD
+ * @brief 64-bit Mersenne Twister whose state block is regenerated with SIMD, stream-compatible with
+ * `std::mt19937_64`.
+ *
+ * For the same seed, operator(), fill() and discard() produce exactly the sequence of `std::mt19937_64`; uniform()
+ * and fill_uniform() convert it to doubles in [0, 1) from the top 53 bits. Each regeneration computes all 312 outputs
+ * into a cache, and fill() regenerates straight into the destination.
+ *
+ * @tparam Kernels Provides the `generate` and `generate_uniform` entry points.
+ */
+template <class Kernels> class BasicMT19937_64SIMD {
+public:
+  using result_type = std::uint64_t;
+  static constexpr auto STATE_SIZE = internal::MT_N;
+  static constexpr auto default_seed = internal::MT_DEFAULT_SEED;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator with the same state as `std::mt19937_64(value)`.
+   * @param value The seed.
+   */
+  explicit BasicMT19937_64SIMD(const result_type value = default_seed) noexcept { seed(value); }
+
+  /**
+   * @brief Reseeds the generator like `std::mt19937_64::seed(value)`.
+   * @param value The seed.
+   */
+  void seed(const result_type value) noexcept {
+    m_state[0] = value;
+    for (auto i = std::size_t{1}; i < STATE_SIZE; ++i) {
+      const auto previous = m_state[i - 1];
+      m_state[i] = internal::MT_INIT_MULTIPLIER * (previous ^ (previous >> 62)) + i;
+    }
+    m_index = STATE_SIZE;
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == STATE_SIZE) [[unlikely]] {
+      Kernels::generate(m_state.data(), m_cache.data());
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * blocks are generated straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+      [this]() noexcept { Kernels::generate(m_state.data(), m_cache.data()); },
+      [this](result_type *dst, const std::size_t count) noexcept {
+        const auto blocks = count / STATE_SIZE;
+        for (auto block = std::size_t{0}; block < blocks; ++block) {
+          Kernels::generate(m_state.data(), dst + block * STATE_SIZE);
+        }
+        return blocks * STATE_SIZE;
+      });
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+      [this]() noexcept { Kernels::generate(m_state.data(), m_cache.data()); },
+      [this](double *dst, const std::size_t count) noexcept {
+        const auto blocks = count / STATE_SIZE;
+        for (auto block = std::size_t{0}; block < blocks; ++block) {
+          Kernels::generate_uniform(m_state.data(), dst + block * STATE_SIZE);
+        }
+        return blocks * STATE_SIZE;
+      });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Skips `n` outputs, like `std::mt19937_64::discard(n)`.
+   * @param n The number of outputs to skip.
+   */
+  void discard(unsigned long long n) noexcept {
+    const auto available = static_cast<unsigned long long>(STATE_SIZE - m_index);
+    if (n <= available) {
+      m_index += static_cast<std::uint32_t>(n);
+      return;
+    }
+    n -= available;
+    // whole blocks only need the twist, but the kernels temper them as well
+    for (; n > STATE_SIZE; n -= STATE_SIZE) {
+      Kernels::generate(m_state.data(), m_cache.data());
+    }
+    Kernels::generate(m_state.data(), m_cache.data());
+    m_index = static_cast<std::uint32_t>(n);
+  }
+
+protected:
+  alignas(64) std::array<std::uint64_t, STATE_SIZE> m_state{};
+  alignas(64) std::array<result_type, STATE_SIZE> m_cache{};
+  std::uint32_t m_index{STATE_SIZE};
+};
+
+/**
+ * MT19937-64 on a fixed architecture.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch = xsimd::best_arch>
+using MT19937_64SIMD = BasicMT19937_64SIMD<internal::MT19937_64SIMDKernels<Arch>>;
+
+/**
+ * MT19937-64 selecting the SIMD implementation at runtime, like PhiloxDispatch.
+ */
+using MT19937_64Dispatch = BasicMT19937_64SIMD<internal::MT19937_64DispatchKernels>;
+
+static_assert(std::is_trivially_copyable_v<MT19937_64Dispatch>);
+
+namespace internal {
+
+/**
+ * Functor used by xsimd::dispatch to select the MT19937_64Dispatch entry points.
+ */
+struct MT19937_64SIMDTableCreator {
+  /**
+   * Operator that returns the MT19937_64Dispatch entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @return Pointer to the entry points.
+   */
+  template <class Arch> const MT19937_64SIMDTable *operator()(Arch) const noexcept;
+};
+
+template <class Arch> const MT19937_64SIMDTable *MT19937_64SIMDTableCreator::operator()(Arch) const noexcept {
+  return &MT19937_64SIMDKernels<Arch>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points for one architecture.
+#define PRNG_MT19937_64_SIMD_TABLES(PREFIX, ARCH)                                                                     \
+  PREFIX template const MT19937_64SIMDTable *MT19937_64SIMDTableCreator::operator()<ARCH>(ARCH) const noexcept;
+
+PRNG_MT19937_64_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_MT19937_64_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_MT19937_64_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_MT19937_64_SIMD_TABLES(extern, xsimd::avx512f)
+
+}
+
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "macros.hpp"
+#include "philox.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * 128-bit unsigned integer, least significant word first, used for the PCG64 state and increment.
+ */
+using pcg128 = std::array<std::uint64_t, 2>;
+
+/**
+ * The 64-bit "cheap multiplier" of the DXSM variant, used both by the state transition and by the output function.
+ */
+inline constexpr std::uint64_t PCG_CHEAP_MULTIPLIER = 0xDA942042E4DD58B5;
+
+/**
+ * The default 128-bit LCG multiplier of PCG64, which NumPy also uses when seeding PCG64DXSM.
+ */
+inline constexpr pcg128 PCG_DEFAULT_MULTIPLIER = {0x4385DF649FCCF645, 0x2360ED051FC65DA4};
+
+/**
+ * The step of NumPy's `jumped()`: 2^128 divided by the golden ratio.
+ */
+inline constexpr pcg128 PCG_JUMP = {0xF39CC0605CEDC835, 0x9E3779B97F4A7C15};
+
+/**
+ * Sum modulo 2^128.
+ */
+PRNG_ALWAYS_INLINE constexpr pcg128 pcg_add(const pcg128 &a, const pcg128 &b) noexcept {
+  const auto lo = a[0] + b[0];
+  return {lo, a[1] + b[1] + static_cast<std::uint64_t>(lo < a[0])};
+}
+
+/**
+ * Product modulo 2^128.
+ */
+PRNG_ALWAYS_INLINE constexpr pcg128 pcg_mul(const pcg128 &a, const pcg128 &b) noexcept {
+  std::uint64_t hi = 0;
+  const auto lo = mulhilo64(a[0], b[0], hi);
+  return {lo, hi + a[0] * b[1] + a[1] * b[0]};
+}
+
+/**
+ * The DXSM ("double xorshift multiply") output function, applied to the state before it is stepped.
+ */
+PRNG_ALWAYS_INLINE constexpr std::uint64_t pcg_dxsm(const pcg128 &state) noexcept {
+  auto hi = state[1];
+  hi ^= hi >> 32;
+  hi *= PCG_CHEAP_MULTIPLIER;
+  hi ^= hi >> 48;
+  return hi * (state[0] | 1);
+}
+
+/**
+ * One step of the DXSM variant: `state * PCG_CHEAP_MULTIPLIER + inc` modulo 2^128.
+ */
+PRNG_ALWAYS_INLINE constexpr pcg128 pcg_cm_step(const pcg128 &state, const pcg128 &inc) noexcept {
+  std::uint64_t hi = 0;
+  const auto lo = mulhilo64(state[0], PCG_CHEAP_MULTIPLIER, hi);
+  return pcg_add({lo, hi + state[1] * PCG_CHEAP_MULTIPLIER}, inc);
+}
+
+/**
+ * Applies `delta` steps of the LCG `state * mult + inc` in O(log delta) operations (Brown, "Random number generation
+ * with arbitrary strides").
+ */
+PRNG_ALWAYS_INLINE constexpr pcg128 pcg_advance(const pcg128 &state, pcg128 delta, pcg128 mult, pcg128 inc) noexcept {
+  pcg128 acc_mult{1, 0}, acc_plus{0, 0};
+  while ((delta[0] | delta[1]) != 0) {
+    if (delta[0] & 1) {
+      acc_mult = pcg_mul(acc_mult, mult);
+      acc_plus = pcg_add(pcg_mul(acc_plus, mult), inc);
+    }
+    inc = pcg_mul(pcg_add(mult, {1, 0}), inc);
+    mult = pcg_mul(mult, mult);
+    delta = {delta[0] >> 1 | delta[1] << 63, delta[1] >> 1};
+  }
+  return pcg_add(pcg_mul(acc_mult, state), acc_plus);
+}
+
+/**
+ * The state and increment NumPy's `pcg64_set_seed` derives from a 128-bit initial state and stream selector: the
+ * increment is `2 * initseq + 1` and the state is mixed with two steps of the default 128-bit LCG.
+ */
+PRNG_ALWAYS_INLINE constexpr std::array<pcg128, 2> pcg_seed(const pcg128 &initstate, const pcg128 &initseq) noexcept {
+  const pcg128 inc{initseq[0] << 1 | 1, initseq[1] << 1 | initseq[0] >> 63};
+  auto state = inc;
+  state = pcg_add(state, initstate);
+  state = pcg_add(pcg_mul(state, PCG_DEFAULT_MULTIPLIER), inc);
+  return {state, inc};
+}
+
+}
+
+/**
+ * @class PCG64DXSM
+ * @brief PCG64 with the DXSM output function and the 64-bit "cheap multiplier", stream-compatible with
+ * `numpy.random.PCG64DXSM`.
+ *
+ * The state is a 128-bit LCG, `state = state * 0xda942042e4dd58b5 + inc`, and each output is computed from the state
+ * before it is stepped. For a given state and increment the 64-bit outputs, the 32-bit outputs of next_uint32(),
+ * uniform() and the effect of advance() and jump() match NumPy exactly. The increment selects the stream and must be
+ * odd.
+ */
+class PCG64DXSM {
+public:
+  using result_type = std::uint64_t;
+  using state_type = internal::pcg128;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator from its raw state, like assigning `{"state": {"state": ..., "inc": ...}}` to
+   * NumPy's `bit_generator.state`.
+   * @param state The 128-bit state, least significant word first.
+   * @param inc The 128-bit odd increment, least significant word first.
+   */
+  PRNG_ALWAYS_INLINE constexpr PCG64DXSM(const state_type &state, const state_type &inc) noexcept
+      : m_state{state}, m_inc{inc} {}
+
+  /**
+   * @brief Constructs the generator the way `numpy.random.PCG64DXSM(seed)` does from the four words its
+   * SeedSequence generates: `initstate` is `words[0] << 64 | words[1]` and `initseq` is `words[2] << 64 | words[3]`.
+   * @param initstate The 128-bit initial state, least significant word first.
+   * @param initseq The 128-bit stream selector, least significant word first.
+   * @return The seeded generator.
+   */
+  static PRNG_ALWAYS_INLINE constexpr PCG64DXSM seeded(const state_type &initstate,
+                                                      const state_type &initseq) noexcept {
+    const auto [state, inc] = internal::pcg_seed(initstate, initseq);
+    return PCG64DXSM(state, inc);
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE constexpr result_type operator()() noexcept {
+    const auto result = internal::pcg_dxsm(m_state);
+    m_state = internal::pcg_cm_step(m_state, m_inc);
+    return result;
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr double uniform() noexcept {
+    return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * @brief Generates a 32-bit output the way NumPy does: the low half of a 64-bit output, then its high half.
+   * @return The next 32-bit output.
+   */
+  PRNG_ALWAYS_INLINE constexpr std::uint32_t next_uint32() noexcept {
+    if (m_has_uint32) {
+      m_has_uint32 = false;
+      return m_uinteger;
+    }
+    const auto next = operator()();
+    m_has_uint32 = true;
+    m_uinteger = static_cast<std::uint32_t>(next >> 32);
+    return static_cast<std::uint32_t>(next & 0xFFFFFFFF);
+  }
+
+  /**
+   * @brief Skips `delta` outputs modulo 2^128 in O(log delta) time and drops the buffered 32-bit half, like NumPy's
+   * `advance`.
+   * @param delta The 128-bit number of steps, least significant word first.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(const state_type &delta) noexcept {
+    m_state = internal::pcg_advance(m_state, delta, {internal::PCG_CHEAP_MULTIPLIER, 0}, m_inc);
+    m_has_uint32 = false;
+    m_uinteger = 0;
+  }
+
+  /**
+   * @brief Skips `delta` outputs.
+   * @param delta The number of steps.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(const std::uint64_t delta) noexcept { advance(state_type{delta, 0}); }
+
+  /**
+   * @brief Jumps ahead by 2^128 divided by the golden ratio steps, like NumPy's `jumped()`. Repeated jumps give
+   * non-overlapping streams.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump() noexcept { advance(internal::PCG_JUMP); }
+
+  /**
+   * @brief Returns the state, as reported in NumPy's state: the state the next output is computed from.
+   * @return The state.
+   */
+  PRNG_ALWAYS_INLINE constexpr state_type getState() const noexcept { return m_state; }
+
+  /**
+   * @brief Returns the increment.
+   * @return The increment.
+   */
+  PRNG_ALWAYS_INLINE constexpr state_type getIncrement() const noexcept { return m_inc; }
+
+private:
+  state_type m_state;
+  state_type m_inc;
+  std::uint32_t m_uinteger = 0;
+  bool m_has_uint32 = false;
+};
+
+}
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <xsimd/xsimd.hpp>
+
+#include "random/cache_fill.hpp"
+#include "random/macros.hpp"
+#include "random/pcg64.hpp"
+#include "random/simd_mul.hpp"
+#include "random/simd_uniform.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Number of independent PCG64DXSM streams of PCG64DXSMSIMD, fixed so that the output does not depend on the SIMD
+ * width: narrower architectures run several groups of lanes.
+ */
+inline constexpr std::size_t PCG64_SIMD_STREAMS = 8;
+
+/**
+ * States and increments of the streams, one array per 64-bit word so that each loads straight into batches.
+ */
+struct PCG64DXSMLanes {
+  alignas(64) std::array<std::uint64_t, PCG64_SIMD_STREAMS> state_lo;
+  alignas(64) std::array<std::uint64_t, PCG64_SIMD_STREAMS> state_hi;
+  alignas(64) std::array<std::uint64_t, PCG64_SIMD_STREAMS> inc_lo;
+  alignas(64) std::array<std::uint64_t, PCG64_SIMD_STREAMS> inc_hi;
+};
+
+/**
+ * Entry points of one PCG64DXSMDispatch target. Each writes `n` steps of all streams to `out`, stream `l` of step `s`
+ * at `out[s * PCG64_SIMD_STREAMS + l]`, and advances the states past them.
+ */
+struct PCG64DXSMSIMDTable {
+  using result_type = std::uint64_t;
+  void (*steps)(PCG64DXSMLanes *lanes, result_type *out, std::size_t n) noexcept;
+  void (*uniform_steps)(PCG64DXSMLanes *lanes, double *out, std::size_t n) noexcept;
+};
+
+/**
+ * PCG64DXSM over all streams at once, one stream per 64-bit lane. The 128-bit state is held as two batches and the
+ * 64x64 -> 128-bit products are assembled from 32x32 -> 64-bit lane multiplies.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch> struct PCG64DXSMSIMDKernels {
+  using result_type = PCG64DXSMSIMDTable::result_type;
+  using simd_type = xsimd::batch<std::uint64_t, Arch>;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+  static constexpr auto GROUPS = PCG64_SIMD_STREAMS / SIMD_WIDTH;
+  static_assert(PCG64_SIMD_STREAMS % SIMD_WIDTH == 0);
+
+  static void steps(PCG64DXSMLanes *lanes, result_type *out, const std::size_t n) noexcept {
+    generate(*lanes, n, [out](const simd_type &value, const std::size_t offset) noexcept {
+      value.store_unaligned(out + offset);
+    });
+  }
+
+  static void uniform_steps(PCG64DXSMLanes *lanes, double *out, const std::size_t n) noexcept {
+    generate(*lanes, n, [out](const simd_type &value, const std::size_t offset) noexcept {
+      to_uniform(value).store_unaligned(out + offset);
+    });
+  }
+
+  static constexpr PCG64DXSMSIMDTable table{&steps, &uniform_steps};
+
+private:
+  template <class Store>
+  static PRNG_ALWAYS_INLINE void generate(PCG64DXSMLanes &lanes, const std::size_t n, Store &&store) noexcept {
+    std::array<simd_type, GROUPS> state_lo, state_hi, inc_lo, inc_hi;
+    for (auto g = std::size_t{0}; g < GROUPS; ++g) {
+      state_lo[g] = simd_type::load_aligned(lanes.state_lo.data() + g * SIMD_WIDTH);
+      state_hi[g] = simd_type::load_aligned(lanes.state_hi.data() + g * SIMD_WIDTH);
+      inc_lo[g] = simd_type::load_aligned(lanes.inc_lo.data() + g * SIMD_WIDTH);
+      inc_hi[g] = simd_type::load_aligned(lanes.inc_hi.data() + g * SIMD_WIDTH);
+    }
+    const auto multiplier = simd_type::broadcast(PCG_CHEAP_MULTIPLIER);
+    for (auto step = std::size_t{0}; step < n; ++step) {
+      for (auto g = std::size_t{0}; g < GROUPS; ++g) {
+        // DXSM output of the current state
+        auto hi = state_hi[g] ^ (state_hi[g] >> 32);
+        hi = mullo64(hi, multiplier);
+        hi ^= hi >> 48;
+        store(mullo64(hi, state_lo[g] | simd_type::broadcast(1)), step * PCG64_SIMD_STREAMS + g * SIMD_WIDTH);
+
+        // state * PCG_CHEAP_MULTIPLIER + inc, with the carry of the low words computed from their top bits
+        simd_type product_hi;
+        const auto product_lo = mulhilo64(PCG_CHEAP_MULTIPLIER, state_lo[g], product_hi);
+        const auto sum_lo = product_lo + inc_lo[g];
+        const auto carry = ((product_lo & inc_lo[g]) | ((product_lo | inc_lo[g]) & ~sum_lo)) >> 63;
+        state_hi[g] = mullo64(state_hi[g], multiplier) + product_hi + inc_hi[g] + carry;
+        state_lo[g] = sum_lo;
+      }
+    }
+    for (auto g = std::size_t{0}; g < GROUPS; ++g) {
+      state_lo[g].store_aligned(lanes.state_lo.data() + g * SIMD_WIDTH);
+      state_hi[g].store_aligned(lanes.state_hi.data() + g * SIMD_WIDTH);
+    }
+  }
+};
+
+}
+
+/**
+ * Returns the PCG64DXSMDispatch entry points of the best architecture the CPU supports, detected on the first call
+ * only.
+ * @return The dispatch table.
+ */
+const internal::PCG64DXSMSIMDTable &pcg64_simd_table() noexcept;
+
+namespace internal {
+
+/**
+ * Kernels of PCG64DXSMDispatch, forwarding to the table selected at runtime.
+ */
+struct PCG64DXSMDispatchKernels {
+  using result_type = PCG64DXSMSIMDTable::result_type;
+
+  static PRNG_ALWAYS_INLINE void steps(PCG64DXSMLanes *lanes, result_type *out, const std::size_t n) noexcept {
+    pcg64_simd_table().steps(lanes, out, n);
+  }
+
+  static PRNG_ALWAYS_INLINE void uniform_steps(PCG64DXSMLanes *lanes, double *out, const std::size_t n) noexcept {
+    pcg64_simd_table().uniform_steps(lanes, out, n);
+  }
+};
+
+}
+
+/**
+ * @class BasicPCG64DXSMSIMD
+ * @brief Eight independent PCG64DXSM streams with distinct increments, computed together with SIMD kernels.
+ *
+ * The outputs are interleaved by step: the first eight outputs are the first output of streams 0 to 7, and so on.
+ * Stream `l` on its own is exactly the scalar PCG64DXSM with the state and increment of lane `l`, so each stream can be
+ * reproduced with PCG64DXSM or `numpy.random.PCG64DXSM`. The number of streams does not depend on the architecture.
+ *
+ * Use PCG64DXSMSIMD for a fixed architecture and PCG64DXSMDispatch to select it at runtime.
+ *
+ * @tparam Kernels Provides the `steps` and `uniform_steps` entry points.
+ */
+template <class Kernels> class BasicPCG64DXSMSIMD {
+public:
+  using result_type = std::uint64_t;
+  using state_type = PCG64DXSM::state_type;
+  static constexpr auto STREAMS = internal::PCG64_SIMD_STREAMS;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Seeds stream `l` like `PCG64DXSM::seeded(initstate, initseq + l)`, so every stream has its own increment.
+   * @param initstate The 128-bit initial state, least significant word first.
+   * @param initseq The 128-bit stream selector of stream 0, least significant word first.
+   */
+  explicit BasicPCG64DXSMSIMD(const state_type &initstate, const state_type &initseq = {}) noexcept {
+    for (auto lane = std::size_t{0}; lane < STREAMS; ++lane) {
+      const auto [state, inc] = internal::pcg_seed(initstate, internal::pcg_add(initseq, {lane, 0}));
+      set_lane(lane, state, inc);
+    }
+  }
+
+  /**
+   * @brief Constructs the streams from their raw states and increments.
+   * @param states The 128-bit state of each stream, least significant word first.
+   * @param incs The 128-bit odd increment of each stream, least significant word first.
+   */
+  BasicPCG64DXSMSIMD(const std::array<state_type, STREAMS> &states,
+                     const std::array<state_type, STREAMS> &incs) noexcept {
+    for (auto lane = std::size_t{0}; lane < STREAMS; ++lane) {
+      set_lane(lane, states[lane], incs[lane]);
+    }
+  }
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * steps are generated straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+      [this]() noexcept { populate_cache(); },
+      [this](result_type *dst, const std::size_t count) noexcept {
+        Kernels::steps(&m_lanes, dst, count / STREAMS);
+        return count - count % STREAMS;
+      });
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+      [this]() noexcept { populate_cache(); },
+      [this](double *dst, const std::size_t count) noexcept {
+        Kernels::uniform_steps(&m_lanes, dst, count / STREAMS);
+        return count - count % STREAMS;
+      });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Moves every stream `delta` steps past its current step in O(log delta) time. The rest of a partially
+   * consumed step is dropped, so the next output is stream 0 of the new step.
+   * @param delta The 128-bit number of steps, least significant word first.
+   */
+  void advance(const state_type &delta) noexcept {
+    // the stored states are `pending` steps ahead of the current one
+    const auto steps = internal::pcg_add(delta, negate(pending()));
+    for (auto lane = std::size_t{0}; lane < STREAMS; ++lane) {
+      set_lane(lane, internal::pcg_advance(lane_state(lane), steps, MULTIPLIER, getIncrement(lane)),
+               getIncrement(lane));
+    }
+    m_index = CACHE_SIZE;
+  }
+
+  /**
+   * @brief Moves every stream `delta` steps past its current step.
+   * @param delta The number of steps.
+   */
+  void advance(const std::uint64_t delta) noexcept { advance(state_type{delta, 0}); }
+
+  /**
+   * @brief Jumps every stream ahead like PCG64DXSM::jump().
+   */
+  void jump() noexcept { advance(internal::PCG_JUMP); }
+
+  /**
+   * @brief Returns the state of a stream at its current step: the step whose outputs are being handed out, or the
+   * next one at a step boundary.
+   * @param lane The stream.
+   * @return The state, as PCG64DXSM::getState() would report it.
+   */
+  state_type getState(const std::size_t lane) const noexcept {
+    // stepping back is stepping forward by the two's complement, modulo the 2^128 period
+    return internal::pcg_advance(lane_state(lane), negate(pending()), MULTIPLIER, getIncrement(lane));
+  }
+
+  /**
+   * @brief Returns the increment of a stream.
+   * @param lane The stream.
+   * @return The increment.
+   */
+  state_type getIncrement(const std::size_t lane) const noexcept {
+    return {m_lanes.inc_lo[lane], m_lanes.inc_hi[lane]};
+  }
+
+protected:
+  static constexpr state_type MULTIPLIER = {internal::PCG_CHEAP_MULTIPLIER, 0};
+  static constexpr auto CACHE_STEPS = std::size_t{32};
+  static constexpr auto CACHE_SIZE = CACHE_STEPS * STREAMS;
+
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept { Kernels::steps(&m_lanes, m_cache.data(), CACHE_STEPS); }
+
+  // cached steps not handed out completely, including the current one
+  PRNG_ALWAYS_INLINE std::uint64_t pending() const noexcept {
+    return (CACHE_SIZE - m_index + STREAMS - 1) / STREAMS;
+  }
+
+  static PRNG_ALWAYS_INLINE state_type negate(const std::uint64_t value) noexcept {
+    return value == 0 ? state_type{0, 0} : state_type{0 - value, ~std::uint64_t{0}};
+  }
+
+  PRNG_ALWAYS_INLINE state_type lane_state(const std::size_t lane) const noexcept {
+    return {m_lanes.state_lo[lane], m_lanes.state_hi[lane]};
+  }
+
+  PRNG_ALWAYS_INLINE void set_lane(const std::size_t lane, const state_type &state, const state_type &inc) noexcept {
+    m_lanes.state_lo[lane] = state[0];
+    m_lanes.state_hi[lane] = state[1];
+    m_lanes.inc_lo[lane] = inc[0];
+    m_lanes.inc_hi[lane] = inc[1];
+  }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  internal::PCG64DXSMLanes m_lanes{};
+  std::uint32_t m_index{CACHE_SIZE};
+};
+
+/**
+ * Eight PCG64DXSM streams on a fixed architecture.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch = xsimd::best_arch>
+using PCG64DXSMSIMD = BasicPCG64DXSMSIMD<internal::PCG64DXSMSIMDKernels<Arch>>;
+
+/**
+ * Eight PCG64DXSM streams selecting the SIMD implementation at runtime, like PhiloxDispatch.
+ */
+using PCG64DXSMDispatch = BasicPCG64DXSMSIMD<internal::PCG64DXSMDispatchKernels>;
+
+static_assert(std::is_trivially_copyable_v<PCG64DXSMDispatch>);
+
+namespace internal {
+
+/**
+ * Functor used by xsimd::dispatch to select the PCG64DXSMDispatch entry points.
+ */
+struct PCG64DXSMSIMDTableCreator {
+  /**
+   * Operator that returns the PCG64DXSMDispatch entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @return Pointer to the entry points.
+   */
+  template <class Arch> const PCG64DXSMSIMDTable *operator()(Arch) const noexcept;
+};
+
+template <class Arch> const PCG64DXSMSIMDTable *PCG64DXSMSIMDTableCreator::operator()(Arch) const noexcept {
+  return &PCG64DXSMSIMDKernels<Arch>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points for one architecture.
+#define PRNG_PCG64_SIMD_TABLES(PREFIX, ARCH)                                                                          \
+  PREFIX template const PCG64DXSMSIMDTable *PCG64DXSMSIMDTableCreator::operator()<ARCH>(ARCH) const noexcept;
+
+PRNG_PCG64_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_PCG64_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_PCG64_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_PCG64_SIMD_TABLES(extern, xsimd::avx512f)
+
+}
+
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Philox4x64 constants from Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (Random123): the round
+ * multipliers and the Weyl increments of the key schedule.
+ */
+inline constexpr std::uint64_t PHILOX_M0 = 0xD2E7470EE14C6C93;
+inline constexpr std::uint64_t PHILOX_M1 = 0xCA5A826395121157;
+inline constexpr std::uint64_t PHILOX_W0 = 0x9E3779B97F4A7C15;
+inline constexpr std::uint64_t PHILOX_W1 = 0xBB67AE8584CAA73B;
+inline constexpr int PHILOX_ROUNDS = 10;
+
+using philox_counter = std::array<std::uint64_t, 4>;
+using philox_key = std::array<std::uint64_t, 2>;
+
+/**
+ * Full 64x64 -> 128-bit product.
+ * @param a The first factor.
+ * @param b The second factor.
+ * @param hi Receives the high 64 bits.
+ * @return The low 64 bits.
+ */
+PRNG_ALWAYS_INLINE constexpr std::uint64_t mulhilo64(const std::uint64_t a, const std::uint64_t b,
+                                                     std::uint64_t &hi) noexcept {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(a) * b;
+  hi = static_cast<std::uint64_t>(product >> 64);
+  return static_cast<std::uint64_t>(product);
+#else
+  const auto a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+  const auto b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+  const auto p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+  const auto mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+  hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+  return (p0 & 0xFFFFFFFF) | (mid << 32);
+#endif
+}
+
+/**
+ * The Philox4x64 bijection: ten rounds of the counter under the key.
+ * @param counter The counter block.
+ * @param key The key.
+ * @return The output block.
+ */
+PRNG_ALWAYS_INLINE constexpr philox_counter philox4x64(philox_counter counter, philox_key key) noexcept {
+  for (auto round = 0; round < PHILOX_ROUNDS; ++round) {
+    if (round != 0) {
+      key[0] += PHILOX_W0;
+      key[1] += PHILOX_W1;
+    }
+    std::uint64_t hi0 = 0, hi1 = 0;
+    const auto lo0 = mulhilo64(PHILOX_M0, counter[0], hi0);
+    const auto lo1 = mulhilo64(PHILOX_M1, counter[2], hi1);
+    counter = {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+  }
+  return counter;
+}
+
+/**
+ * Increments a 256-bit counter, least significant word first.
+ */
+PRNG_ALWAYS_INLINE constexpr void philox_increment(philox_counter &counter) noexcept {
+  for (auto &word : counter) {
+    if (++word != 0) {
+      break;
+    }
+  }
+}
+
+/**
+ * Adds a 256-bit step to a 256-bit counter, both least significant word first, modulo 2^256.
+ */
+PRNG_ALWAYS_INLINE constexpr void philox_add(philox_counter &counter, const philox_counter &step) noexcept {
+  std::uint64_t carry = 0;
+  for (auto i = 0; i < 4; ++i) {
+    const auto sum = counter[i] + step[i];
+    const auto next_carry = static_cast<std::uint64_t>(sum < counter[i]);
+    counter[i] = sum + carry;
+    carry = next_carry | static_cast<std::uint64_t>(counter[i] < carry);
+  }
+}
+
+}
+
+/**
+ * @class Philox
+ * @brief Philox4x64-10 counter-based generator, stream-compatible with `numpy.random.Philox`.
+ *
+ * Like NumPy, the counter is incremented before each block is computed, so the first output is word 0 of
+ * `philox4x64(counter + 1, key)`. For a given key and counter the 64-bit outputs, the 32-bit outputs of next_uint32()
+ * and the effect of advance() and jump() match NumPy exactly.
+ */
+class Philox {
+public:
+  using result_type = std::uint64_t;
+  using counter_type = internal::philox_counter;
+  using key_type = internal::philox_key;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator from a key and a counter, like `numpy.random.Philox(key=..., counter=...)`.
+   * @param key The 128-bit key, least significant word first.
+   * @param counter The 256-bit counter, least significant word first.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit Philox(const key_type &key, const counter_type &counter = {}) noexcept
+      : m_counter{counter}, m_key{key} {}
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE constexpr result_type operator()() noexcept {
+    if (m_buffer_pos == m_buffer.size()) [[unlikely]] {
+      internal::philox_increment(m_counter);
+      m_buffer = internal::philox4x64(m_counter, m_key);
+      m_buffer_pos = 0;
+    }
+    return m_buffer[m_buffer_pos++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr double uniform() noexcept {
+    return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * @brief Generates a 32-bit output the way NumPy does: the low half of a 64-bit output, then its high half.
+   * @return The next 32-bit output.
+   */
+  PRNG_ALWAYS_INLINE constexpr std::uint32_t next_uint32() noexcept {
+    if (m_has_uint32) {
+      m_has_uint32 = false;
+      return m_uinteger;
+    }
+    const auto next = operator()();
+    m_has_uint32 = true;
+    m_uinteger = static_cast<std::uint32_t>(next >> 32);
+    return static_cast<std::uint32_t>(next & 0xFFFFFFFF);
+  }
+
+  /**
+   * @brief Adds `step` to the counter in constant time and drops the buffered outputs, like NumPy's `advance`.
+   * @param step The 256-bit step, least significant word first.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(const counter_type &step) noexcept {
+    internal::philox_add(m_counter, step);
+    reset();
+  }
+
+  /**
+   * @brief Adds `delta` to the counter, i.e. skips `delta` blocks of four outputs.
+   * @param delta The number of blocks to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(const std::uint64_t delta) noexcept { advance(counter_type{delta}); }
+
+  /**
+   * @brief Jumps ahead by 2^128 blocks, like NumPy's `jumped()`. Repeated jumps give non-overlapping streams.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump() noexcept { advance(counter_type{0, 0, 1, 0}); }
+
+  /**
+   * @brief Returns the counter, as reported in NumPy's state: the counter of the last block generated.
+   * @return The counter.
+   */
+  PRNG_ALWAYS_INLINE constexpr counter_type getCounter() const noexcept { return m_counter; }
+
+  /**
+   * @brief Returns the key.
+   * @return The key.
+   */
+  PRNG_ALWAYS_INLINE constexpr key_type getKey() const noexcept { return m_key; }
+
+private:
+  counter_type m_counter;
+  key_type m_key;
+  counter_type m_buffer{};
+  std::uint32_t m_buffer_pos = 4;
+  std::uint32_t m_uinteger = 0;
+  bool m_has_uint32 = false;
+
+  PRNG_ALWAYS_INLINE constexpr void reset() noexcept {
+    m_buffer_pos = static_cast<std::uint32_t>(m_buffer.size());
+    m_has_uint32 = false;
+    m_uinteger = 0;
+  }
+};
+
+}
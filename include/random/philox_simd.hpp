@@ -0,0 +1,409 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <xsimd/xsimd.hpp>
+
+#include "random/cache_fill.hpp"
+#include "random/macros.hpp"
+#include "random/philox.hpp"
+#include "random/simd_mul.hpp"
+#include "random/simd_uniform.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Entry points of one PhiloxDispatch target. `counter` points to the four words of the counter of the last block
+ * generated and `key` to the two words of the key; `n` blocks with the following counters are written to `out` and
+ * the counter is advanced past them.
+ */
+struct PhiloxSIMDTable {
+  using result_type = std::uint64_t;
+  void (*blocks)(std::uint64_t *counter, const std::uint64_t *key, result_type *out, std::size_t n) noexcept;
+  void (*uniform_blocks)(std::uint64_t *counter, const std::uint64_t *key, double *out, std::size_t n) noexcept;
+};
+
+/**
+ * Philox4x64-10 over SIMD-width consecutive counters at once, one block per 64-bit lane.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch> struct PhiloxSIMDKernels {
+  using result_type = PhiloxSIMDTable::result_type;
+  using simd_type = xsimd::batch<std::uint64_t, Arch>;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+  static constexpr auto BLOCK_RESULTS = std::size_t{4};
+  static constexpr auto BATCH_RESULTS = SIMD_WIDTH * BLOCK_RESULTS;
+
+  /**
+   * Generates `n` blocks as 64-bit outputs in operator() order.
+   */
+  static void blocks(std::uint64_t *counter, const std::uint64_t *key, result_type *out, std::size_t n) noexcept {
+    philox_counter ctr;
+    std::memcpy(ctr.data(), counter, sizeof(ctr));
+    const auto round_keys = key_schedule(key);
+    for (; n >= SIMD_WIDTH; n -= SIMD_WIDTH, out += BATCH_RESULTS) {
+      gen_batch(ctr, round_keys, out);
+      philox_add(ctr, {SIMD_WIDTH});
+    }
+    if (n != 0) {
+      // the last batch is computed whole, but the counter only moves past the blocks that are used
+      alignas(Arch::alignment()) std::array<result_type, BATCH_RESULTS> results;
+      gen_batch(ctr, round_keys, results.data());
+      std::memcpy(out, results.data(), n * BLOCK_RESULTS * sizeof(result_type));
+      philox_add(ctr, {n});
+    }
+    std::memcpy(counter, ctr.data(), sizeof(ctr));
+  }
+
+  /**
+   * Generates `n` blocks as uniform doubles in [0, 1), converted in registers.
+   */
+  static void uniform_blocks(std::uint64_t *counter, const std::uint64_t *key, double *out, std::size_t n) noexcept {
+    philox_counter ctr;
+    std::memcpy(ctr.data(), counter, sizeof(ctr));
+    const auto round_keys = key_schedule(key);
+    alignas(Arch::alignment()) std::array<result_type, BATCH_RESULTS> results;
+    alignas(Arch::alignment()) std::array<double, BATCH_RESULTS> uniforms;
+    while (n != 0) {
+      const auto count = n < SIMD_WIDTH ? n : SIMD_WIDTH;
+      // a partial batch may end inside a register, so it goes through a buffer
+      auto *const dst = count == SIMD_WIDTH ? out : uniforms.data();
+      gen_batch(ctr, round_keys, results.data());
+      for (auto i = std::size_t{0}; i < BATCH_RESULTS; i += SIMD_WIDTH) {
+        to_uniform(simd_type::load_aligned(results.data() + i)).store_unaligned(dst + i);
+      }
+      if (dst != out) {
+        std::memcpy(out, uniforms.data(), count * BLOCK_RESULTS * sizeof(double));
+      }
+      philox_add(ctr, {count});
+      out += count * BLOCK_RESULTS;
+      n -= count;
+    }
+    std::memcpy(counter, ctr.data(), sizeof(ctr));
+  }
+
+  static constexpr PhiloxSIMDTable table{&blocks, &uniform_blocks};
+
+private:
+  using round_keys_type = std::array<philox_key, PHILOX_ROUNDS>;
+
+  static PRNG_ALWAYS_INLINE round_keys_type key_schedule(const std::uint64_t *key) noexcept {
+    round_keys_type round_keys;
+    round_keys[0] = {key[0], key[1]};
+    for (auto round = 1; round < PHILOX_ROUNDS; ++round) {
+      round_keys[round] = {round_keys[round - 1][0] + PHILOX_W0, round_keys[round - 1][1] + PHILOX_W1};
+    }
+    return round_keys;
+  }
+
+  /**
+   * Computes the blocks `ctr + 1` to `ctr + SIMD_WIDTH` and stores them one after the other.
+   */
+  static PRNG_ALWAYS_INLINE void gen_batch(const philox_counter &ctr, const round_keys_type &round_keys,
+                                           result_type *out) noexcept {
+    std::array<simd_type, 4> x;
+    if (ctr[0] <= (std::numeric_limits<std::uint64_t>::max)() - SIMD_WIDTH) [[likely]] {
+      alignas(Arch::alignment()) std::array<std::uint64_t, SIMD_WIDTH> low;
+      for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+        low[lane] = ctr[0] + lane + 1;
+      }
+      x[0] = simd_type::load_aligned(low.data());
+      for (auto word = std::size_t{1}; word < 4; ++word) {
+        x[word] = simd_type::broadcast(ctr[word]);
+      }
+    } else {
+      // the low word wraps within this batch, so the carry is propagated lane by lane
+      alignas(Arch::alignment()) std::array<std::array<std::uint64_t, SIMD_WIDTH>, 4> words;
+      auto lane_ctr = ctr;
+      for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+        philox_increment(lane_ctr);
+        for (auto word = std::size_t{0}; word < 4; ++word) {
+          words[word][lane] = lane_ctr[word];
+        }
+      }
+      for (auto word = std::size_t{0}; word < 4; ++word) {
+        x[word] = simd_type::load_aligned(words[word].data());
+      }
+    }
+
+    for (const auto &key : round_keys) {
+      simd_type hi0, hi1;
+      const auto lo0 = mulhilo64(PHILOX_M0, x[0], hi0);
+      const auto lo1 = mulhilo64(PHILOX_M1, x[2], hi1);
+      x = {hi1 ^ x[1] ^ simd_type::broadcast(key[0]), lo1, hi0 ^ x[3] ^ simd_type::broadcast(key[1]), lo0};
+    }
+
+    if constexpr (SIMD_WIDTH == 4) {
+      // a 4x4 transpose turns the word batches into block batches
+      xsimd::transpose(x.data(), x.data() + 4);
+      for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+        x[lane].store_unaligned(out + lane * BLOCK_RESULTS);
+      }
+    } else {
+      alignas(Arch::alignment()) std::array<std::array<std::uint64_t, SIMD_WIDTH>, 4> words;
+      for (auto word = std::size_t{0}; word < 4; ++word) {
+        x[word].store_aligned(words[word].data());
+      }
+      for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+        for (auto word = std::size_t{0}; word < 4; ++word) {
+          out[lane * BLOCK_RESULTS + word] = words[word][lane];
+        }
+      }
+    }
+  }
+};
+
+}
+
+/**
+ * Returns the PhiloxDispatch entry points of the best architecture the CPU supports, detected on the first call only.
+ * @return The dispatch table.
+ */
+const internal::PhiloxSIMDTable &philox_simd_table() noexcept;
+
+namespace internal {
+
+/**
+ * Kernels of PhiloxDispatch, forwarding to the table selected at runtime.
+ */
+struct PhiloxDispatchKernels {
+  using result_type = PhiloxSIMDTable::result_type;
+
+  static PRNG_ALWAYS_INLINE void blocks(std::uint64_t *counter, const std::uint64_t *key, result_type *out,
+                                        const std::size_t n) noexcept {
+    philox_simd_table().blocks(counter, key, out, n);
+  }
+
+  static PRNG_ALWAYS_INLINE void uniform_blocks(std::uint64_t *counter, const std::uint64_t *key, double *out,
+                                                const std::size_t n) noexcept {
+    philox_simd_table().uniform_blocks(counter, key, out, n);
+  }
+};
+
+}
+
+/**
+ * @class BasicPhiloxSIMD
+ * @brief Philox4x64-10 generator computing a cache of blocks with SIMD kernels, stream-compatible with Philox and
+ * therefore with `numpy.random.Philox`.
+ *
+ * Use PhiloxSIMD for a fixed architecture and PhiloxDispatch to select it at runtime. Every output, including
+ * next_uint32(), advance(), jump() and the counter reported by getCounter(), matches the scalar Philox.
+ *
+ * @tparam Kernels Provides the `blocks` and `uniform_blocks` entry points.
+ */
+template <class Kernels> class BasicPhiloxSIMD {
+public:
+  using result_type = std::uint64_t;
+  using counter_type = Philox::counter_type;
+  using key_type = Philox::key_type;
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator from a key and a counter, like `numpy.random.Philox(key=..., counter=...)`.
+   * @param key The 128-bit key, least significant word first.
+   * @param counter The 256-bit counter, least significant word first.
+   */
+  explicit BasicPhiloxSIMD(const key_type &key, const counter_type &counter = {}) noexcept
+      : m_counter{counter}, m_key{key} {}
+
+  /**
+   * @brief Generates the next 64-bit output.
+   * @return The next 64-bit output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Generates a 32-bit output the way NumPy does: the low half of a 64-bit output, then its high half.
+   * @return The next 32-bit output.
+   */
+  PRNG_ALWAYS_INLINE std::uint32_t next_uint32() noexcept {
+    if (m_has_uint32) {
+      m_has_uint32 = false;
+      return m_uinteger;
+    }
+    const auto next = operator()();
+    m_has_uint32 = true;
+    m_uinteger = static_cast<std::uint32_t>(next >> 32);
+    return static_cast<std::uint32_t>(next & 0xFFFFFFFF);
+  }
+
+  /**
+   * @brief Fills a buffer with 64-bit outputs. The output is identical to calling operator() `n` times, but whole
+   * blocks are generated straight into the buffer.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+      [this]() noexcept { populate_cache(); },
+      [this](result_type *dst, const std::size_t count) noexcept {
+        Kernels::blocks(m_counter.data(), m_key.data(), dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+  /**
+   * @brief Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling
+   * uniform() `n` times.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+      m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+      [this]() noexcept { populate_cache(); },
+      [this](double *dst, const std::size_t count) noexcept {
+        Kernels::uniform_blocks(m_counter.data(), m_key.data(), dst, count / BLOCK_RESULTS);
+        return count - count % BLOCK_RESULTS;
+      });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with 64-bit outputs.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Adds `step` to the counter in constant time and drops the buffered outputs, like NumPy's `advance`.
+   * @param step The 256-bit step, least significant word first.
+   */
+  PRNG_ALWAYS_INLINE void advance(const counter_type &step) noexcept {
+    m_counter = getCounter();
+    internal::philox_add(m_counter, step);
+    m_index = CACHE_SIZE;
+    m_has_uint32 = false;
+    m_uinteger = 0;
+  }
+
+  /**
+   * @brief Adds `delta` to the counter, i.e. skips `delta` blocks of four outputs.
+   * @param delta The number of blocks to skip.
+   */
+  PRNG_ALWAYS_INLINE void advance(const std::uint64_t delta) noexcept { advance(counter_type{delta}); }
+
+  /**
+   * @brief Jumps ahead by 2^128 blocks, like NumPy's `jumped()`. Repeated jumps give non-overlapping streams.
+   */
+  PRNG_ALWAYS_INLINE void jump() noexcept { advance(counter_type{0, 0, 1, 0}); }
+
+  /**
+   * @brief Returns the counter as the scalar Philox reports it: the counter of the block currently being consumed.
+   * @return The counter.
+   */
+  PRNG_ALWAYS_INLINE counter_type getCounter() const noexcept {
+    auto counter = m_counter;
+    // cached blocks whose first output has not been handed out yet
+    const auto pending = static_cast<std::uint64_t>((CACHE_SIZE - m_index) / BLOCK_RESULTS);
+    if (pending != 0) {
+      // adding the 256-bit two's complement subtracts
+      constexpr auto ones = ~std::uint64_t{0};
+      internal::philox_add(counter, {0 - pending, ones, ones, ones});
+    }
+    return counter;
+  }
+
+  /**
+   * @brief Returns the key.
+   * @return The key.
+   */
+  PRNG_ALWAYS_INLINE key_type getKey() const noexcept { return m_key; }
+
+protected:
+  static constexpr auto BLOCK_RESULTS = std::size_t{4};
+  // one AVX-512 batch is 8 blocks
+  static constexpr auto CACHE_BLOCKCOUNT = std::size_t{16};
+  static constexpr auto CACHE_SIZE = CACHE_BLOCKCOUNT * BLOCK_RESULTS;
+
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept {
+    Kernels::blocks(m_counter.data(), m_key.data(), m_cache.data(), CACHE_BLOCKCOUNT);
+  }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  // counter of the last cached block
+  counter_type m_counter;
+  key_type m_key;
+  std::uint32_t m_index{CACHE_SIZE};
+  std::uint32_t m_uinteger{0};
+  bool m_has_uint32{false};
+};
+
+/**
+ * Philox4x64-10 on a fixed architecture.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch = xsimd::best_arch> using PhiloxSIMD = BasicPhiloxSIMD<internal::PhiloxSIMDKernels<Arch>>;
+
+/**
+ * Philox4x64-10 selecting the SIMD implementation at runtime, like ChaChaDispatch.
+ */
+using PhiloxDispatch = BasicPhiloxSIMD<internal::PhiloxDispatchKernels>;
+
+static_assert(std::is_trivially_copyable_v<PhiloxDispatch>);
+
+namespace internal {
+
+/**
+ * Functor used by xsimd::dispatch to select the PhiloxDispatch entry points.
+ */
+struct PhiloxSIMDTableCreator {
+  /**
+   * Operator that returns the PhiloxDispatch entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @return Pointer to the entry points.
+   */
+  template <class Arch> const PhiloxSIMDTable *operator()(Arch) const noexcept;
+};
+
+template <class Arch> const PhiloxSIMDTable *PhiloxSIMDTableCreator::operator()(Arch) const noexcept {
+  return &PhiloxSIMDKernels<Arch>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points for one architecture.
+#define PRNG_PHILOX_SIMD_TABLES(PREFIX, ARCH)                                                                         \
+  PREFIX template const PhiloxSIMDTable *PhiloxSIMDTableCreator::operator()<ARCH>(ARCH) const noexcept;
+
+PRNG_PHILOX_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_PHILOX_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_PHILOX_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_PHILOX_SIMD_TABLES(extern, xsimd::avx512f)
+
+}
+
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <xsimd/xsimd.hpp>
+
+#include "random/macros.hpp"
+
+namespace prng {
+
+/**
+ * @class SeedSequence
+ * @brief Entropy pool compatible with `numpy.random.SeedSequence`, with cheap hierarchical spawning.
+ *
+ * The entropy and the spawn key are hashed into a pool of four 32-bit words exactly as NumPy does, so the same
+ * entropy and spawn key give the same generate_state() words as NumPy's `generate_state`. Integers are split into
+ * 32-bit words least significant first, as NumPy splits Python integers: values below 2^32 take one word and larger
+ * ones two.
+ *
+ * Only the pool is stored, not the entropy: NumPy mixes the spawn key into the pool one word after the other, so a
+ * child is its parent's pool with its index mixed in, eight multiplications, and spawning a million children costs
+ * milliseconds instead of millions of jumps. Children can spawn in turn, giving a tree of independent seeds
+ * (jobs, then tasks, then subtasks) whatever its depth.
+ *
+ * Engines are seeded from the generated words: XoshiroScalar, XoshiroNative and XoshiroSIMD take the four 64-bit
+ * words of `generate_state<std::uint64_t, 4>()` as their initial state, and ChaCha and its SIMD variants the eight
+ * 32-bit words of `generate_state<std::uint32_t, 8>()` as their key. generate() makes it a standard seed sequence,
+ * e.g. for `std::mt19937_64`.
+ */
+class SeedSequence {
+public:
+  using result_type = std::uint32_t;
+  static constexpr auto POOL_SIZE = std::size_t{4};
+
+  /**
+   * @brief Constructs the pool like `numpy.random.SeedSequence(entropy)`.
+   * @param entropy The entropy.
+   */
+  explicit SeedSequence(const std::uint64_t entropy) noexcept : SeedSequence(&entropy, 1) {}
+
+  /**
+   * @brief Constructs the pool like `numpy.random.SeedSequence(entropy, spawn_key=spawn_key)`.
+   * @param entropy Pointer to the entropy integers.
+   * @param n The number of entropy integers.
+   * @param spawn_key Pointer to the spawn key, the path of child indices from the root.
+   * @param key_size The length of the spawn key.
+   */
+  SeedSequence(const std::uint64_t *entropy, const std::size_t n, const std::uint64_t *spawn_key = nullptr,
+               const std::size_t key_size = 0) noexcept {
+    auto words = std::size_t{0};
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      mix_integer(entropy[i], words);
+    }
+    // short entropy is padded with zeros, before the spawn key if there is one
+    while (words < POOL_SIZE) {
+      mix_word(0, words);
+    }
+    for (auto i = std::size_t{0}; i < key_size; ++i) {
+      mix_integer(spawn_key[i], words);
+    }
+  }
+
+  /**
+   * @brief Constructs the pool like `numpy.random.SeedSequence(entropy, spawn_key=spawn_key)`.
+   * @param entropy The entropy integers.
+   * @param spawn_key The spawn key, the path of child indices from the root.
+   */
+  SeedSequence(const std::initializer_list<std::uint64_t> entropy,
+               const std::initializer_list<std::uint64_t> spawn_key = {}) noexcept
+      : SeedSequence(entropy.begin(), entropy.size(), spawn_key.begin(), spawn_key.size()) {}
+
+  /**
+   * @brief Fills a buffer with words derived from the pool, like NumPy's `generate_state(n, dtype)`. 64-bit words are
+   * pairs of 32-bit words, the first one in the low half. Each word only depends on its position, so SIMD-width runs
+   * of words are hashed at once.
+   * @tparam T `std::uint32_t` or `std::uint64_t`.
+   * @tparam Arch The architecture type for SIMD operations.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of words to generate.
+   */
+  template <class T, class Arch = xsimd::best_arch> void generate_state(T *out, const std::size_t n) const noexcept {
+    static_assert(std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>,
+                  "SeedSequence generates 32-bit or 64-bit words");
+    using simd_type = xsimd::batch<result_type, Arch>;
+    constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+    constexpr auto WORDS = sizeof(T) / sizeof(result_type);
+    static_assert(SIMD_WIDTH % POOL_SIZE == 0);
+
+    // word i hashes pool[i % 4] with INIT_B * MULT_B^i and INIT_B * MULT_B^(i + 1)
+    alignas(Arch::alignment()) std::array<result_type, SIMD_WIDTH> pools{}, hashes{};
+    auto hash = INIT_B, stride = result_type{1};
+    for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+      pools[lane] = m_pool[lane % POOL_SIZE];
+      hashes[lane] = hash;
+      hash *= MULT_B;
+      stride *= MULT_B;
+    }
+    const auto pool = simd_type::load_aligned(pools.data());
+    const auto mult = simd_type::broadcast(MULT_B);
+    const auto step = simd_type::broadcast(stride);
+    auto hash_batch = simd_type::load_aligned(hashes.data());
+    hash = INIT_B;
+    auto i = std::size_t{0};
+    for (; i + SIMD_WIDTH / WORDS <= n; i += SIMD_WIDTH / WORDS) {
+      auto value = (pool ^ hash_batch) * (hash_batch * mult);
+      value ^= value >> XSHIFT;
+      if constexpr (WORDS == 1) {
+        value.store_unaligned(out + i);
+      } else {
+        xsimd::bitwise_cast<T>(value).store_unaligned(out + i);
+      }
+      hash_batch *= step;
+      hash *= stride;
+    }
+    for (; i < n; ++i) {
+      auto value = T{0};
+      for (auto word = std::size_t{0}; word < WORDS; ++word) {
+        auto data = m_pool[(i * WORDS + word) % POOL_SIZE] ^ hash;
+        hash *= MULT_B;
+        data *= hash;
+        value |= static_cast<T>(data ^ (data >> XSHIFT)) << (32 * word);
+      }
+      out[i] = value;
+    }
+  }
+
+  /**
+   * @brief Returns `N` words derived from the pool, like NumPy's `generate_state(N, dtype)`.
+   * @tparam T `std::uint32_t` or `std::uint64_t`.
+   * @tparam N The number of words.
+   * @return The words.
+   */
+  template <class T, std::size_t N> std::array<T, N> generate_state() const noexcept {
+    std::array<T, N> state{};
+    generate_state(state.data(), N);
+    return state;
+  }
+
+  /**
+   * @brief Fills a range with 32-bit words, the interface of a standard seed sequence.
+   * @param first The beginning of the range.
+   * @param last The end of the range.
+   */
+  template <class It> void generate(It first, const It last) const {
+    using value_type = typename std::iterator_traits<It>::value_type;
+    std::vector<result_type> words(static_cast<std::size_t>(std::distance(first, last)));
+    generate_state(words.data(), words.size());
+    for (const auto word : words) {
+      *first++ = static_cast<value_type>(word);
+    }
+  }
+
+  /**
+   * @brief Spawns the next `n` children, like NumPy's `spawn(n)`: child `k` has this sequence's spawn key extended
+   * with `children_spawned() + k`.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of children.
+   */
+  void spawn(SeedSequence *out, const std::size_t n) noexcept {
+    // every child mixes its index with the same hashmix constants, so only the index-dependent part is left per child
+    auto first = *this;
+    first.m_children_spawned = 0;
+    std::array<result_type, POOL_SIZE> keys{}, mults{}, bases{};
+    for (auto dst = std::size_t{0}; dst < POOL_SIZE; ++dst) {
+      keys[dst] = first.m_hash;
+      first.m_hash *= MULT_A;
+      mults[dst] = first.m_hash;
+      bases[dst] = MIX_MULT_L * m_pool[dst];
+    }
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      const auto index = m_children_spawned++;
+      if (index >> 32 != 0) [[unlikely]] {
+        out[i] = child(index);
+        continue;
+      }
+      out[i] = first;
+      for (auto dst = std::size_t{0}; dst < POOL_SIZE; ++dst) {
+        auto value = (static_cast<result_type>(index) ^ keys[dst]) * mults[dst];
+        value ^= value >> XSHIFT;
+        const result_type mixed = bases[dst] - MIX_MULT_R * value;
+        out[i].m_pool[dst] = mixed ^ (mixed >> XSHIFT);
+      }
+    }
+  }
+
+  /**
+   * @brief Spawns the next `n` children, like NumPy's `spawn(n)`.
+   * @param n The number of children.
+   * @return The children.
+   */
+  std::vector<SeedSequence> spawn(const std::size_t n) {
+    std::vector<SeedSequence> children(n, *this);
+    spawn(children.data(), n);
+    return children;
+  }
+
+  /**
+   * @brief Returns the number of children spawned so far, the index of the next one.
+   * @return The number of children spawned.
+   */
+  PRNG_ALWAYS_INLINE std::uint64_t children_spawned() const noexcept { return m_children_spawned; }
+
+  /**
+   * @brief Returns the pool, as reported by NumPy's `pool` attribute.
+   * @return The pool.
+   */
+  PRNG_ALWAYS_INLINE const std::array<result_type, POOL_SIZE> &pool() const noexcept { return m_pool; }
+
+private:
+  // hashing constants of numpy/random/bit_generator.pyx
+  static constexpr result_type INIT_A = 0x43b0d7e5;
+  static constexpr result_type MULT_A = 0x931e8875;
+  static constexpr result_type INIT_B = 0x8b51f9dd;
+  static constexpr result_type MULT_B = 0x58f38ded;
+  static constexpr result_type MIX_MULT_L = 0xca01f9dd;
+  static constexpr result_type MIX_MULT_R = 0x4973f715;
+  static constexpr auto XSHIFT = 16;
+
+  std::array<result_type, POOL_SIZE> m_pool{};
+  // the running constant of hashmix, carried over so that children continue the mixing of their parent
+  result_type m_hash = INIT_A;
+  std::uint64_t m_children_spawned = 0;
+
+  PRNG_ALWAYS_INLINE result_type hashmix(result_type value) noexcept {
+    value ^= m_hash;
+    m_hash *= MULT_A;
+    value *= m_hash;
+    return value ^ (value >> XSHIFT);
+  }
+
+  static PRNG_ALWAYS_INLINE result_type mix(const result_type x, const result_type y) noexcept {
+    const result_type result = MIX_MULT_L * x - MIX_MULT_R * y;
+    return result ^ (result >> XSHIFT);
+  }
+
+  /**
+   * Mixes the `words`-th entropy word in: the first four fill the pool and are then mixed with each other, every
+   * later one is mixed into each pool word.
+   */
+  PRNG_ALWAYS_INLINE void mix_word(const result_type word, std::size_t &words) noexcept {
+    if (words < POOL_SIZE) {
+      m_pool[words] = hashmix(word);
+      if (++words == POOL_SIZE) {
+        for (auto src = std::size_t{0}; src < POOL_SIZE; ++src) {
+          for (auto dst = std::size_t{0}; dst < POOL_SIZE; ++dst) {
+            if (src != dst) {
+              m_pool[dst] = mix(m_pool[dst], hashmix(m_pool[src]));
+            }
+          }
+        }
+      }
+      return;
+    }
+    ++words;
+    for (auto &dst : m_pool) {
+      dst = mix(dst, hashmix(word));
+    }
+  }
+
+  PRNG_ALWAYS_INLINE void mix_integer(const std::uint64_t value, std::size_t &words) noexcept {
+    mix_word(static_cast<result_type>(value), words);
+    if (value >> 32 != 0) {
+      mix_word(static_cast<result_type>(value >> 32), words);
+    }
+  }
+
+  PRNG_ALWAYS_INLINE SeedSequence child(const std::uint64_t index) const noexcept {
+    auto result = *this;
+    result.m_children_spawned = 0;
+    // the pool is full, so the index words are mixed into every pool word
+    auto words = POOL_SIZE;
+    result.mix_integer(index, words);
+    return result;
+  }
+};
+
+}
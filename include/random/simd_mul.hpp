@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <xsimd/xsimd.hpp>
+
+#include "random/macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Full 32x32 -> 64-bit products of the low halves of each 64-bit lane, the `mul_epu32` instruction on x86. Other
+ * architectures mask the operands and use the 64-bit lane multiply.
+ */
+template <class Arch>
+PRNG_ALWAYS_INLINE xsimd::batch<std::uint64_t, Arch> mul_low32(const xsimd::batch<std::uint64_t, Arch> &a,
+                                                               const xsimd::batch<std::uint64_t, Arch> &b) noexcept {
+  using batch_type = xsimd::batch<std::uint64_t, Arch>;
+#if XSIMD_WITH_AVX512F
+  if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+    return batch_type(_mm512_mul_epu32(a, b));
+  } else
+#endif
+#if XSIMD_WITH_AVX2
+  if constexpr (std::is_base_of_v<xsimd::avx2, Arch>) {
+    return batch_type(_mm256_mul_epu32(a, b));
+  } else
+#endif
+#if XSIMD_WITH_SSE2
+  if constexpr (std::is_base_of_v<xsimd::sse2, Arch> && !std::is_base_of_v<xsimd::avx, Arch>) {
+    return batch_type(_mm_mul_epu32(a, b));
+  } else
+#endif
+  {
+    const auto mask = batch_type::broadcast(0xFFFFFFFF);
+    return (a & mask) * (b & mask);
+  }
+}
+
+/**
+ * Lane-wise 64x64 -> 128-bit product of a constant and a batch, assembled from four 32x32 -> 64-bit products.
+ * @param m The constant factor.
+ * @param x The batch.
+ * @param hi Receives the high 64 bits of each product.
+ * @return The low 64 bits of each product.
+ */
+template <class Arch>
+PRNG_ALWAYS_INLINE xsimd::batch<std::uint64_t, Arch> mulhilo64(const std::uint64_t m,
+                                                               const xsimd::batch<std::uint64_t, Arch> &x,
+                                                               xsimd::batch<std::uint64_t, Arch> &hi) noexcept {
+  using batch_type = xsimd::batch<std::uint64_t, Arch>;
+  const auto mask = batch_type::broadcast(0xFFFFFFFF);
+  const auto m_lo = batch_type::broadcast(m & 0xFFFFFFFF);
+  const auto m_hi = batch_type::broadcast(m >> 32);
+  const auto x_hi = x >> 32;
+  const auto p0 = mul_low32(m_lo, x);
+  const auto p1 = mul_low32(m_lo, x_hi);
+  const auto p2 = mul_low32(m_hi, x);
+  const auto p3 = mul_low32(m_hi, x_hi);
+  const auto mid = (p0 >> 32) + (p1 & mask) + (p2 & mask);
+  hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+  return (p0 & mask) | (mid << 32);
+}
+
+/**
+ * Lane-wise low 64 bits of the product of two batches, assembled from three 32x32 -> 64-bit products.
+ */
+template <class Arch>
+PRNG_ALWAYS_INLINE xsimd::batch<std::uint64_t, Arch> mullo64(const xsimd::batch<std::uint64_t, Arch> &a,
+                                                             const xsimd::batch<std::uint64_t, Arch> &b) noexcept {
+  const auto cross = mul_low32(a >> 32, b) + mul_low32(a, b >> 32);
+  return mul_low32(a, b) + (cross << 32);
+}
+
+}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <xsimd/xsimd.hpp>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Maps a random word to a uniform double in [0, 1) using the high 53 bits.
+ *
+ * @param x The random word.
+ * @return The uniform double.
+ */
+PRNG_ALWAYS_INLINE constexpr double to_uniform(const std::uint64_t x) noexcept {
+  return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+/**
+ * Converts a batch of 64-bit random words to uniform doubles in [0, 1) using the high 53 bits, exactly like the
+ * scalar `static_cast<double>(x >> 11) * 0x1.0p-53`.
+ *
+ * AVX-512DQ has a native unsigned 64-bit to double conversion. Elsewhere the 53-bit value is split in a 21-bit high
+ * and a 32-bit low half, each OR-ed into the mantissa of a power of two (2^84 and 2^52) and the bias is subtracted
+ * again. Every step is exact, so the result is bit-identical to the scalar path.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ * @param x The random words.
+ * @return The uniform doubles.
+ */
+template <class Arch>
+PRNG_ALWAYS_INLINE xsimd::batch<double, Arch> to_uniform(const xsimd::batch<std::uint64_t, Arch> &x) noexcept {
+  using uint_batch = xsimd::batch<std::uint64_t, Arch>;
+  using double_batch = xsimd::batch<double, Arch>;
+  const auto mantissa = xsimd::bitwise_rshift<11>(x);
+#if defined(__AVX512DQ__)
+  if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+    return double_batch(_mm512_cvtepu64_pd(mantissa)) * double_batch(0x1.0p-53);
+  } else
+#endif
+  {
+    const auto high = xsimd::bitwise_rshift<32>(mantissa) | uint_batch(0x4530000000000000);
+    const auto low = (mantissa & uint_batch(0xFFFFFFFF)) | uint_batch(0x4330000000000000);
+    const auto value = (xsimd::bitwise_cast<double>(high) - double_batch(0x1.0p84 + 0x1.0p52)) +
+                       xsimd::bitwise_cast<double>(low);
+    return value * double_batch(0x1.0p-53);
+  }
+}
+
+/**
+ * Maps a 32-bit random word to a uniform float in [0, 1) using the high 24 bits.
+ *
+ * @param x The random word.
+ * @return The uniform float.
+ */
+PRNG_ALWAYS_INLINE constexpr float to_uniform(const std::uint32_t x) noexcept {
+  return static_cast<float>(x >> 8) * 0x1.0p-24f;
+}
+
+/**
+ * Converts a batch of 32-bit random words to uniform floats in [0, 1), exactly like the scalar overload. The 24-bit
+ * value fits a signed integer, so the plain signed conversion every target has is exact.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ * @param x The random words.
+ * @return The uniform floats.
+ */
+template <class Arch>
+PRNG_ALWAYS_INLINE xsimd::batch<float, Arch> to_uniform(const xsimd::batch<std::uint32_t, Arch> &x) noexcept {
+  const auto mantissa = xsimd::bitwise_cast<std::int32_t>(xsimd::bitwise_rshift<8>(x));
+  return xsimd::batch_cast<float>(mantissa) * xsimd::batch<float, Arch>(0x1.0p-24f);
+}
+
+} // namespace internal
+
+} // namespace prng
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#if __cplusplus >= 202002L
+#include <bit>
+#include <span>
+#endif
+#include <xsimd/xsimd.hpp>
+
+#include "random/macros.hpp"
+#include "random/simd_mul.hpp"
+#include "random/simd_uniform.hpp"
+#include "random/splitmix.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Primitive polynomial and initial direction numbers of one Sobol dimension. The polynomial is
+ * `x^degree + a_1 x^(degree - 1) + ... + a_(degree - 1) x + 1`, the bits of `coefficients` holding `a_1` (most
+ * significant) to `a_(degree - 1)`, and `m` holds the odd initial numbers `m_1` to `m_degree`.
+ */
+struct SobolPolynomial {
+  std::uint8_t degree;
+  std::uint8_t coefficients;
+  std::array<std::uint8_t, 8> m;
+};
+
+/**
+ * Number of dimensions with direction numbers, the first dimension being the van der Corput sequence.
+ */
+inline constexpr std::size_t SOBOL_MAX_DIMENSIONS = 40;
+
+/**
+ * Direction numbers of each point coordinate, so at most 2^32 points.
+ */
+inline constexpr std::size_t SOBOL_BITS = 32;
+
+/**
+ * Dimensions 2 to SOBOL_MAX_DIMENSIONS of Joe and Kuo's `new-joe-kuo-6.21201` ("Constructing Sobol sequences with
+ * better two-dimensional projections", 2008).
+ */
+inline constexpr std::array<SobolPolynomial, SOBOL_MAX_DIMENSIONS - 1> SOBOL_POLYNOMIALS{{
+  {1, 0, {1}},
+  {2, 1, {1, 3}},
+  {3, 1, {1, 3, 1}},
+  {3, 2, {1, 1, 1}},
+  {4, 1, {1, 1, 3, 3}},
+  {4, 4, {1, 3, 5, 13}},
+  {5, 2, {1, 1, 5, 5, 17}},
+  {5, 4, {1, 1, 5, 5, 5}},
+  {5, 7, {1, 1, 7, 11, 19}},
+  {5, 11, {1, 1, 5, 1, 1}},
+  {5, 13, {1, 1, 1, 3, 11}},
+  {5, 14, {1, 3, 5, 5, 31}},
+  {6, 1, {1, 3, 3, 9, 7, 49}},
+  {6, 13, {1, 1, 1, 15, 21, 21}},
+  {6, 16, {1, 3, 1, 13, 27, 49}},
+  {6, 19, {1, 1, 1, 15, 7, 5}},
+  {6, 22, {1, 3, 1, 15, 13, 25}},
+  {6, 25, {1, 1, 5, 5, 19, 61}},
+  {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+  {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+  {7, 7, {1, 1, 3, 13, 7, 35, 63}},
+  {7, 8, {1, 3, 5, 9, 1, 25, 53}},
+  {7, 14, {1, 3, 1, 13, 9, 35, 107}},
+  {7, 19, {1, 3, 1, 5, 27, 61, 31}},
+  {7, 21, {1, 1, 5, 11, 19, 41, 61}},
+  {7, 28, {1, 3, 5, 3, 3, 13, 69}},
+  {7, 31, {1, 1, 7, 13, 1, 19, 1}},
+  {7, 32, {1, 3, 7, 5, 13, 19, 59}},
+  {7, 37, {1, 1, 3, 9, 25, 29, 41}},
+  {7, 41, {1, 3, 5, 13, 23, 1, 55}},
+  {7, 42, {1, 3, 7, 3, 13, 59, 17}},
+  {7, 50, {1, 3, 1, 3, 5, 53, 69}},
+  {7, 55, {1, 1, 5, 5, 23, 33, 13}},
+  {7, 56, {1, 1, 7, 7, 1, 61, 123}},
+  {7, 59, {1, 1, 7, 9, 13, 61, 49}},
+  {7, 62, {1, 3, 3, 5, 3, 55, 33}},
+  {8, 14, {1, 3, 1, 15, 31, 13, 49, 245}},
+  {8, 21, {1, 3, 5, 15, 31, 59, 63, 97}},
+  {8, 22, {1, 3, 1, 11, 11, 11, 77, 249}},
+}};
+
+/**
+ * The SOBOL_BITS direction numbers of a dimension (counting from 0), direction `j` being `m_(j + 1) / 2^(j + 1)` as a
+ * 32-bit binary fraction. Past the initial numbers they follow the recurrence of the primitive polynomial.
+ */
+constexpr std::array<std::uint32_t, SOBOL_BITS> sobol_directions(const std::size_t dimension) noexcept {
+  std::array<std::uint32_t, SOBOL_BITS> v{};
+  if (dimension == 0) {
+    for (auto j = std::size_t{0}; j < SOBOL_BITS; ++j) {
+      v[j] = std::uint32_t{1} << (SOBOL_BITS - 1 - j);
+    }
+    return v;
+  }
+  const auto &polynomial = SOBOL_POLYNOMIALS[dimension - 1];
+  const auto s = std::size_t{polynomial.degree};
+  for (auto j = std::size_t{0}; j < s; ++j) {
+    v[j] = std::uint32_t{polynomial.m[j]} << (SOBOL_BITS - 1 - j);
+  }
+  for (auto j = s; j < SOBOL_BITS; ++j) {
+    v[j] = v[j - s] ^ (v[j - s] >> s);
+    for (auto k = std::size_t{1}; k < s; ++k) {
+      if ((polynomial.coefficients >> (s - 1 - k)) & 1) {
+        v[j] ^= v[j - k];
+      }
+    }
+  }
+  return v;
+}
+
+PRNG_ALWAYS_INLINE constexpr std::uint32_t parity(std::uint32_t x) noexcept {
+  x ^= x >> 16;
+  x ^= x >> 8;
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return x & 1;
+}
+
+} // namespace internal
+
+/**
+ * Randomization of a Sobol sequence. Both keep the stratification of every power-of-two run of points.
+ */
+enum class SobolScrambling : std::uint8_t {
+  /** The plain sequence, starting at the origin. */
+  none,
+  /** A random lower-triangular binary matrix applied to the direction numbers, plus a random digital shift. */
+  linear_matrix,
+  /** Nested uniform (Owen) scrambling of each coordinate, with Burley's hash-based Laine-Karras permutation. */
+  owen,
+};
+
+/**
+ * @class Sobol
+ * @brief Sobol quasi-random sequence in `Dims` dimensions with the Joe-Kuo direction numbers.
+ *
+ * Points are produced in Gray-code order: the next point is the current one XOR-ed with a single direction number per
+ * dimension, done for SIMD-width runs of dimensions at once, and seek() jumps to any index in SOBOL_BITS steps
+ * whatever the index, so parallel workers can each take their own range of points. Coordinates are 32-bit binary
+ * fractions, hence doubles that are multiples of 2^-32, and the sequence has 2^32 points.
+ *
+ * Scrambled sequences take their randomness from SplitMix seeded with `seed`. The unscrambled sequence is
+ * deterministic and its first point is the origin.
+ *
+ * @tparam Dims The number of dimensions, at most internal::SOBOL_MAX_DIMENSIONS.
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <std::size_t Dims, class Arch = xsimd::best_arch> class Sobol {
+  static_assert(Dims > 0 && Dims <= internal::SOBOL_MAX_DIMENSIONS, "Direction numbers cover 1 to 40 dimensions");
+
+public:
+  using result_type = std::uint32_t;
+  using point_type = std::array<double, Dims>;
+  using simd_type = xsimd::batch<std::uint64_t, Arch>;
+  using uniform_batch_type = xsimd::batch<double, Arch>;
+  static constexpr auto DIMENSIONS = Dims;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+
+  /**
+   * @brief Constructs the unscrambled sequence.
+   */
+  Sobol() noexcept : Sobol(0, SobolScrambling::none) {}
+
+  /**
+   * @brief Constructs a scrambled sequence.
+   * @param seed The seed of the scrambling.
+   * @param scrambling The randomization.
+   */
+  explicit Sobol(const std::uint64_t seed, const SobolScrambling scrambling = SobolScrambling::owen) noexcept
+      : m_scrambling{scrambling} {
+    SplitMix rng(seed);
+    for (auto d = std::size_t{0}; d < Dims; ++d) {
+      auto v = internal::sobol_directions(d);
+      if (scrambling == SobolScrambling::linear_matrix) {
+        // row b gives output bit b: bit b itself plus a random subset of the more significant bits
+        std::array<std::uint32_t, internal::SOBOL_BITS> rows{};
+        for (auto b = std::size_t{0}; b < internal::SOBOL_BITS; ++b) {
+          const auto upper = b + 1 < internal::SOBOL_BITS ? ~std::uint32_t{0} << (b + 1) : std::uint32_t{0};
+          rows[b] = (static_cast<std::uint32_t>(rng() >> 32) & upper) | std::uint32_t{1} << b;
+        }
+        for (auto &direction : v) {
+          auto scrambled = std::uint32_t{0};
+          for (auto b = std::size_t{0}; b < internal::SOBOL_BITS; ++b) {
+            scrambled |= internal::parity(direction & rows[b]) << b;
+          }
+          direction = scrambled;
+        }
+        m_shift[d] = rng() >> 32;
+      } else if (scrambling == SobolScrambling::owen) {
+        m_seeds[d] = rng() >> 32;
+      }
+      for (auto j = std::size_t{0}; j < internal::SOBOL_BITS; ++j) {
+        m_directions[j][d] = v[j];
+      }
+    }
+    m_state = m_shift;
+  }
+
+  /**
+   * @brief Generates the next point.
+   * @return The coordinates of the next point, in [0, 1).
+   */
+  PRNG_ALWAYS_INLINE point_type operator()() noexcept {
+    point_type point;
+    next(point.data());
+    return point;
+  }
+
+  /**
+   * @brief Writes the coordinates of the next point.
+   * @param point Pointer to the `Dims` destination coordinates, in [0, 1).
+   */
+  PRNG_ALWAYS_INLINE void next(double *point) noexcept {
+    for (auto b = std::size_t{0}; b < BATCHES; ++b) {
+      store(internal::to_uniform(coordinates(b) << 32), point, b);
+    }
+    step();
+  }
+
+  /**
+   * @brief Writes the coordinates of the next point as 32-bit binary fractions.
+   * @param point Pointer to the `Dims` destination coordinates.
+   */
+  PRNG_ALWAYS_INLINE void next(result_type *point) noexcept {
+    alignas(Arch::alignment()) std::array<std::uint64_t, PADDED_DIMS> values;
+    for (auto b = std::size_t{0}; b < BATCHES; ++b) {
+      coordinates(b).store_aligned(values.data() + b * SIMD_WIDTH);
+    }
+    for (auto d = std::size_t{0}; d < Dims; ++d) {
+      point[d] = static_cast<result_type>(values[d]);
+    }
+    step();
+  }
+
+  /**
+   * @brief Fills a row-major `n` x `Dims` matrix with the next `n` points.
+   * @param out Pointer to the destination matrix.
+   * @param n The number of points.
+   */
+  void fill(double *out, const std::size_t n) noexcept {
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      next(out + i * Dims);
+    }
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with the next `out.size() / Dims` points, row-major.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<double> out) noexcept { fill(out.data(), out.size() / Dims); }
+#endif
+
+  /**
+   * @brief Moves to the point of a given index: the Gray code of the index selects the direction numbers XOR-ed
+   * together, so the cost does not depend on the index.
+   * @param index The index of the next point, below 2^32.
+   */
+  void seek(const std::uint64_t index) noexcept {
+    const auto gray = index ^ (index >> 1);
+    for (auto b = std::size_t{0}; b < BATCHES; ++b) {
+      auto value = simd_type::load_aligned(m_shift.data() + b * SIMD_WIDTH);
+      for (auto j = std::size_t{0}; j < internal::SOBOL_BITS; ++j) {
+        if ((gray >> j) & 1) {
+          value ^= simd_type::load_aligned(m_directions[j].data() + b * SIMD_WIDTH);
+        }
+      }
+      value.store_aligned(m_state.data() + b * SIMD_WIDTH);
+    }
+    m_index = index;
+  }
+
+  /**
+   * @brief Skips `n` points.
+   * @param n The number of points to skip.
+   */
+  PRNG_ALWAYS_INLINE void skip(const std::uint64_t n) noexcept { seek(m_index + n); }
+
+  /**
+   * @brief Returns the index of the next point.
+   * @return The index of the next point.
+   */
+  PRNG_ALWAYS_INLINE std::uint64_t index() const noexcept { return m_index; }
+
+  /**
+   * @brief Returns the randomization of the sequence.
+   * @return The randomization.
+   */
+  PRNG_ALWAYS_INLINE SobolScrambling scrambling() const noexcept { return m_scrambling; }
+
+private:
+  static constexpr auto BATCHES = (Dims + SIMD_WIDTH - 1) / SIMD_WIDTH;
+  static constexpr auto PADDED_DIMS = BATCHES * SIMD_WIDTH;
+  using lanes_type = std::array<std::uint64_t, PADDED_DIMS>;
+
+  // 32-bit values in 64-bit lanes, so that they convert to doubles like the other generators; padding lanes stay 0
+  alignas(64) std::array<lanes_type, internal::SOBOL_BITS> m_directions{};
+  alignas(64) lanes_type m_shift{};
+  alignas(64) lanes_type m_seeds{};
+  alignas(64) lanes_type m_state{};
+  std::uint64_t m_index = 0;
+  SobolScrambling m_scrambling;
+
+  // the coordinates of the current point, in the low halves of the lanes
+  PRNG_ALWAYS_INLINE simd_type coordinates(const std::size_t b) const noexcept {
+    const auto value = simd_type::load_aligned(m_state.data() + b * SIMD_WIDTH);
+    if (m_scrambling == SobolScrambling::owen) {
+      return owen(value, simd_type::load_aligned(m_seeds.data() + b * SIMD_WIDTH));
+    }
+    return value;
+  }
+
+  PRNG_ALWAYS_INLINE void step() noexcept {
+    // the next Gray code differs in the lowest zero bit of the index
+#if __cplusplus >= 202002L
+    const auto j = static_cast<std::size_t>(std::countr_one(m_index));
+#else
+    auto j = std::size_t{0};
+    while ((m_index >> j) & 1) {
+      ++j;
+    }
+#endif
+    ++m_index;
+    if (j >= internal::SOBOL_BITS) [[unlikely]] {
+      return;
+    }
+    for (auto b = std::size_t{0}; b < BATCHES; ++b) {
+      const auto direction = simd_type::load_aligned(m_directions[j].data() + b * SIMD_WIDTH);
+      (simd_type::load_aligned(m_state.data() + b * SIMD_WIDTH) ^ direction)
+        .store_aligned(m_state.data() + b * SIMD_WIDTH);
+    }
+  }
+
+  // stores batch b of the coordinates, the last one only up to Dims
+  static PRNG_ALWAYS_INLINE void store(const uniform_batch_type &value, double *point, const std::size_t b) noexcept {
+    if ((b + 1) * SIMD_WIDTH <= Dims) {
+      value.store_unaligned(point + b * SIMD_WIDTH);
+      return;
+    }
+    alignas(Arch::alignment()) std::array<double, SIMD_WIDTH> tail;
+    value.store_aligned(tail.data());
+    for (auto lane = std::size_t{0}; b * SIMD_WIDTH + lane < Dims; ++lane) {
+      point[b * SIMD_WIDTH + lane] = tail[lane];
+    }
+  }
+
+  static PRNG_ALWAYS_INLINE simd_type reverse_bits(simd_type x) noexcept {
+    const auto swap = [](const simd_type &y, const std::uint64_t mask, const int shift) noexcept {
+      const auto m = simd_type::broadcast(mask);
+      return ((y >> shift) & m) | ((y & m) << shift);
+    };
+    x = swap(x, 0x55555555, 1);
+    x = swap(x, 0x33333333, 2);
+    x = swap(x, 0x0F0F0F0F, 4);
+    x = swap(x, 0x00FF00FF, 8);
+    return swap(x, 0x0000FFFF, 16);
+  }
+
+  // x * c modulo 2^32, on 32-bit values
+  static PRNG_ALWAYS_INLINE simd_type mul32(const simd_type &x, const std::uint64_t c) noexcept {
+    return internal::mul_low32(x, simd_type::broadcast(c)) & simd_type::broadcast(0xFFFFFFFF);
+  }
+
+  // Burley, "Practical Hash-based Owen Scrambling" (2020): the Laine-Karras hash applied to the reversed bits
+  static PRNG_ALWAYS_INLINE simd_type owen(simd_type x, const simd_type &seed) noexcept {
+    x = reverse_bits(x);
+    x = (x + seed) & simd_type::broadcast(0xFFFFFFFF);
+    x ^= mul32(x, 0x6c50b47c);
+    x ^= mul32(x, 0xb82f1e52);
+    x ^= mul32(x, 0xc7afe638);
+    x ^= mul32(x, 0x8d22f6e6);
+    return reverse_bits(x);
+  }
+};
+
+} // namespace prng
@@ -29,15 +29,37 @@ namespace prng {
 
 class SplitMix {
 public:
+  /**
+   * The Weyl increment added to the state before each output.
+   */
+  static constexpr std::uint64_t GAMMA = 0x9e3779b97f4a7c15;
+
   PRNG_ALWAYS_INLINE constexpr explicit SplitMix(const std::uint64_t state) noexcept : m_state(state) {}
 
-  PRNG_ALWAYS_INLINE constexpr std::uint64_t operator()() noexcept {
-    std::uint64_t z = (m_state += 0x9e3779b97f4a7c15);
+  PRNG_ALWAYS_INLINE constexpr std::uint64_t operator()() noexcept { return mix(m_state += GAMMA); }
+
+  /**
+   * @brief The mixing function applied to the counter.
+   * @param z The counter value.
+   * @return The output for that counter value.
+   */
+  static constexpr PRNG_ALWAYS_INLINE std::uint64_t mix(std::uint64_t z) noexcept {
     z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
     z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
     return z ^ (z >> 31);
   }
 
+  /**
+   * @brief Random access: output `index` (counting from 0) of `SplitMix(seed)`, computed without any state. Every
+   * index is independent, so parallel loops can derive per-index randomness from a shared seed.
+   * @param seed The seed, i.e. the initial state.
+   * @param index The position in the stream.
+   * @return The same value as the `index + 1`-th call of operator().
+   */
+  static constexpr PRNG_ALWAYS_INLINE std::uint64_t at(const std::uint64_t seed, const std::uint64_t index) noexcept {
+    return mix(seed + (index + 1) * GAMMA);
+  }
+
   static constexpr PRNG_ALWAYS_INLINE std::uint64_t(min)() noexcept {
     return std::numeric_limits<std::uint64_t>::lowest();
   }
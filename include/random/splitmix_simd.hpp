@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <xsimd/xsimd.hpp>
+
+#include "random/macros.hpp"
+#include "random/simd_mul.hpp"
+#include "random/simd_uniform.hpp"
+#include "random/splitmix.hpp"
+
+namespace prng {
+
+/**
+ * @class SplitMixSIMD
+ * @brief SplitMix computing SIMD-width consecutive outputs per batch, stream-compatible with SplitMix.
+ *
+ * SplitMix is a Weyl counter followed by a hash, so lane `l` of a batch hashes `state + (l + 1) * GAMMA` and the
+ * lanes are independent. next_batch() returns the next SIMD_WIDTH outputs, operator() the next one, and fill() and
+ * fill_uniform() the next `n`: all of them continue the stream of SplitMix, and getState() matches the scalar state
+ * after them. The static at() overloads evaluate arbitrary positions with no state at all.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch = xsimd::best_arch> class SplitMixSIMD {
+public:
+  using result_type = std::uint64_t;
+  using simd_type = xsimd::batch<result_type, Arch>;
+  using batch_type = simd_type;
+  using uniform_batch_type = xsimd::batch<double, Arch>;
+  static constexpr auto SIMD_WIDTH = std::size_t{simd_type::size};
+
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator with the same initial state as `SplitMix(state)`.
+   * @param state The initial state.
+   */
+  PRNG_ALWAYS_INLINE explicit SplitMixSIMD(const result_type state) noexcept : m_state{state} {}
+
+  /**
+   * @brief Generates the next output, like SplitMix::operator().
+   * @return The next output.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept { return SplitMix::mix(m_state += SplitMix::GAMMA); }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE double uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * @brief Generates the next SIMD_WIDTH outputs, lane `l` holding the `l`-th.
+   * @return The batch of outputs.
+   */
+  PRNG_ALWAYS_INLINE batch_type next_batch() noexcept {
+    const auto result = mix(simd_type::broadcast(m_state) + lane_offsets());
+    m_state += SIMD_WIDTH * SplitMix::GAMMA;
+    return result;
+  }
+
+  /**
+   * @brief Generates the next SIMD_WIDTH outputs as uniform random numbers in the range [0, 1).
+   * @return The batch of uniform random numbers.
+   */
+  PRNG_ALWAYS_INLINE uniform_batch_type next_uniform_batch() noexcept { return internal::to_uniform(next_batch()); }
+
+  /**
+   * @brief Fills a buffer with the next `n` outputs of the stream.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, const std::size_t n) noexcept {
+    generate(out, n, [](const simd_type &value, result_type *dst) noexcept { value.store_unaligned(dst); },
+             [](const result_type value) noexcept { return value; });
+  }
+
+  /**
+   * @brief Fills a buffer with the next `n` outputs of the stream as uniform random numbers in the range [0, 1).
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, const std::size_t n) noexcept {
+    generate(
+      out, n, [](const simd_type &value, double *dst) noexcept { internal::to_uniform(value).store_unaligned(dst); },
+      [](const result_type value) noexcept { return internal::to_uniform(value); });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * @brief Fills a span with the next outputs of the stream.
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * @brief Fills a span with uniform random numbers in the range [0, 1).
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * @brief Random access to a batch of positions: lane `l` is `SplitMix::at(seed, indices[l])`.
+   * @param seed The seed, i.e. the initial state.
+   * @param indices The positions in the stream.
+   * @return The outputs at those positions.
+   */
+  static PRNG_ALWAYS_INLINE simd_type at(const result_type seed, const simd_type &indices) noexcept {
+    const auto gamma = simd_type::broadcast(SplitMix::GAMMA);
+    return mix(simd_type::broadcast(seed) + internal::mullo64(indices, gamma) + gamma);
+  }
+
+  /**
+   * @brief Random access to `n` arbitrary positions: `out[i]` is `SplitMix::at(seed, indices[i])`.
+   * @param seed The seed, i.e. the initial state.
+   * @param indices Pointer to the positions in the stream.
+   * @param out Pointer to the destination buffer.
+   * @param n The number of positions.
+   */
+  static void at(const result_type seed, const result_type *indices, result_type *out, const std::size_t n) noexcept {
+    auto i = std::size_t{0};
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+      at(seed, simd_type::load_unaligned(indices + i)).store_unaligned(out + i);
+    }
+    for (; i < n; ++i) {
+      out[i] = SplitMix::at(seed, indices[i]);
+    }
+  }
+
+  /**
+   * @brief Returns the state, equal to the state of a SplitMix that produced the same outputs.
+   * @return The state.
+   */
+  PRNG_ALWAYS_INLINE result_type getState() const noexcept { return m_state; }
+
+  /**
+   * @brief Sets the state, like SplitMix::setState().
+   * @param state The new state.
+   */
+  PRNG_ALWAYS_INLINE void setState(const result_type state) noexcept { m_state = state; }
+
+private:
+  result_type m_state;
+
+  static PRNG_ALWAYS_INLINE simd_type mix(simd_type z) noexcept {
+    z = internal::mullo64(z ^ (z >> 30), simd_type::broadcast(0xbf58476d1ce4e5b9));
+    z = internal::mullo64(z ^ (z >> 27), simd_type::broadcast(0x94d049bb133111eb));
+    return z ^ (z >> 31);
+  }
+
+  // (l + 1) * GAMMA in lane l
+  static PRNG_ALWAYS_INLINE simd_type lane_offsets() noexcept {
+    alignas(Arch::alignment()) std::array<result_type, SIMD_WIDTH> offsets{};
+    for (auto lane = std::size_t{0}; lane < SIMD_WIDTH; ++lane) {
+      offsets[lane] = (lane + 1) * SplitMix::GAMMA;
+    }
+    return simd_type::load_aligned(offsets.data());
+  }
+
+  template <class Out, class Store, class Convert>
+  PRNG_ALWAYS_INLINE void generate(Out *out, const std::size_t n, Store &&store, Convert &&convert) noexcept {
+    const auto offsets = lane_offsets();
+    const auto step = simd_type::broadcast(SIMD_WIDTH * SplitMix::GAMMA);
+    auto state = simd_type::broadcast(m_state) + offsets;
+    auto i = std::size_t{0};
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH) {
+      store(mix(state), out + i);
+      state += step;
+    }
+    m_state += i * SplitMix::GAMMA;
+    for (; i < n; ++i) {
+      out[i] = convert(SplitMix::mix(m_state += SplitMix::GAMMA));
+    }
+  }
+};
+
+}
@@ -0,0 +1,226 @@
+/*  Written in 2018 by David Blackman and Sebastiano Vigna (vigna@acm.org)
+
+To the extent possible under law, the author has dedicated all copyright
+and related and neighboring rights to this software to the public domain
+worldwide.
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose with or without fee is hereby granted.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR
+IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+Ported to C++, vectorized, and optimized by Marco Barbone.
+Original implementation by David Blackman and Sebastiano
+Vigna.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "macros.hpp"
+#include "splitmix.hpp"
+#include "xoshiro_jump.hpp"
+#include "xoshiro_scrambler.hpp"
+
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Advances the xoshiro128 engine by 2^64 steps.
+ */
+inline constexpr jump_poly128 XOSHIRO128_JUMP = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+
+/**
+ * Advances the xoshiro128 engine by 2^96 steps.
+ */
+inline constexpr jump_poly128 XOSHIRO128_LONG_JUMP = {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662};
+
+} // namespace internal
+
+/**
+ * @class BasicXoshiro128Scalar
+ * @brief A class implementing the xoshiro128 family, which produces 32-bit numbers from a 128-bit state.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro128++) or ScramblerStarStar (xoshiro128**).
+ */
+template <class Scrambler = ScramblerPlusPlus> class BasicXoshiro128Scalar {
+public:
+  using result_type = std::uint32_t;
+  using seed_type = std::uint64_t;
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  /**
+   * @brief Constructs the generator with a given seed. Each of the two SplitMix outputs fills two state words.
+   * @param seed The seed value.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiro128Scalar(const seed_type seed) noexcept : m_state{} {
+    for (auto i = 0; i < 4; i += 2) {
+      const auto word = SplitMix::at(seed, static_cast<std::uint64_t>(i / 2));
+      m_state[i] = static_cast<result_type>(word);
+      m_state[i + 1] = static_cast<result_type>(word >> 32);
+    }
+  }
+
+  /**
+   * @brief Constructs the generator with a given seed and thread ID. Thread `k` starts `k` long jumps ahead, so
+   * threads draw from non-overlapping blocks of 2^96 values.
+   * @param seed The seed value.
+   * @param thread_id The thread ID.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiro128Scalar(const seed_type seed, const seed_type thread_id) noexcept
+      : BasicXoshiro128Scalar(seed) {
+    jump_to_stream(thread_id);
+  }
+
+  /**
+   * @brief Generates the next random number.
+   * @return The next random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr result_type(operator())() noexcept { return next(); }
+
+  /**
+   * @brief Generates a uniform random number in the range [0, 1).
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr float(uniform)() noexcept { return static_cast<float>(next() >> 8) * 0x1.0p-24f; }
+
+  /**
+   * @brief Returns the state of the generator.
+   * @return The state of the generator.
+   */
+  PRNG_ALWAYS_INLINE constexpr std::array<result_type, 4> getState() const noexcept { return m_state; }
+
+  /**
+   * @brief Returns the size of the state array.
+   * @return The size of the state array.
+   */
+  static constexpr PRNG_ALWAYS_INLINE result_type stateSize() noexcept { return 4; }
+
+  /**
+   * @brief Jump function for the generator. It is equivalent to 2^64 calls to next().
+   * It can be used to generate 2^64 non-overlapping subsequences for simd computations.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump() noexcept { apply_jump(internal::XOSHIRO128_JUMP); }
+
+  /**
+   * @brief Long-jump function for the generator. It is equivalent to 2^96 calls to next().
+   * It can be used to generate 2^32 starting points, from each of which jump() will generate 2^32 non-overlapping
+   * subsequences for parallel distributed computations.
+   */
+  PRNG_ALWAYS_INLINE constexpr void long_jump() noexcept { apply_jump(internal::XOSHIRO128_LONG_JUMP); }
+
+  /**
+   * @brief Advances the generator by n steps, equivalent to n calls to next(). It costs O(log n) polynomial
+   * multiplications plus a single jump instead of n steps.
+   * @param n The number of steps.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(seed_type n) noexcept {
+    // a polynomial jump costs 128 steps, so short distances are cheaper to walk
+    if (n <= 128) {
+      for (; n != 0; --n) {
+        next();
+      }
+      return;
+    }
+    apply_jump(internal::jump_poly128_for(n, 0));
+  }
+
+  /**
+   * @brief Moves to the k-th subsequence, equivalent to k calls to long_jump() but in at most one jump.
+   * @param k The subsequence index.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump_to_stream(const seed_type k) noexcept {
+    if (k != 0) {
+      apply_jump(internal::jump_poly128_for(k, 96));
+    }
+  }
+
+private:
+  std::array<result_type, 4> m_state;
+
+  /**
+   * @brief Advances the state by the jump polynomial `poly`.
+   * @param poly The jump polynomial coefficients.
+   */
+  PRNG_ALWAYS_INLINE constexpr void apply_jump(const internal::jump_poly128 &poly) noexcept {
+    result_type s0 = 0;
+    result_type s1 = 0;
+    result_type s2 = 0;
+    result_type s3 = 0;
+    for (const auto i : poly)
+      for (auto b = 0; b < 32; b++) {
+        if (i & result_type{1} << b) {
+          s0 ^= m_state[0];
+          s1 ^= m_state[1];
+          s2 ^= m_state[2];
+          s3 ^= m_state[3];
+        }
+        next();
+      }
+    m_state[0] = s0;
+    m_state[1] = s1;
+    m_state[2] = s2;
+    m_state[3] = s3;
+  }
+
+  /**
+   * @brief Rotates the bits of a 32-bit integer to the left.
+   * @param x The integer to rotate.
+   * @param k The number of bits to rotate.
+   * @return The rotated integer.
+   */
+  static constexpr PRNG_ALWAYS_INLINE auto rotl(const result_type x, const int k) noexcept {
+#if __cplusplus >= 202002L
+    return std::rotl(x, k);
+#else
+    return static_cast<result_type>((x << k) | (x >> (32 - k)));
+#endif
+  }
+
+  /**
+   * @brief Scalar rotate used by the scrambler policy.
+   */
+  struct ops {
+    template <int K> static PRNG_ALWAYS_INLINE constexpr result_type rotl(const result_type x) noexcept {
+      return BasicXoshiro128Scalar::rotl(x, K);
+    }
+  };
+
+  /**
+   * @brief Generates the next state of the generator.
+   * @return The next state.
+   */
+  PRNG_ALWAYS_INLINE constexpr result_type next() noexcept {
+    const auto result = Scrambler::template scramble<ops>(m_state[0], m_state[1], m_state[2], m_state[3]);
+    const auto t_shift = static_cast<result_type>(m_state[1] << 9);
+
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+
+    m_state[2] ^= t_shift;
+    m_state[3] = rotl(m_state[3], 11);
+
+    return result;
+  }
+};
+
+using Xoshiro128Scalar = BasicXoshiro128Scalar<>;
+using Xoshiro128StarStarScalar = BasicXoshiro128Scalar<ScramblerStarStar>;
+
+} // namespace prng
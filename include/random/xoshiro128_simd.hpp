@@ -0,0 +1,716 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include <xsimd/xsimd.hpp>
+
+#include "macros.hpp"
+#include "simd_uniform.hpp"
+#include "xoshiro128_scalar.hpp"
+#include "xoshiro_scrambler.hpp"
+#include "xoshiro_simd.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Widest SIMD register, in 32-bit lanes, of the architectures Xoshiro128SIMD dispatches to.
+ */
+inline constexpr std::size_t MAX_SIMD_WIDTH32 = 2 * MAX_SIMD_WIDTH;
+
+/**
+ * Words of inline state storage Xoshiro128SIMD reserves, enough for MAX_SIMD_WIDTH32 lanes of xoshiro128 state.
+ */
+inline constexpr std::size_t XOSHIRO128_SIMD_STATE_SIZE = 4 * MAX_SIMD_WIDTH32;
+
+template <class Arch, class Scrambler> struct Xoshiro128SIMDKernels;
+
+/**
+ * Implementation of the Xoshiro128SIMD class template. Every lane runs its own xoshiro128 engine, lane `i` starting
+ * `i` jumps after the scalar generator with the same seed, so a register holds twice as many lanes as XoshiroSIMD.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single batch per refill.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro128++) or ScramblerStarStar (xoshiro128**).
+ */
+template <class Arch, std::size_t CacheSize = 256, class Scrambler = ScramblerPlusPlus> class Xoshiro128SIMDImpl {
+public:
+  using result_type = std::uint32_t;
+  using seed_type = std::uint64_t;
+  static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return (std::numeric_limits<result_type>::min)(); }
+  static constexpr PRNG_ALWAYS_INLINE auto(max)() noexcept { return (std::numeric_limits<result_type>::max)(); }
+  static constexpr PRNG_ALWAYS_INLINE auto stateSize() noexcept { return RNG_WIDTH; }
+
+protected:
+  using simd_type = xsimd::batch<result_type, Arch>;
+  static constexpr auto RNG_WIDTH = std::uint8_t{4};
+  static constexpr auto SIMD_WIDTH = std::uint8_t{simd_type::size};
+  static constexpr auto CACHE_SIZE = CacheSize == 0 ? std::size_t{SIMD_WIDTH} : CacheSize;
+  // values written per unrolled refill step, matching a 256-entry cache
+  static constexpr auto UNROLL_SIZE = CACHE_SIZE < 256 ? CACHE_SIZE : std::size_t{256};
+  static_assert(CACHE_SIZE % SIMD_WIDTH == 0, "Cache size must be a multiple of the SIMD width");
+  static_assert(CACHE_SIZE <= std::numeric_limits<std::uint32_t>::max(), "Cache size must fit the cache index");
+  using index_type = std::uint32_t;
+
+public:
+  using batch_type = simd_type;
+  using uniform_batch_type = xsimd::batch<float, Arch>;
+
+  /**
+   * Constructor that initializes the generator with a seed and an external cache.
+   *
+   * @param seed The seed value.
+   * @param cache Reference to the external cache.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit Xoshiro128SIMDImpl(const seed_type seed,
+                                                           std::array<result_type, CACHE_SIZE> &cache) noexcept
+      : m_cache(cache), m_state{}, m_index{CACHE_SIZE} {
+    Xoshiro128Scalar rng{seed};
+    std::array<std::array<result_type, SIMD_WIDTH>, RNG_WIDTH> states{};
+    for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+      for (auto j = 0UL; j < RNG_WIDTH; ++j) {
+        states[j][i] = rng.getState()[j];
+      }
+      rng.jump();
+    }
+    for (auto i = UINT8_C(0); i < RNG_WIDTH; ++i) {
+      m_state[i] = simd_type::load_unaligned(states[i].data());
+    }
+  }
+
+  /**
+   * Constructor that initializes the generator with a seed, thread ID, and an external cache.
+   *
+   * @param seed The seed value.
+   * @param thread_id The thread ID.
+   * @param cache Reference to the external cache.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit Xoshiro128SIMDImpl(const seed_type seed, const seed_type thread_id,
+                                                           std::array<result_type, CACHE_SIZE> &cache) noexcept
+      : Xoshiro128SIMDImpl(seed, cache) {
+    jump_to_stream(thread_id);
+  }
+
+  /**
+   * Generates the next random number.
+   *
+   * @return The next random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr auto operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * Generates a uniform random number in the range [0, 1).
+   *
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE constexpr float uniform() noexcept { return to_uniform(operator()()); }
+
+  /**
+   * Generates the next SIMD batch straight from the state, without going through the cache. Lane `i` holds the next
+   * value of lane `i`, with the same semantics as XoshiroSIMDImpl::next_batch().
+   *
+   * @return The next batch of random numbers.
+   */
+  PRNG_ALWAYS_INLINE batch_type next_batch() noexcept { return next(m_state); }
+
+  /**
+   * Generates the next SIMD batch of uniform random numbers in the range [0, 1), with the semantics of next_batch().
+   *
+   * @return The next batch of uniform random numbers.
+   */
+  PRNG_ALWAYS_INLINE uniform_batch_type next_uniform_batch() noexcept { return internal::to_uniform(next_batch()); }
+
+  /**
+   * Fills a buffer with random numbers. The output is identical to calling operator() `n` times, but whole SIMD
+   * batches are stored directly into the buffer instead of going through the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill(result_type *out, const std::size_t n) noexcept {
+    fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) { return x; }, [this] { populate_cache(); },
+        [this](result_type *dst, const std::size_t count) { return fill_batches(dst, count); });
+  }
+
+  /**
+   * Fills a buffer with uniform random floats in the range [0, 1). The output is identical to calling uniform() `n`
+   * times, but whole SIMD batches are converted in registers and stored directly into the buffer.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(float *out, const std::size_t n) noexcept {
+    fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) { return to_uniform(x); }, [this] { populate_cache(); },
+        [this](float *dst, const std::size_t count) { return fill_uniform_batches(dst, count); });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * Fills a span with random numbers.
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * Fills a span with uniform random floats in the range [0, 1).
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<float> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * Returns the state of the generator at the specified lane.
+   *
+   * @param index The index of the lane.
+   * @return The state at the specified lane.
+   */
+  PRNG_ALWAYS_INLINE constexpr auto getState(const std::size_t index) const noexcept {
+    std::array<result_type, RNG_WIDTH> state{};
+    for (auto i = UINT8_C(0); i < RNG_WIDTH; ++i) {
+      state[i] = m_state[i].get(index);
+    }
+    return state;
+  }
+
+  /**
+   * Jump function for the generator. It is equivalent to 2^64 calls to next() on every lane.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump() noexcept { apply_jump(XOSHIRO128_JUMP); }
+
+  /**
+   * Long-jump function for the generator. It is equivalent to 2^96 calls to next() on every lane.
+   */
+  PRNG_ALWAYS_INLINE constexpr void long_jump() noexcept { apply_jump(XOSHIRO128_LONG_JUMP); }
+
+  /**
+   * Skips n values of the output, equivalent to n calls to operator(). Whole cache refills are skipped by advancing
+   * every lane, which costs O(log n) polynomial multiplications plus a single jump instead of n steps.
+   *
+   * @param n The number of values to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(seed_type n) noexcept {
+    const auto cached = seed_type{CACHE_SIZE - m_index};
+    if (n < cached) {
+      m_index += static_cast<index_type>(n);
+      return;
+    }
+    n -= cached;
+    // every refill advances each lane by CACHE_SIZE / SIMD_WIDTH steps
+    advance(n / CACHE_SIZE * (CACHE_SIZE / SIMD_WIDTH));
+    populate_cache();
+    m_index = static_cast<index_type>(n % CACHE_SIZE);
+  }
+
+  /**
+   * Moves to the k-th subsequence, equivalent to k calls to long_jump() but in at most one jump.
+   *
+   * @param k The subsequence index.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump_to_stream(const seed_type k) noexcept {
+    if (k != 0) {
+      apply_jump(jump_poly128_for(k, 96));
+    }
+  }
+
+private:
+  struct state_tag {};
+
+  /**
+   * Advances every lane by n steps, equivalent to n calls to next(). The cache is not affected.
+   *
+   * @param n The number of steps.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(seed_type n) noexcept {
+    // a polynomial jump costs 128 steps, so short distances are cheaper to walk
+    if (n <= 128) {
+      for (; n != 0; --n) {
+        next(m_state);
+      }
+      return;
+    }
+    apply_jump(jump_poly128_for(n, 0));
+  }
+
+  /**
+   * Constructor that loads the state saved by save_state(), laid out word by word.
+   *
+   * @param state The saved state, aligned to the architecture alignment.
+   * @param cache Reference to the external cache.
+   */
+  PRNG_ALWAYS_INLINE explicit Xoshiro128SIMDImpl(state_tag, const result_type *state,
+                                                 std::array<result_type, CACHE_SIZE> &cache) noexcept
+      : m_cache(cache), m_state{}, m_index{CACHE_SIZE} {
+    for (auto i = std::size_t{0}; i < RNG_WIDTH; ++i) {
+      m_state[i] = simd_type::load_aligned(state + i * SIMD_WIDTH);
+    }
+  }
+
+  /**
+   * Saves the state.
+   *
+   * @param state Destination of RNG_WIDTH * SIMD_WIDTH words, aligned to the architecture alignment.
+   */
+  PRNG_ALWAYS_INLINE void save_state(result_type *state) const noexcept {
+    for (auto i = std::size_t{0}; i < RNG_WIDTH; ++i) {
+      m_state[i].store_aligned(state + i * SIMD_WIDTH);
+    }
+  }
+
+  std::array<result_type, CACHE_SIZE> &m_cache;
+  alignas(simd_type::arch_type::alignment()) std::array<simd_type, RNG_WIDTH> m_state;
+  index_type m_index;
+
+  /**
+   * Advances the state of every lane by the jump polynomial `poly`.
+   *
+   * @param poly The jump polynomial coefficients.
+   */
+  PRNG_ALWAYS_INLINE constexpr void apply_jump(const jump_poly128 &poly) noexcept {
+    simd_type s0(0);
+    simd_type s1(0);
+    simd_type s2(0);
+    simd_type s3(0);
+    for (const auto i : poly)
+      for (auto b = 0; b < 32; b++) {
+        if (i & result_type{1} << b) {
+          s0 ^= m_state[0];
+          s1 ^= m_state[1];
+          s2 ^= m_state[2];
+          s3 ^= m_state[3];
+        }
+        next(m_state);
+      }
+    m_state[0] = s0;
+    m_state[1] = s1;
+    m_state[2] = s2;
+    m_state[3] = s3;
+  }
+
+  /**
+   * Generates the next state.
+   *
+   * @param state The state to advance.
+   * @return The next state.
+   */
+  static PRNG_ALWAYS_INLINE constexpr auto next(std::array<simd_type, RNG_WIDTH> &state) noexcept {
+    const auto result = Scrambler::template scramble<BatchOps>(state[0], state[1], state[2], state[3]);
+    const auto t = xsimd::bitwise_lshift<9>(state[1]);
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+
+    state[2] ^= t;
+
+    state[3] = xsimd::rotl<11>(state[3]);
+
+    return result;
+  }
+
+  /**
+   * Unrolled loop to populate a chunk of the cache.
+   *
+   * @tparam Is The indices of the cache.
+   * @param out Start of the chunk.
+   */
+  template <size_t... Is>
+  PRNG_ALWAYS_INLINE constexpr void unroll_populate(result_type *out, std::index_sequence<Is...>) noexcept {
+    (next(m_state).store_aligned(out + Is * SIMD_WIDTH), ...);
+  }
+
+  /**
+   * Populates the cache with random numbers, fully unrolled up to 256 values and in unrolled chunks beyond.
+   */
+  PRNG_ALWAYS_INLINE constexpr void populate_cache() noexcept {
+    for (auto offset = std::size_t{0}; offset + UNROLL_SIZE <= CACHE_SIZE; offset += UNROLL_SIZE) {
+      unroll_populate(m_cache.data() + offset, std::make_index_sequence<UNROLL_SIZE / SIMD_WIDTH>{});
+    }
+    unroll_populate(m_cache.data() + CACHE_SIZE - CACHE_SIZE % UNROLL_SIZE,
+                    std::make_index_sequence<CACHE_SIZE % UNROLL_SIZE / SIMD_WIDTH>{});
+  }
+
+  /**
+   * Writes as many whole batches as fit in the buffer, bypassing the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The size of the destination buffer.
+   * @return The number of values written.
+   */
+  PRNG_ALWAYS_INLINE std::size_t fill_batches(result_type *PRNG_RESTRICT out, const std::size_t n) noexcept {
+    const auto count = n - n % SIMD_WIDTH;
+    const auto *const end = out + count;
+    if (reinterpret_cast<std::uintptr_t>(out) % simd_type::arch_type::alignment() != 0) {
+      for (; out != end; out += SIMD_WIDTH) {
+        next(m_state).store_unaligned(out);
+      }
+    } else {
+      for (; out != end; out += SIMD_WIDTH) {
+        next(m_state).store_aligned(out);
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Writes as many whole batches of uniform floats as fit in the buffer, bypassing the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The size of the destination buffer.
+   * @return The number of values written.
+   */
+  PRNG_ALWAYS_INLINE std::size_t fill_uniform_batches(float *PRNG_RESTRICT out, const std::size_t n) noexcept {
+    const auto count = n - n % SIMD_WIDTH;
+    const auto *const end = out + count;
+    if (reinterpret_cast<std::uintptr_t>(out) % simd_type::arch_type::alignment() != 0) {
+      for (; out != end; out += SIMD_WIDTH) {
+        internal::to_uniform(next(m_state)).store_unaligned(out);
+      }
+    } else {
+      for (; out != end; out += SIMD_WIDTH) {
+        internal::to_uniform(next(m_state)).store_aligned(out);
+      }
+    }
+    return count;
+  }
+
+  template <class, class> friend struct Xoshiro128SIMDKernels;
+};
+
+} // namespace internal
+
+/**
+ * Xoshiro128SIMD class using the best available architecture.
+ *
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single batch per refill.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro128++) or ScramblerStarStar (xoshiro128**).
+ */
+template <std::size_t CacheSize = 256, class Scrambler = ScramblerPlusPlus>
+class BasicXoshiro128Native : public internal::Xoshiro128SIMDImpl<xsimd::best_arch, CacheSize, Scrambler> {
+  using base_type = internal::Xoshiro128SIMDImpl<xsimd::best_arch, CacheSize, Scrambler>;
+  using typename base_type::simd_type;
+  using base_type::CACHE_SIZE;
+
+public:
+  using typename base_type::result_type;
+  using typename base_type::seed_type;
+  using base_type::base_type;
+
+  /**
+   * Constructor that initializes the generator with a seed.
+   *
+   * @param seed The seed value.
+   */
+  PRNG_ALWAYS_INLINE explicit BasicXoshiro128Native(const seed_type seed) noexcept : base_type(seed, m_cache) {}
+  PRNG_ALWAYS_INLINE explicit BasicXoshiro128Native(const seed_type seed, const seed_type thread_id) noexcept
+      : base_type(seed, thread_id, m_cache) {}
+
+  // the base class refers to m_cache, so a copy or move would keep pointing into this object
+  BasicXoshiro128Native(const BasicXoshiro128Native &) = delete;
+  BasicXoshiro128Native &operator=(const BasicXoshiro128Native &) = delete;
+
+private:
+  alignas(simd_type::arch_type::alignment()) std::array<result_type, CACHE_SIZE> m_cache{};
+};
+
+using Xoshiro128Native = BasicXoshiro128Native<>;
+using Xoshiro128StarStarNative = BasicXoshiro128Native<256, ScramblerStarStar>;
+
+namespace internal {
+
+/**
+ * Entry points of one Xoshiro128SIMD dispatch target, operating on the generator's inline state like XoshiroSIMDTable.
+ */
+struct Xoshiro128SIMDTable {
+  using result_type = std::uint32_t;
+  using seed_type = std::uint64_t;
+  void (*seed)(result_type *state, seed_type seed, seed_type thread_id) noexcept;
+  std::size_t (*fill_batches)(result_type *state, result_type *out, std::size_t n) noexcept;
+  std::size_t (*fill_uniform_batches)(result_type *state, float *out, std::size_t n) noexcept;
+  void (*jump)(result_type *state) noexcept;
+  void (*long_jump)(result_type *state) noexcept;
+  void (*discard)(result_type *state, seed_type n) noexcept;
+  void (*jump_to_stream)(result_type *state, seed_type k) noexcept;
+};
+
+/**
+ * Implementations of the Xoshiro128SIMDTable entry points on top of internal::Xoshiro128SIMDImpl<Arch>.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ * @tparam Scrambler The output function.
+ */
+template <class Arch, class Scrambler> struct Xoshiro128SIMDKernels {
+  using impl_type = Xoshiro128SIMDImpl<Arch, 0, Scrambler>;
+  using result_type = typename impl_type::result_type;
+  using seed_type = typename impl_type::seed_type;
+  // the impl never touches its cache here, it only needs one to be constructed
+  using cache_type = std::array<result_type, impl_type::CACHE_SIZE>;
+  static_assert(impl_type::RNG_WIDTH * impl_type::SIMD_WIDTH <= XOSHIRO128_SIMD_STATE_SIZE,
+                "The state does not fit the inline storage");
+
+  static void seed(result_type *state, const seed_type seed_value, const seed_type thread_id) noexcept {
+    cache_type cache;
+    impl_type(seed_value, thread_id, cache).save_state(state);
+  }
+  static std::size_t fill_batches(result_type *state, result_type *out, const std::size_t n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    const auto count = impl.fill_batches(out, n);
+    impl.save_state(state);
+    return count;
+  }
+  static std::size_t fill_uniform_batches(result_type *state, float *out, const std::size_t n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    const auto count = impl.fill_uniform_batches(out, n);
+    impl.save_state(state);
+    return count;
+  }
+  static void jump(result_type *state) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.jump();
+    impl.save_state(state);
+  }
+  static void long_jump(result_type *state) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.long_jump();
+    impl.save_state(state);
+  }
+  // n counts output values and must be a multiple of the SIMD width
+  static void discard(result_type *state, const seed_type n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.advance(n / impl_type::SIMD_WIDTH);
+    impl.save_state(state);
+  }
+  static void jump_to_stream(result_type *state, const seed_type k) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.jump_to_stream(k);
+    impl.save_state(state);
+  }
+
+  static constexpr Xoshiro128SIMDTable table{&seed, &fill_batches, &fill_uniform_batches, &jump, &long_jump,
+                                             &discard, &jump_to_stream};
+};
+
+} // namespace internal
+
+/**
+ * Returns the Xoshiro128SIMD entry points of the best architecture the CPU supports, detected on the first call only.
+ *
+ * @tparam Scrambler The output function. ScramblerPlusPlus and ScramblerStarStar are instantiated.
+ * @return The dispatch table.
+ */
+template <class Scrambler> const internal::Xoshiro128SIMDTable &xoshiro128_simd_table() noexcept;
+
+/**
+ * Xoshiro128SIMD class that provides a high-level interface for the generator. The lane count, and hence the output
+ * order, follows the dispatched architecture like XoshiroSIMD.
+ *
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single refill of the widest supported
+ * SIMD register.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro128++) or ScramblerStarStar (xoshiro128**).
+ */
+template <std::size_t CacheSize = 256, class Scrambler = ScramblerPlusPlus> class BasicXoshiro128SIMD {
+public:
+  using result_type = internal::Xoshiro128SIMDTable::result_type;
+  using seed_type = internal::Xoshiro128SIMDTable::seed_type;
+  constexpr static PRNG_ALWAYS_INLINE result_type(min)() noexcept {
+    return (std::numeric_limits<result_type>::min)();
+  }
+  constexpr static PRNG_ALWAYS_INLINE result_type(max)() noexcept {
+    return (std::numeric_limits<result_type>::max)();
+  }
+
+  explicit BasicXoshiro128SIMD(const seed_type seed, const seed_type thread_id = 0) noexcept
+      : m_table{&xoshiro128_simd_table<Scrambler>()} {
+    m_table->seed(m_state.data(), seed, thread_id);
+  }
+
+  /**
+   * Generates the next random number.
+   *
+   * @return The next random number.
+   */
+  PRNG_ALWAYS_INLINE result_type operator()() noexcept {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
+    }
+    return m_cache[m_index++];
+  }
+
+  /**
+   * Generates a uniform random float in the range [0, 1).
+   *
+   * @return A uniform random number.
+   */
+  PRNG_ALWAYS_INLINE float uniform() noexcept { return internal::to_uniform(operator()()); }
+
+  /**
+   * Fills a buffer with random numbers. The output is identical to calling operator() `n` times.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+        [this]() noexcept { populate_cache(); },
+        [this](result_type *dst, const std::size_t count) noexcept {
+          return m_table->fill_batches(m_state.data(), dst, count);
+        });
+  }
+
+  /**
+   * Fills a buffer with uniform random floats in the range [0, 1). The output is identical to calling uniform() `n`
+   * times.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(float *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+        [this]() noexcept { populate_cache(); },
+        [this](float *dst, const std::size_t count) noexcept {
+          return m_table->fill_uniform_batches(m_state.data(), dst, count);
+        });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * Fills a span with random numbers.
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * Fills a span with uniform random floats in the range [0, 1).
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<float> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * Jump function for the generator.
+   */
+  PRNG_ALWAYS_INLINE void jump() noexcept { m_table->jump(m_state.data()); }
+
+  /**
+   * Long-jump function for the generator.
+   */
+  PRNG_ALWAYS_INLINE void long_jump() noexcept { m_table->long_jump(m_state.data()); }
+
+  /**
+   * Skips n values of the output, equivalent to n calls to operator(), in O(log n) time.
+   *
+   * @param n The number of values to skip.
+   */
+  PRNG_ALWAYS_INLINE void discard(seed_type n) noexcept {
+    const auto cached = seed_type{CACHE_SIZE - m_index};
+    if (n < cached) {
+      m_index += static_cast<std::uint32_t>(n);
+      return;
+    }
+    n -= cached;
+    // the cache size is a multiple of the SIMD width of every dispatch target
+    m_table->discard(m_state.data(), n - n % CACHE_SIZE);
+    populate_cache();
+    m_index = static_cast<std::uint32_t>(n % CACHE_SIZE);
+  }
+
+  /**
+   * Moves to the k-th subsequence, equivalent to k long jumps.
+   */
+  PRNG_ALWAYS_INLINE void jump_to_stream(const seed_type k) noexcept { m_table->jump_to_stream(m_state.data(), k); }
+
+protected:
+  static constexpr auto CACHE_SIZE = CacheSize == 0 ? internal::MAX_SIMD_WIDTH32 : CacheSize;
+  static_assert(CACHE_SIZE % internal::MAX_SIMD_WIDTH32 == 0,
+                "Cache size must be a multiple of the widest supported SIMD width");
+  static_assert(CACHE_SIZE <= std::numeric_limits<std::uint32_t>::max(), "Cache size must fit the cache index");
+
+  /**
+   * Refills the whole cache with one call into the dispatched implementation.
+   */
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept {
+    m_table->fill_batches(m_state.data(), m_cache.data(), CACHE_SIZE);
+  }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  alignas(64) std::array<result_type, internal::XOSHIRO128_SIMD_STATE_SIZE> m_state{};
+  const internal::Xoshiro128SIMDTable *m_table;
+  std::uint32_t m_index{CACHE_SIZE};
+};
+
+using Xoshiro128SIMD = BasicXoshiro128SIMD<>;
+using Xoshiro128StarStarSIMD = BasicXoshiro128SIMD<256, ScramblerStarStar>;
+
+static_assert(std::is_trivially_copyable_v<Xoshiro128SIMD>);
+static_assert(std::is_trivially_copyable_v<Xoshiro128StarStarSIMD>);
+
+namespace internal {
+
+/**
+ * Functor used by xsimd::dispatch to select the Xoshiro128SIMD entry points.
+ *
+ * @tparam Scrambler The output function.
+ */
+template <class Scrambler> struct Xoshiro128SIMDTableCreator {
+  /**
+   * Operator that returns the Xoshiro128SIMD entry points for the given architecture.
+   *
+   * @tparam Arch The architecture type for SIMD operations.
+   * @param arch The architecture tag.
+   * @return The dispatch table.
+   */
+  template <class Arch> const Xoshiro128SIMDTable *operator()(Arch) const noexcept;
+};
+
+template <class Scrambler>
+template <class Arch>
+const Xoshiro128SIMDTable *Xoshiro128SIMDTableCreator<Scrambler>::operator()(Arch) const noexcept {
+  return &Xoshiro128SIMDKernels<Arch, Scrambler>::table;
+}
+
+// Declares (PREFIX = extern) or defines the entry points of every scrambler for one architecture.
+#define PRNG_XOSHIRO128_SIMD_TABLES(PREFIX, ARCH)                                                                    \
+  PREFIX template const Xoshiro128SIMDTable *Xoshiro128SIMDTableCreator<ScramblerPlusPlus>::operator()<ARCH>(ARCH)    \
+      const noexcept;                                                                                                \
+  PREFIX template const Xoshiro128SIMDTable *Xoshiro128SIMDTableCreator<ScramblerStarStar>::operator()<ARCH>(ARCH)    \
+      const noexcept;
+
+PRNG_XOSHIRO128_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_XOSHIRO128_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_XOSHIRO128_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_XOSHIRO128_SIMD_TABLES(extern, xsimd::avx512f)
+
+} // namespace internal
+
+} // namespace prng
@@ -0,0 +1,572 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * A polynomial over GF(2) of degree < 256, stored least significant coefficient first. Jump polynomials use the same
+ * layout as the reference xoshiro256 jump constants.
+ */
+using jump_poly = std::array<std::uint64_t, 4>;
+
+/**
+ * Characteristic polynomial of the xoshiro256 linear engine without its leading x^256 term. See
+ * devel/xoshiro_coeffs.py for its derivation.
+ */
+inline constexpr jump_poly XOSHIRO256_CHARPOLY = {0x9d116f2bb0f0f001, 0x0280002bcefd1a5e, 0x04b4edcf26259f85,
+                                                  0x0003c03c3f3ecb19};
+
+/**
+ * Multiplies two jump polynomials modulo the characteristic polynomial.
+ *
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return a * b mod P.
+ */
+PRNG_ALWAYS_INLINE constexpr jump_poly poly_mulmod(const jump_poly &a, const jump_poly &b) noexcept {
+  jump_poly result{};
+  for (auto word = 4; word-- > 0;) {
+    for (auto bit = 64; bit-- > 0;) {
+      // result *= x, folding the x^256 term back through the characteristic polynomial
+      const auto carry = result[3] >> 63;
+      result[3] = (result[3] << 1) | (result[2] >> 63);
+      result[2] = (result[2] << 1) | (result[1] >> 63);
+      result[1] = (result[1] << 1) | (result[0] >> 63);
+      result[0] <<= 1;
+      if (carry) {
+        for (auto i = 0; i < 4; ++i) {
+          result[i] ^= XOSHIRO256_CHARPOLY[i];
+        }
+      }
+      if ((b[word] >> bit) & 1) {
+        for (auto i = 0; i < 4; ++i) {
+          result[i] ^= a[i];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Compares two jump polynomials; std::array comparison is not constexpr before C++20.
+ */
+constexpr bool poly_equal(const jump_poly &a, const jump_poly &b) noexcept {
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+/**
+ * Jump polynomials for every power of two: entry i is x^(2^i) mod P and advances the engine by 2^i steps. Generated
+ * by devel/xoshiro_coeffs.py.
+ */
+inline constexpr std::array<jump_poly, 256> XOSHIRO256_JUMP_TABLE = {
+    jump_poly{0x0000000000000002, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000000004, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000000010, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000000100, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000010000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000100000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000000000, 0x0000000000000001, 0x0000000000000000, 0x0000000000000000},
+    jump_poly{0x0000000000000000, 0x0000000000000000, 0x0000000000000001, 0x0000000000000000},
+    jump_poly{0x9d116f2bb0f0f001, 0x0280002bcefd1a5e, 0x04b4edcf26259f85, 0x0003c03c3f3ecb19},
+    jump_poly{0xc7327d130e34b489, 0x81f675e7a4ef7d84, 0x6dd49b656055c9da, 0xbe7976372e930435},
+    jump_poly{0x060106bbbe4ff028, 0x1be1d76854ddda93, 0x8456faeb6230d984, 0x65507439cf43f0e2},
+    jump_poly{0x876c2301125a85c0, 0x15fe822628b16f04, 0x3c8ca36ec9a74fa7, 0x51edef31819e01ff},
+    jump_poly{0xd7f4e8da7e228b85, 0xd638d47ec5bcf595, 0xaa6eb691cbf9ce10, 0x0f41cce3698fad39},
+    jump_poly{0x669da12373880674, 0xb1df898a4a6f1548, 0x32104b94fe2534d3, 0xda66e09e52b341d1},
+    jump_poly{0x4f20eb915e780231, 0x3886af219b885248, 0x023ecbee3f717fce, 0x3cec2c375bef249c},
+    jump_poly{0x449b3ae793888c8c, 0xc3ce2f061f077568, 0xa69393ac0d837e54, 0x1a9dcf944ae47603},
+    jump_poly{0x7e89ac5ca2fbf2c7, 0x92ae7ca370c0bf6b, 0xef43beaa06f02fb8, 0xd87f8ce230817a21},
+    jump_poly{0x6c4adbe18e29df8a, 0x54adade3697d477f, 0xf0c168649cdba61f, 0xbd53027696368bbb},
+    jump_poly{0x1a673fecf40e36b8, 0xf2c602feb5ed002b, 0x1ea49b5067452594, 0xf78a97c0d882cd37},
+    jump_poly{0xef4606da56224c47, 0x770323eab8d437bd, 0x590923d02ec52531, 0x1639a36e0968e3c5},
+    jump_poly{0x31d9d05c5d95f3cd, 0x7cde241817a3ce0f, 0x2f679f694a74c76a, 0x8b3919a9d298a415},
+    jump_poly{0x6b6622ae9590047a, 0xeace6d3840b79fef, 0xd9b36372fd70ec83, 0x624eb7b63c322e71},
+    jump_poly{0x1b91fd9ba98d9e23, 0xeb2c7e29d3c33d2e, 0xcebbfd2ef4e9aff4, 0x2bac5517c9469796},
+    jump_poly{0x01f356e6083fe109, 0xba0ffb6562a3a28a, 0x657a6b736317866b, 0xfb678bd3e5dac186},
+    jump_poly{0xc5461100f197a7e8, 0xe46916a1426b676d, 0xf3469dbb4fe25d26, 0xf5c010059e83bc3f},
+    jump_poly{0x22dc028cb8c259dc, 0x3eec4eb6495ce5aa, 0x5de3e273dc7b84dc, 0xe677849e207f6afd},
+    jump_poly{0x832d418900fd3b0f, 0x114e10c3b7c36788, 0xdf2332a778d9c8dc, 0x0d19a1bdceb7522c},
+    jump_poly{0xe2d0c9c10e8d7157, 0x8b3ed7c37e947e38, 0x98273f4d18ad073e, 0xf38f7e750d5f4f2a},
+    jump_poly{0xe7109518f3510d70, 0x34f30137eadb90b9, 0x6d48dd206d56754d, 0xafa9e3fe5fea15c3},
+    jump_poly{0x8ee774f507ec9f39, 0xd7c26ebd51ecf6c4, 0xc76a456d998ddc4c, 0x1ca234ff511bcb05},
+    jump_poly{0x4905d8261158a7bc, 0x352f8b5d2137de83, 0xe0e9fa345826626d, 0x3e667662caa54d16},
+    jump_poly{0x272a32be4bac7912, 0xe1185a166bb38173, 0x82b9aa358fe2ed58, 0xa43d37468704d536},
+    jump_poly{0x58120d583c112f69, 0x7d8d0632bd08e6ac, 0x214fafc0fbdbc208, 0x0e055d3520fdb9d7},
+    jump_poly{0xd9eb3e225a9ebb7d, 0x5d33a22177777716, 0xffed2ffbcf857b42, 0xa1b7ebf581a90f09},
+    jump_poly{0x3a433a5cff8501f4, 0x0c2e65cfa3a44f3b, 0xa59f09ab33f1c8f4, 0x0afe97309a7881b0},
+    jump_poly{0x635e9c6882ce5c6a, 0x53a34398808ef457, 0x94295f82142a68bd, 0xc1cdf918a717c897},
+    jump_poly{0x1a2c804af78e2ed4, 0x306c4d371040af1e, 0x63d3f9df102dfa7e, 0xac7fe0806aecd6c8},
+    jump_poly{0x7743a154e17a5e9b, 0x7823a1cd9453899b, 0x976589eefbb1c7f5, 0x702cf168260fa29e},
+    jump_poly{0x2edfce1b0667bf3f, 0x68ef5242f2d9c5b2, 0x03803bdb9ea7d7e8, 0xc4671ec91b902bae},
+    jump_poly{0x4d2c07a0b0f7980f, 0x0af3e6140fcff185, 0xaf03bea7ea7109fd, 0x755b16e231d1e7c9},
+    jump_poly{0xd24b31ab16542ea0, 0x13a31dc36460a3b0, 0xeece73d85df18361, 0x51fc9b8eb1974e73},
+    jump_poly{0xec9c79ebd62a4a91, 0xa374bf9822d660aa, 0xde49d57f23fdecb5, 0xfb43cf1f4658ae1b},
+    jump_poly{0x7602414a37bf1c08, 0x48b8b0570f008a91, 0x3aa3d49368a9c562, 0x9b48db8907d00f97},
+    jump_poly{0xf7569be74f972355, 0x9e11e129fcced20e, 0xa6994477ec2d6d85, 0x8ec1a9dd27957370},
+    jump_poly{0xc223943200d6e8a0, 0x82f1f8d3ebd9baff, 0xf6c987b8eb4f76db, 0xba8b1a7be4521854},
+    jump_poly{0xe226bff99e7f9d4f, 0xf6faaff592dc08c7, 0xbad2e3487a438d37, 0xa8f7de3ed772d2d2},
+    jump_poly{0x6322f95d362137f1, 0xb006241469247fbd, 0x181d6c749bfc7e7b, 0x3c63f6f95954e65e},
+    jump_poly{0xaa878816402dab5f, 0x69811136f33b48fa, 0x0df6566ff12f17f4, 0x81f450881b843692},
+    jump_poly{0xf11fb4faea62c7f1, 0xf825539dee5e4763, 0x474579292f705634, 0x5f728be2c97e9066},
+    jump_poly{0xf18ac1f5eac5120e, 0x36d6c9bc4bcb56f5, 0xec104b9942b386be, 0x5ff98760441a364c},
+    jump_poly{0x12b825906ddc86af, 0x168b84ac131ea856, 0xd1c440c801f3cddf, 0xb01e1ff4eb0b05f6},
+    jump_poly{0x5696a9ed59ffcbe3, 0xb5bb35fe03c3158a, 0xf1ab1bce1577ad4e, 0x140bd5e4e00ffdaa},
+    jump_poly{0x61507225f9f0e0fa, 0x8eadd052a304405f, 0x49c2df736ebe9c68, 0x5177664e86d5e31b},
+    jump_poly{0x87aac36cc0c1abae, 0xca120d886e8fdf33, 0x5b8d5f58ce3357a7, 0xa93a7aadeced9cd7},
+    jump_poly{0xd4eb47064a9ac499, 0x2b95939579346af1, 0xa6f4a2ea423cc2f6, 0xd5372758d87157ef},
+    jump_poly{0x549bf83ef12aebc3, 0x56df3905d6712eed, 0xb86994c9cb3059a5, 0x7e0b8abe53e950f8},
+    jump_poly{0x0b32b0dbe851dd9d, 0x27cc40c1479b95df, 0xc405c1164a3a6d49, 0x0888f2c33969763b},
+    jump_poly{0x920a67ed72aa1155, 0x7e5cbd2047cefb5e, 0x31acd0e23e87d9d3, 0xfecb2b39fb96f078},
+    jump_poly{0x9841d4c5510c4700, 0x97a6c4a0d2cdf9ac, 0x82f88d9e6b9b17c0, 0xf643cc9255f06741},
+    jump_poly{0x30ac848541c0b04f, 0x55756dedb136961f, 0x65ba2fdf5fe59ed1, 0xe8e07ed05188af0f},
+    jump_poly{0xadcede280bb92b99, 0x6d885bb5321527a7, 0x04ad0ecd62544db2, 0x679b88958f3bbdcb},
+    jump_poly{0x84db0e338a94ce16, 0xaaee46b89b106201, 0xbbf25302a56d6131, 0xd10d621b74213644},
+    jump_poly{0xed3c94e03147ca9b, 0x31fbe8b0a2035587, 0x5083dee093b632b7, 0x6ff477672ddf72b1},
+    jump_poly{0x936ece877e64cc97, 0x22a36cdc0fda409f, 0xbae4d9a25a3928b9, 0xa9559a2368719526},
+    jump_poly{0xb13c16e8096f0754, 0xb60d6c5b8c78f106, 0x34faff184785c20a, 0x12e4a2fbfc19bff9},
+    jump_poly{0x69135f8ae4f3becb, 0xe9cd737204214bdf, 0x71c9cddcc21b4d96, 0x1e22c55ed04628f4},
+    jump_poly{0x43f19411729e47a3, 0xcdc2f8abc30facd8, 0xd3c646ca742cfd35, 0xb6e16802c1e5a473},
+    jump_poly{0xe1040fefa7016612, 0xcf7a45ddbd380c46, 0xe9121d42d889f1e6, 0x71583507471df592},
+    jump_poly{0x7dc73de451f84f31, 0xef00865ccdc62b40, 0x3481941c63b9723b, 0x790035ed5d8a5206},
+    jump_poly{0xb7fde9c10dde1033, 0xe2b26892066519e7, 0x1b2e1e5f58ca50e9, 0xc5245c9108c8303b},
+    jump_poly{0xf7e31117fca1fde3, 0xd0229895c9855019, 0x80dd958fc2ce8b38, 0x72636702af55f1ae},
+    jump_poly{0xf4fdf1938a08c423, 0x369b623ac732f278, 0x59970509d58afcb4, 0xaf24371b5a1a053d},
+    jump_poly{0xe38bd8d6060eecb2, 0x4f2a8443cc705e1b, 0x98aea009de1e6b3b, 0xc2a214d5ccfdc9cc},
+    jump_poly{0x779e326bea03051e, 0xfe60945b17507ff1, 0xb35a81ddfd74498b, 0x045c97103176ad4c},
+    jump_poly{0xf99f64a8eef50acc, 0x967c5d39bff598c3, 0xe54b1f90f1804a5b, 0x8c79d3fd0cd87d25},
+    jump_poly{0x5bf7c3946011203d, 0x00dc697c0ce8f5bf, 0x9b135f39cbd24442, 0x44a26649c72eaf79},
+    jump_poly{0x1fe0ce6e4a5fbfa9, 0x05063f82926b1050, 0x6f0bd8889bc16b65, 0x621f84d4c5b7d5b2},
+    jump_poly{0x0bd0d4953231dc02, 0x8cac609dd3f769ea, 0xa2ce3240999f0395, 0xafb60de4ef76f2d8},
+    jump_poly{0xe41a05c6d5ad6443, 0xb46e28d0dd20be9c, 0x5d5a93bb678d1ff3, 0x6d9d47d177fda8e1},
+    jump_poly{0x3750097bc18818df, 0xc05cb5489fabd6ba, 0xf671f175f29bd401, 0x69b492ad849876a0},
+    jump_poly{0x6c1a4d1bee4cfb25, 0x0355dab5aaada356, 0x5d23c239088b488e, 0x2c09ebb60b81941a},
+    jump_poly{0x85bc661b5fe4c77f, 0xa77d08c97aa93a7b, 0x1c4df4e6dc4daa6c, 0x3d8c3676399ece2d},
+    jump_poly{0x0d50032e0877ba29, 0xb12fec5cc6984936, 0x97595ce59431e3aa, 0xd6fc185137af1d8b},
+    jump_poly{0x49aa26e5d4bf7857, 0x754228fc68530845, 0xd5cace972fee73fa, 0x86b251394485c94b},
+    jump_poly{0x8d480422727ca5ce, 0xdfd675636a53a2ad, 0xbff33c810d4f1e62, 0xb0baae7f98b528c0},
+    jump_poly{0xb0908faa94bfc92c, 0x7d85e7cb6751bcbb, 0x6a4d1fd3bf02d558, 0x3fa865ff30ea93f7},
+    jump_poly{0xd0d6be52a69e58c9, 0xa789c54654ca7c28, 0x5aa4dacdc52add36, 0x3c3c2884d98788bc},
+    jump_poly{0x5f3f3b8fef0ed6b3, 0x41288120b4579cf8, 0x4c9ca45e4bc2a3c3, 0x15e0fed2f7bccfef},
+    jump_poly{0xd262b21891db8d4e, 0x53b8a4a16a46d7c3, 0x9c885317a50787eb, 0xa949942afc5a2f2c},
+    jump_poly{0x718aec6a573de99d, 0xc0a2019a1a152787, 0x4ea029ea5dbf8c1d, 0xfe740ffad9e17687},
+    jump_poly{0x07f145f47c78ac8e, 0x35e2e29698d7eb0d, 0x228277008b5fb669, 0x77a27a67f88f49e1},
+    jump_poly{0x6627da855e5050fb, 0x7c62ece20d8be011, 0x6648b4ef24a58856, 0x1029f062e580da26},
+    jump_poly{0xa9ffe6995923a7b1, 0x34092a8e98b795be, 0x6f17a03a6bc6a877, 0xa0d23922f4dc9916},
+    jump_poly{0x062e89b53f6cea07, 0x0ee2caf1df36f661, 0x35e67f142da25aca, 0x336f2f9401f82041},
+    jump_poly{0xbf67135726c63517, 0x93b549a81fd07be4, 0xd617e92e93ea4567, 0xa3a29886c86c3cde},
+    jump_poly{0x21ff06188c9cc699, 0xf9d3a86c856b8a26, 0xc51d91ed4856b46e, 0xfe0143fd314c9e7e},
+    jump_poly{0x148c356c3114b7a9, 0xcdb45d7def42c317, 0xb27c05962ea56a13, 0x31eebb6c82a9615f},
+    jump_poly{0x5d4da92b5d749ee7, 0xd8aed72f2c4c8d06, 0xd863413b92cae906, 0xc78709f4e0724160},
+    jump_poly{0xc72a478e776aa7e8, 0xe2ece3b6969fe76a, 0xf59e618faaebae8a, 0x43b4a1c47d75f54a},
+    jump_poly{0x85043fb7b5ec46d9, 0xb24feee905fd9032, 0xf018da68303dd3aa, 0x57f74d5c8e13eabe},
+    jump_poly{0x1fe7835e4087fe62, 0xa797dd2a234c782b, 0x6bef1c2cbcff5536, 0xbf7e526feafe9fab},
+    jump_poly{0x2b8e518ff5d4cf7b, 0x5aa27a4749244838, 0x75b4d7f6cc9f25e1, 0x944120083af78d61},
+    jump_poly{0x3d6f902c3475cabe, 0x1bf5aad8660b3dff, 0x1965ee22fd231ead, 0xa1d8b4c28aebb851},
+    jump_poly{0x8f55a96afe8c60d6, 0xc97a1beedb0cd181, 0x65e7e4d9e2832455, 0x9c9e175a184afb53},
+    jump_poly{0x652cb4ccd4073f0f, 0x74b6da57ea2bc33a, 0x0a65eef991740328, 0xb9d862913d6f7e40},
+    jump_poly{0x1045804fface6bf3, 0x10698e01c2ae9c87, 0xd4b46d9444c365a7, 0x82998b76e46a33d6},
+    jump_poly{0x0a2c871d4e66d5cd, 0x02416381d70e6c43, 0xf1a9cb543a0bfa10, 0x8da69514b40b00e7},
+    jump_poly{0xb79a9592b42dcf38, 0x4dc5ff02cd80ea1d, 0x83d4e917f16be77b, 0x27b45c44ee4a6229},
+    jump_poly{0x4d5d5691e346a117, 0xae1e5f3ff8b47720, 0x219d46c745e04de7, 0x3762beab010e60b1},
+    jump_poly{0xa26c20feb2ae9f7d, 0xb46fba890f1ca8f6, 0x634ad6497e9d5d70, 0x1cbf90cd7272db76},
+    jump_poly{0xb0c0f65d5e452c0d, 0x9b34b9c8c6c9c0e0, 0x4fb63d3b5eb99097, 0x5f46daf7953c1bb3},
+    jump_poly{0x7fafc3b0810db88e, 0xa08f672eaf81f898, 0x188dc353d2d4788a, 0x0127923940e883a8},
+    jump_poly{0xff09f37df22eab9a, 0xe903694ada9d6795, 0x9a5475c8d2fb2d20, 0x19809df824096ba1},
+    jump_poly{0x656c70a5f3f5c710, 0x861797e8573bfcd7, 0xe6a590ca622a3320, 0x7ea9fc3051e87b78},
+    jump_poly{0x6aaa9929398cd48a, 0x5ad3eec2014d42b6, 0x84d72b234e8a5479, 0x644a875145d5d51f},
+    jump_poly{0x6c738865ed73b377, 0x00659f02b37a017c, 0x203951cfd23e94cb, 0x6d2cc53f91af5f85},
+    jump_poly{0xf7af674289519c6c, 0x8bc10737770d137e, 0xbef3d95e4e54413a, 0xc0864662b10083e8},
+    jump_poly{0xf5238b0ff86d1867, 0x1d6286a155723d48, 0xeb185b3b61ef2507, 0xcecda49faf04bbfb},
+    jump_poly{0x644b243f9d056a3a, 0x99c6cd156b9744df, 0xa02ccbd8d031b5d5, 0x2732a7244a31e5dd},
+    jump_poly{0x25523b168236da8c, 0x75e9335039224b3b, 0xdf8f6390d609a5d4, 0x216f9077c64f36f6},
+    jump_poly{0xc291983aa3a3a178, 0x565c9f7a11c40482, 0xef5b7611f90b7c08, 0x56ab0ca212a8d012},
+    jump_poly{0xb400d4604c1d59db, 0xd73fe72ba2d98892, 0xc7abdfbc652abf3e, 0x45c2ad3649667c04},
+    jump_poly{0x9bb885cd5aa00a8c, 0x543fa081564a326f, 0x058b3d55bfaa4aad, 0x91c1510f9b6f2ef8},
+    jump_poly{0x7a3e03325fb2eeb7, 0x09cf7d85a86c1a90, 0x53c8dfba6c9aacae, 0x9d6ef09217bf59b7},
+    jump_poly{0xe98651fa6fb0337b, 0x0bbfd59ed2151f31, 0xd8289b4ae487d7e1, 0xa1a3090ef816c214},
+    jump_poly{0xaeb33557c76543fe, 0x1b18a0517cea386a, 0x56e93ecb5b361995, 0xaa72e405fb26c80a},
+    jump_poly{0x46555cf90fc3d1cb, 0x57c811875c625284, 0x8397aeedc528c3f0, 0xfd4d894c8f82680a},
+    jump_poly{0xeacbd852b93bd815, 0x4dd8801baa92fdda, 0xa50845f0f4301985, 0xd46cb8565abad18e},
+    jump_poly{0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c},
+    jump_poly{0x8cfe9bd9ab71d992, 0xccfc8ca2814de79e, 0xa5a28cccb37dba5b, 0xa23e49ee6f1a7a8d},
+    jump_poly{0x1b2a94a672a48c05, 0x5e38f4fbb6fcda72, 0xca8a45310219dc67, 0xd4e9921bccb8090b},
+    jump_poly{0xf30974a2b1dbbb71, 0x34cd4cc8228d74ac, 0xfa0587a90f717438, 0xee658f69deb5df26},
+    jump_poly{0xb42bd4670583b289, 0xd2c0d8e0c8a2fb9b, 0x2573e3218d8bb7da, 0xd7aaaf48aa459c58},
+    jump_poly{0xf6a5ab84efb67883, 0xcc7efdcfed1ac303, 0xd82be75b83dbc2d0, 0x8fd437c01abeab24},
+    jump_poly{0xc85ee5171484f5a4, 0xedc8b8d02a22310b, 0xb0b87a330b854c8a, 0x7d16742eceb4d5ab},
+    jump_poly{0x4298ba0e862a6007, 0x4157dc48443e3565, 0x13c97c0891cab48a, 0x6533981804b420ea},
+    jump_poly{0xee5f5a6f02dfe47c, 0xedc28c89cb341660, 0x613b2ed9f0acc107, 0xa1ee335d14807ae0},
+    jump_poly{0x5ec3050c6b43565a, 0x4b26f71c1fb1b47b, 0x0531513e8e0ac706, 0x799d469b2145a8a3},
+    jump_poly{0x34f0a6799020283e, 0x7123f2290a1f413b, 0xb6acd7be4906b73d, 0x6007bb31ec5a2964},
+    jump_poly{0xaa0711c54877febd, 0x54fe6df4cff0db73, 0x7e42d6f544840499, 0xec907801890a47ab},
+    jump_poly{0x03833e601d82a673, 0x3ec263f5c999196e, 0xd8c4367e574ab160, 0x964e9d188c16508e},
+    jump_poly{0xd64f3f2aaf8f2171, 0xf524fd4408357a5c, 0x15ac212f3b861b5a, 0x24d9ba21277dd8d8},
+    jump_poly{0xfe9b778d7d1ca2de, 0xbbe0e2c0c44b2e1c, 0x17a7af3e97d8c402, 0xf89354cfe1e6b5fb},
+    jump_poly{0x695cf225704e767d, 0xf4873d277cd1ab72, 0xaad8c318bc459cce, 0xb89526857566cd94},
+    jump_poly{0x3dcd32f39276a95f, 0xc51212c8b1aa2787, 0x962c90a866ea6719, 0xb81875d0f4f6f253},
+    jump_poly{0xb43cf8e4eaf8e068, 0x1c554e97b2277f47, 0xa5a140826c351d07, 0x11495a1b200d4eb8},
+    jump_poly{0x417b73b324735d32, 0xff957b6f55288048, 0x05af69bf1fb82891, 0x3e53bfa0db28e110},
+    jump_poly{0xb6c7a6004612889c, 0xfdb3f4ea18f0a56b, 0xd3da65e82bdd39e2, 0x48f6214560239b46},
+    jump_poly{0xf1267ba0ec3c645e, 0xd9dc0929a54fea75, 0xec60b640d685171d, 0xde364ef64a484f59},
+    jump_poly{0x2761cbab38e0f580, 0xd7f1c5ade3de404a, 0xcb6286958a9af01a, 0x2b29c7d3ef18d3b3},
+    jump_poly{0x5a5ce93f67a3cdd6, 0x547db3576511edc2, 0x99455c744595c01f, 0x6a3b6a431109e3d1},
+    jump_poly{0xafd80c1c832a739e, 0x0d9d73da9f40f374, 0xed1d0a619aa60748, 0x00d2333b0c03f620},
+    jump_poly{0x11428ceb13f2cc2c, 0xef46e42368baead3, 0x2a47bd3fc39081da, 0x3f03458e0273439b},
+    jump_poly{0x47558e815c898e8b, 0x9f8160e9d0124398, 0x0fdcfd4ab0f5afee, 0xade2626c292a2a9f},
+    jump_poly{0xe848ff06d72a9252, 0xf8be2d3d6ce206b0, 0xd84fc5f798c1a55e, 0xc35abe5cebab1ba4},
+    jump_poly{0xb0dd0edb19af078c, 0xee1d857a675ca074, 0x60ef7116e6f3c1e0, 0x7c25b2c3282fb730},
+    jump_poly{0xb51a19064886308a, 0x6b590805d407e77e, 0x57059d3707ee283a, 0x6298f48fa13cc12f},
+    jump_poly{0x4f1102acb29c3230, 0xcf69cee6182fa164, 0x1780be415c86b5d5, 0xab5d0760d1fe77dc},
+    jump_poly{0xc639b7c24b26ef11, 0xa57d650a8007d505, 0xd81275131f4f91f8, 0x10000e5f7bf7a58b},
+    jump_poly{0x295b23eaa04478ed, 0xf1d3279f36823213, 0x743eedc2ede6d478, 0x09d89163f581d1e0},
+    jump_poly{0xc04b4f9c5d26c200, 0x69e6e6e431a2d40b, 0x4823b45b89dc689c, 0xf567382197055bf0},
+    jump_poly{0x09f16c9da06c8a66, 0xf32c270b20ce5f38, 0xbe61763d20685d37, 0xda01b157a2b021e9},
+    jump_poly{0xc6d70a8c6aec7778, 0xaccd356978aafc8e, 0xa1fbf40a9936c15d, 0x9d7c0c2cf565896c},
+    jump_poly{0x90c526d9d0b6773f, 0x327a229ce1248578, 0xfbdcc8828b2c1889, 0x592056e6bbf026f6},
+    jump_poly{0xa14aaaccc2890705, 0xe63e390ab5f8a1a5, 0x0fbd392d992b9686, 0x746ea463d01f96a4},
+    jump_poly{0xd8cd74de1850f135, 0x441424d88baa1859, 0xb4bb676b08602d23, 0x4d1dc582c66946be},
+    jump_poly{0x2adbc6211da0644c, 0x994b90f8d7149b3d, 0x4b145a211d1fdfdf, 0x621c1b93e8fa1183},
+    jump_poly{0x2fd0c3d604d53cdf, 0x340889c14a3c5736, 0x7bd5128045929790, 0xfaf3fe8684e4e611},
+    jump_poly{0x01e53e1bc659d517, 0x5f15699d4848bfcc, 0x6d8bf975dcc01074, 0x4a55ccb047f7ed1f},
+    jump_poly{0x71ce8d56b9692c38, 0x629372507db35e61, 0xefcb70ac050d5190, 0x929a14fdb0efb0b5},
+    jump_poly{0x27d627035f8c74a5, 0xe890fcbab799d186, 0xde5841dcae8e37bb, 0xcf9e9a1026630265},
+    jump_poly{0xb405010a26f11c18, 0xfd3a5a8b24565256, 0x9d53ec478a607c58, 0xbfbcf2e3dee7abfa},
+    jump_poly{0xb072a316838de4ee, 0x8f148500f69fe8f8, 0xbc2ad4d4d5a4ecb8, 0x20d9430de74248c9},
+    jump_poly{0x732bd9e5c94b916a, 0xa0851e63a9ec247c, 0x63eb42892a0f4361, 0x6db40995b68e4c68},
+    jump_poly{0xe87d88258b7992ce, 0xb38ada6d1a5427ba, 0x29f4387fbb3eebe2, 0x08543e7ab4077f43},
+    jump_poly{0x6735bb34738c34f7, 0x0a1db90231a55a32, 0x7f05b87543072eb8, 0x2281c456455c4a6d},
+    jump_poly{0x053ff7e4e8581163, 0x0b4df9e68366344a, 0x259022fe05f4023e, 0x2432aaa71d816e63},
+    jump_poly{0xfc89e47923390d01, 0x81690de70406c5b2, 0xdcdf361320fa2c0b, 0x065e8192b0d9e2ab},
+    jump_poly{0x54ae81c77079738d, 0xe3da1faabf2f681d, 0xfac68c11fe1e596c, 0x6f46880c9915650e},
+    jump_poly{0x9350f3f8897dc5cc, 0x3ac1fea4d54d0710, 0x70f4ef60d5dd3890, 0x8de6f3aa90cec548},
+    jump_poly{0xe7b23f10622b3386, 0xc22f28a3d0afc80b, 0xcb5512bde4e7bf59, 0xf930e902851defa3},
+    jump_poly{0xcaefa30f55ce5c0f, 0x7bf0fe15bdc9337f, 0x7a55e55bbd72fb81, 0xb05640b794289f31},
+    jump_poly{0x30121e7a60194d6a, 0xb8b27bb7572d2871, 0x61d6cf653e616a08, 0x0fa65f166fbb0db4},
+    jump_poly{0x646fe4bfa600d564, 0x3444a78d93dffc9a, 0x1c46fb7ea0484857, 0x7a974830be953c4a},
+    jump_poly{0x0ffabb6c5ce8d644, 0xbe489e3f8ac41534, 0xb8f35b514eb14767, 0x7691957a691df817},
+    jump_poly{0x5b16024d0563a65a, 0x83f997e75e88067f, 0xa9c11c5aaf2cab97, 0x57f44892a2ad86ea},
+    jump_poly{0xa6c7eee290c62375, 0x7fe5c232f064f464, 0x947c9b3af027e791, 0x6062e8c7dc309cb2},
+    jump_poly{0x038e07e40a2812e1, 0x52a29a371c84710f, 0x4c5bac1c57856ed7, 0x2629bab11c98b6ae},
+    jump_poly{0x637242c48b99b633, 0x3e3494a05f161ecd, 0xc3f6fbf07e464327, 0xaaa38210dde97c64},
+    jump_poly{0xc4d01c7eb078fd29, 0xc188ca2c76798705, 0x81d165297d239d2a, 0xd6e3b368fb2a3110},
+    jump_poly{0x7f90ffb775c02726, 0xacfe2b03b09803d0, 0x5a70368075759194, 0x6309de7dbb3bf59d},
+    jump_poly{0xf0f03027dfdc22d5, 0x902b0ee66222acc7, 0x78a3e873f00291ed, 0xdb9d6b2d354321b4},
+    jump_poly{0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635},
+    jump_poly{0x85d1837e6f0cd3fe, 0xa4b0488571edcb9d, 0xe9edb73cb3e9fb7c, 0xba70f1bd97fc40b0},
+    jump_poly{0xac54fa504c60e306, 0x0b893c16e4a7f3b3, 0xaff90eda09ea8b4c, 0x3727c275522644a7},
+    jump_poly{0x302eda308643ab47, 0xc9a202b2322bb7f6, 0xd4483ff9a9ac5a23, 0x574e4d0093e3a2e4},
+    jump_poly{0x261882d92ec8429f, 0xabfffe7ac9ea1612, 0x236417db3b031424, 0xec6aa16a8ffc76fa},
+    jump_poly{0x52f6a62700009087, 0xf7c39d8fc76906a3, 0x285943d7fb75d765, 0x88e5349d50f3ddef},
+    jump_poly{0x3facc68ed0053ac4, 0xfc0c646fb82afceb, 0xf055378c576c5c9a, 0x21588c86cc534c29},
+    jump_poly{0xfe596054913ed407, 0x3d38ff4fc965c1fa, 0x776751b126655d13, 0x443c1363fd5c7d43},
+    jump_poly{0x1a672a03c71adc2e, 0x6217b3306e3e9557, 0x163160efcad9c046, 0x5243e79672334390},
+    jump_poly{0x58ce1e7d6ea9281f, 0x5348b64c107873b6, 0xdabe97e1dd9a59c1, 0x2dcec71c419baa62},
+    jump_poly{0x955659c7b8793ecf, 0x37fae57370f8bc19, 0xfba1683b54b1e0f6, 0xe91553475948d23e},
+    jump_poly{0xbb5b5c8aa1ad89e1, 0x9d7c00c8471ddc07, 0xa910bdeff21ce218, 0x540fca0570720eb7},
+    jump_poly{0x0612914f1b46c912, 0x6d8abce0cf641cfc, 0x32f22fb19ac4550b, 0xc4b65c3551c83c69},
+    jump_poly{0x536e6114e4189cfc, 0xbe100596c8da9541, 0xee7eb44f2fdbd1b8, 0xb1170d0754beeaa4},
+    jump_poly{0xbeb789dbbc4ea209, 0x267d7103ef9f83a3, 0x93f548c2cab0a32c, 0x45cac579389af5ca},
+    jump_poly{0x65ceb6cde220e757, 0xd6f9074a4c2732f7, 0xa8e0425b0d01cd1e, 0x2b75c5d185461341},
+    jump_poly{0xafbacb099d1967bd, 0x1af87374102c1031, 0x470868184fcc3f5f, 0x114dcbb43b155057},
+    jump_poly{0x5f98e9b5ad62427d, 0xf27e722d27743cd9, 0x7ebe95d47cd1daf2, 0x1b98494373c20b8a},
+    jump_poly{0x8f1d0f5ec26521a6, 0x036e9886f63c9933, 0x4ac6fab0688e4ccd, 0x93d03eea25d1d816},
+    jump_poly{0xdd4e745e4412a26a, 0xbb62b24404a1be96, 0x9c227b5ba376faee, 0x08615908bcc4c8f2},
+    jump_poly{0xebe0d315a9cb279b, 0xc7a967d45d82bbca, 0x64d85cc844957794, 0xf6a1ef6a7d3b2545},
+    jump_poly{0x29bfb1bdc678fcbe, 0x611e5aedd44a4fd4, 0xd188547deb3f0136, 0x2b8dd348e0f767ae},
+    jump_poly{0xfad25fa87d091580, 0x5154a018eba8e309, 0xbd9b522fb9f15d0b, 0xfcd653bc999d276b},
+    jump_poly{0x29c79a4cedb3baf2, 0x946592914b67e34f, 0x04921932aaf82150, 0xb36394657868f06e},
+    jump_poly{0x6cbfcd64bf69402c, 0xca9a2b49a6e6b16d, 0xba835279ffb6a358, 0xfbdf21da0bb9add0},
+    jump_poly{0x23436782d086ca23, 0x0cf66f05d413a46d, 0xbb90914a9c9871a3, 0xedcce16aeb59e5ad},
+    jump_poly{0x130e23fa572004a9, 0xf9ce20dec18c4b44, 0x5cea7b8a1ac11de9, 0x6608d757c7d36be3},
+    jump_poly{0x70c7a48f09b95bb9, 0xd03a1ed309668f2f, 0xa955e448a10873d4, 0xd5d4c6699513858f},
+    jump_poly{0x72015cf80ce336f4, 0x619c9d98f6f33bcb, 0x59f1b7e5d5fbfdc3, 0x16cac53fc2905146},
+    jump_poly{0x5f340fcb5be19401, 0xce2129cd34ae493a, 0x14690cfa36c329ed, 0xc6e96787aedc5c40},
+    jump_poly{0x7ad9f632881e960f, 0xb8052dcca0e13395, 0xd457241f6a9863ac, 0xf8d2e75e66d53d83},
+    jump_poly{0x23336699f63c8e45, 0x33b2e33e1d4e5bdb, 0x37fdeee585fdcd8e, 0x9a5144da7f765fd8},
+    jump_poly{0x0c7840cbc3b121ad, 0xd317530723ab526a, 0xf31d2e03157bc387, 0xa2b5d83a373c7ac2},
+    jump_poly{0x47b3063d7d254e4c, 0xea7c37e6ee511ddf, 0x0b50e1ab78926eef, 0x3ff3ff3e9168fd71},
+    jump_poly{0x2c56cd0f48e4587d, 0x4c77464d80c69c23, 0xcbbf60dca92d32de, 0x6021ef776e85bae8},
+    jump_poly{0xe3521a7cbf37c2a1, 0xa5130e508b35bcf2, 0xf308dc3d84a999f1, 0x601a299a0bbe06e1},
+    jump_poly{0xde3439ebd3e4fcef, 0x5b1dcb68d8e77159, 0xb00b42e8b528bff6, 0x9b121812c345eb87},
+    jump_poly{0x07eb2f053805555c, 0xa7f205f341a367e5, 0x5d5d85d95fc59359, 0x057f094f242a8701},
+    jump_poly{0x2e990fa0b86f494d, 0x5d3d62bea3d0c982, 0x2be3af695f4ca02d, 0xcc92a4a3521dba28},
+    jump_poly{0xdd8082fb069d5ee7, 0x7dc029224f1676fb, 0x65e7ab91abe659d0, 0x04fb453c7ad02c02},
+    jump_poly{0x90b632d403b4513c, 0x0f186a740aaa16b5, 0xb93a0637f3af87f7, 0x3910377fe08e48a3},
+    jump_poly{0xcafe235cd7fe7ef0, 0x5f1e003e1d3a7daf, 0x7f5505759890b722, 0xf2f7c89f1379cf05},
+    jump_poly{0x5a252ed34d09cd4f, 0xe8f150b98011d5fe, 0x131bf6c475e29db1, 0x07818fb0f5b0ff11},
+    jump_poly{0x0441124ba35b2f58, 0x9d4b489eae71f97d, 0x50fa45528d32be3a, 0xce8349b10acdabca},
+    jump_poly{0xade4816bccf327ac, 0xc14a5bff8ad78a52, 0x4cc84cfe14a77c57, 0x183c124cf3d64e0b},
+    jump_poly{0x4dbeffc02ebf0904, 0xc3b545955dbab803, 0xb7fa51c1fe79c53b, 0x688b6947de87d7e9},
+    jump_poly{0x2f5b386d0a416de5, 0xdd87232f5cca256a, 0x7ba82a958b9e6a9a, 0x2c55c09810b2f548},
+    jump_poly{0xf75f6b5cec404580, 0x8f0aa8baea9011fd, 0x1221c7c14b1db112, 0x1d8ee30bc2f88017},
+    jump_poly{0xd18562b8cfa0694f, 0xba5487bfcecce199, 0xde5eb81978735ad0, 0x33a1c005e4ccc286},
+    jump_poly{0xdca75eca4474cbe5, 0x0388cd9f71f314e3, 0xd4699ceb082644c3, 0x1271254993f074aa},
+    jump_poly{0x1c493fa07fa74dcd, 0xb59cd5fcb429c2a9, 0x3e550b09e8493d84, 0x516fabbf03d78293},
+    jump_poly{0xe6d4233d77a1930d, 0x00424fa384fbe6ee, 0x4c636e19b68da5af, 0x140c9813f8542a71},
+    jump_poly{0xbea7da1e4eabfb2c, 0x271441e275aceb6b, 0x00ef11ecb78fd7dd, 0x3564fd80ea4578c1},
+    jump_poly{0xaf64e36a267033fd, 0xb86eb7a249850b0f, 0x9a888e9f318a8efe, 0x734c58deea6bd24b},
+    jump_poly{0x30765a1ca7975996, 0xeb222e5b91776dec, 0x27e74ceb6b5c8a44, 0xaea3b00f90869cf7},
+    jump_poly{0xc41171736f6127bd, 0xbbe041e1a6089baf, 0x623b0619adb26e6b, 0xc119ec86604ac1de},
+    jump_poly{0xcc48029f3903aa23, 0xddf1854fc56579d8, 0xaa69f6bbf9bfebcc, 0xfc1385169b03eb72},
+    jump_poly{0x409b2e169eb1bbfa, 0x771b06055d169793, 0x47bf1babcb2b82f5, 0xace055588e22fd26},
+    jump_poly{0x01731918ee54abd6, 0x759a7ec7f27f3792, 0xb4d6164f3e9d573e, 0xb604b97729a3c214},
+    jump_poly{0x1a22142b7cc54bcf, 0x43461d4569c23fa4, 0x8d7ff0d4f4fb9470, 0x1a825a9fac612b54},
+    jump_poly{0x39da610606e0e771, 0x4566a69758dd856d, 0x1c60396a2c51aa0b, 0xf418b6ce5a857da3},
+    jump_poly{0xdfca68648b28c5af, 0xb56437fb2b753802, 0xebb82aacdf6ca80d, 0xa170e108788db093},
+    jump_poly{0xde5b821c4a3d86e8, 0x861fffe004c85aca, 0x3413838181a6096f, 0x460de3bdbe1cb3ac},
+    jump_poly{0x5b7b491f49ccffcc, 0xae7f8689b0bbd6a0, 0x13865b737d9739bc, 0x6c132e0c5374c916},
+};
+
+static_assert(poly_equal(XOSHIRO256_JUMP_TABLE[128],
+                         jump_poly{0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c}),
+              "2^128 jump polynomial does not match the reference jump()");
+static_assert(poly_equal(XOSHIRO256_JUMP_TABLE[160],
+                         jump_poly{0xc04b4f9c5d26c200, 0x69e6e6e431a2d40b, 0x4823b45b89dc689c, 0xf567382197055bf0}),
+              "2^160 jump polynomial does not match mid_jump()");
+static_assert(poly_equal(XOSHIRO256_JUMP_TABLE[192],
+                         jump_poly{0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635}),
+              "2^192 jump polynomial does not match the reference long_jump()");
+static_assert(poly_equal(poly_mulmod(XOSHIRO256_JUMP_TABLE[254], XOSHIRO256_JUMP_TABLE[254]),
+                         XOSHIRO256_JUMP_TABLE[255]),
+              "jump table entries must be successive squares");
+
+/**
+ * Returns the jump polynomial advancing the engine by n * 2^shift steps, using one multiplication per set bit of n.
+ *
+ * @param n The number of strides.
+ * @param shift log2 of the stride; shift + 63 must not exceed 255.
+ * @return x^(n * 2^shift) mod P.
+ */
+PRNG_ALWAYS_INLINE constexpr jump_poly jump_poly_for(std::uint64_t n, const unsigned shift) noexcept {
+  jump_poly result{1, 0, 0, 0};
+  for (auto i = shift; n != 0; n >>= 1, ++i) {
+    if (n & 1) {
+      result = poly_mulmod(result, XOSHIRO256_JUMP_TABLE[i]);
+    }
+  }
+  return result;
+}
+
+/**
+ * A polynomial over GF(2) of degree < 128, stored least significant coefficient first. Jump polynomials use the same
+ * layout as the reference xoshiro128 jump constants.
+ */
+using jump_poly128 = std::array<std::uint32_t, 4>;
+
+/**
+ * Characteristic polynomial of the xoshiro128 linear engine without its leading x^128 term. See
+ * devel/xoshiro_coeffs.py for its derivation.
+ */
+inline constexpr jump_poly128 XOSHIRO128_CHARPOLY = {0xde18fc01, 0x1b489db6, 0x006254b1, 0x00fc65a2};
+
+/**
+ * Multiplies two xoshiro128 jump polynomials modulo the characteristic polynomial.
+ *
+ * @param a The first factor.
+ * @param b The second factor.
+ * @return a * b mod P.
+ */
+PRNG_ALWAYS_INLINE constexpr jump_poly128 poly_mulmod128(const jump_poly128 &a, const jump_poly128 &b) noexcept {
+  jump_poly128 result{};
+  for (auto word = 4; word-- > 0;) {
+    for (auto bit = 32; bit-- > 0;) {
+      // result *= x, folding the x^128 term back through the characteristic polynomial
+      const auto carry = result[3] >> 31;
+      result[3] = (result[3] << 1) | (result[2] >> 31);
+      result[2] = (result[2] << 1) | (result[1] >> 31);
+      result[1] = (result[1] << 1) | (result[0] >> 31);
+      result[0] <<= 1;
+      if (carry) {
+        for (auto i = 0; i < 4; ++i) {
+          result[i] ^= XOSHIRO128_CHARPOLY[i];
+        }
+      }
+      if ((b[word] >> bit) & 1) {
+        for (auto i = 0; i < 4; ++i) {
+          result[i] ^= a[i];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * Compares two xoshiro128 jump polynomials; std::array comparison is not constexpr before C++20.
+ */
+constexpr bool poly_equal(const jump_poly128 &a, const jump_poly128 &b) noexcept {
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+/**
+ * Jump polynomials of xoshiro128 for every power of two: entry i is x^(2^i) mod P and advances the engine by 2^i
+ * steps. The period is 2^128 - 1, so x^(2^128) = x and larger powers wrap around. Generated by
+ * devel/xoshiro_coeffs.py.
+ */
+inline constexpr std::array<jump_poly128, 128> XOSHIRO128_JUMP_TABLE = {
+    jump_poly128{0x00000002, 0x00000000, 0x00000000, 0x00000000},
+    jump_poly128{0x00000004, 0x00000000, 0x00000000, 0x00000000},
+    jump_poly128{0x00000010, 0x00000000, 0x00000000, 0x00000000},
+    jump_poly128{0x00000100, 0x00000000, 0x00000000, 0x00000000},
+    jump_poly128{0x00010000, 0x00000000, 0x00000000, 0x00000000},
+    jump_poly128{0x00000000, 0x00000001, 0x00000000, 0x00000000},
+    jump_poly128{0x00000000, 0x00000000, 0x00000001, 0x00000000},
+    jump_poly128{0xde18fc01, 0x1b489db6, 0x006254b1, 0x00fc65a2},
+    jump_poly128{0x78bd1157, 0xb488a061, 0x77900a22, 0x0e6834fb},
+    jump_poly128{0x7b0bf49a, 0x4152f743, 0x44118d9b, 0x38d2b436},
+    jump_poly128{0x845a09b1, 0x94b54ba1, 0x503a9ae6, 0x5f7aa4ff},
+    jump_poly128{0x0a1f06b6, 0xece7bc8e, 0x9ab5cf0e, 0x780f1aed},
+    jump_poly128{0x8fcff8d3, 0xd66b4f59, 0x07ee277a, 0xeb3e4975},
+    jump_poly128{0x8a2979a9, 0x60e16970, 0x8b01ce7b, 0xc9d1ce32},
+    jump_poly128{0xd4fd7b86, 0x57b8e99a, 0x3853473d, 0xee6262e1},
+    jump_poly128{0x7f0861fd, 0xa1ea4d71, 0xa2327f56, 0x668140b3},
+    jump_poly128{0x08a24926, 0x2fb44195, 0x6d916ade, 0x4e271317},
+    jump_poly128{0xd35f6af2, 0x4677800b, 0x7b28f619, 0x83bc62cd},
+    jump_poly128{0x0dfcd277, 0x46325cc0, 0x73a74986, 0x19b1cec2},
+    jump_poly128{0xb8c5a6a6, 0x97e03957, 0xba0dcd4f, 0xee16f96c},
+    jump_poly128{0x584b12af, 0x7316a7cd, 0x7a2ba910, 0x53fe0a37},
+    jump_poly128{0x08b50aa9, 0x78f5b997, 0xb6319395, 0x665aaf09},
+    jump_poly128{0x2d6021ee, 0x4f64a1a4, 0x0baac402, 0x14dbe352},
+    jump_poly128{0xff5111ed, 0x8cdd10af, 0x9596864e, 0x7584f641},
+    jump_poly128{0x2e4b8d20, 0x6c4fa858, 0x60a23f97, 0x6cbdae97},
+    jump_poly128{0x8fd0c1ad, 0x8d6d396c, 0x1b2a88a9, 0x5409d06c},
+    jump_poly128{0x070bbd82, 0x38dc68d8, 0xe2f8cff2, 0x1a377633},
+    jump_poly128{0xdeef0ad1, 0x306d9b7b, 0x75f46cc6, 0x6ea3c8e6},
+    jump_poly128{0x3b11252c, 0x1849dfcf, 0x83608b0c, 0x4271354c},
+    jump_poly128{0x7bc67b5d, 0x699cac0a, 0xd888887f, 0x88e6db6e},
+    jump_poly128{0xdc16b5e8, 0x2514ba92, 0x5de9763f, 0x11534240},
+    jump_poly128{0x19a6c40d, 0xfdd2110d, 0x9499febc, 0x686d0878},
+    jump_poly128{0xf7afe108, 0xf3be07b8, 0x730b948d, 0x0f8aed94},
+    jump_poly128{0xf460532d, 0xc59fb123, 0xa69c31b0, 0x5322c76e},
+    jump_poly128{0x51e478c4, 0xf5e2f2d7, 0xfe9852d5, 0x95e92935},
+    jump_poly128{0xb50d1e24, 0xb42d61cd, 0xbd400cdd, 0x09d372b1},
+    jump_poly128{0x6bdfad84, 0xc4c77b39, 0x2c1d0568, 0xe7536e87},
+    jump_poly128{0x1971c861, 0x9b2f7d00, 0x5bfabd1e, 0x4b9d0a59},
+    jump_poly128{0xfa529189, 0x29d8e7c8, 0x6e84af09, 0xd61683d9},
+    jump_poly128{0xafa34e18, 0x990b180c, 0x93d1a9a8, 0x2bddc822},
+    jump_poly128{0x4690ac90, 0x83f99607, 0x720d8d54, 0x8c913c7b},
+    jump_poly128{0x369ee447, 0xb2090283, 0x4e01096b, 0x5bcc6a1a},
+    jump_poly128{0x5bdef343, 0x1b6400d1, 0xe94b6db2, 0x789925e5},
+    jump_poly128{0x24768a59, 0x298bd3d0, 0x17709585, 0x44b170cf},
+    jump_poly128{0x5d874f1b, 0x170214ce, 0x0b14099d, 0x97cda294},
+    jump_poly128{0xe0d94af5, 0x53f78198, 0xf13a78ac, 0x48731cb9},
+    jump_poly128{0xccca1be5, 0xa64a2fb8, 0xe4558a6e, 0x3f16f673},
+    jump_poly128{0x0683f257, 0x6dd6ee27, 0x99a8d18e, 0xa3ef88df},
+    jump_poly128{0xcb56667c, 0x87a4583d, 0xdec5bb9a, 0xdeaa4ca2},
+    jump_poly128{0xcfa23a11, 0xf03580b0, 0x76e2536b, 0x8c8fab83},
+    jump_poly128{0xb6ff34b1, 0x16f8a8c8, 0x445b421d, 0x6157c701},
+    jump_poly128{0x4ec6d5de, 0x4cf8b920, 0x7e968b3e, 0xc9790225},
+    jump_poly128{0x35a81e7c, 0x3b0ce3bf, 0xc4c741e4, 0xdbcbeaae},
+    jump_poly128{0x816402f4, 0x1970e372, 0x8b80bd92, 0x479e43a8},
+    jump_poly128{0xddeca818, 0xc45c3501, 0x2253cc65, 0x0adcea84},
+    jump_poly128{0x729a959b, 0x880a3b77, 0x4de1459a, 0xb1afc783},
+    jump_poly128{0x61fb9420, 0xe6895754, 0x2f656668, 0x5d351d8e},
+    jump_poly128{0x09e626b1, 0xed521e9b, 0x48307882, 0x1f945c5f},
+    jump_poly128{0x7e887a38, 0x6247b9b1, 0xab5076c6, 0x8f5e8e11},
+    jump_poly128{0xc815942d, 0x3bef9fbe, 0x163b81db, 0xdd9db375},
+    jump_poly128{0x556b1be1, 0x570b130f, 0xef247f68, 0x81a138ad},
+    jump_poly128{0x744853a3, 0x485c1e3e, 0xae1e2311, 0x2ca9fb49},
+    jump_poly128{0x1615188d, 0x821fd395, 0xf2c0b4f8, 0x3e3e7fb3},
+    jump_poly128{0xfbb4ea2a, 0x0c437163, 0xeeeeff2f, 0xce994be3},
+    jump_poly128{0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b},
+    jump_poly128{0x9b802a8b, 0x794805ed, 0x5eb170f0, 0x7c0f7916},
+    jump_poly128{0x1a235895, 0x008078d6, 0x18eca90e, 0x5f292782},
+    jump_poly128{0xf70585fb, 0x4e0c5957, 0xbce250c3, 0x17a896ff},
+    jump_poly128{0xd2f6556f, 0x4a18286d, 0x3628d30b, 0x55160319},
+    jump_poly128{0x7a7faf9a, 0xa16bbafd, 0x0e0ce4fb, 0x3c7d15de},
+    jump_poly128{0xf28e46eb, 0x5de8d870, 0x99c73881, 0x138475d2},
+    jump_poly128{0x606a7785, 0x20e6d45f, 0x1b647514, 0x86eb7ca9},
+    jump_poly128{0x49666ecc, 0x3789d8a5, 0x6a660a93, 0xd71038c4},
+    jump_poly128{0x5128e049, 0x57728e18, 0x914d8f82, 0x770b4aae},
+    jump_poly128{0xf4c220b9, 0x204509e7, 0xf72abaa8, 0x87a9ba17},
+    jump_poly128{0xa770745c, 0x6305aeb1, 0x514fb641, 0x53f14381},
+    jump_poly128{0xef0c0748, 0x37c6bfd3, 0xce823c5f, 0x614b1be8},
+    jump_poly128{0xa7598b6e, 0x56acc333, 0x7616abeb, 0x444c7482},
+    jump_poly128{0x3b8e5872, 0x95b59666, 0x250a934e, 0xe1c8cd14},
+    jump_poly128{0x61af734b, 0xcafb7bef, 0x40320995, 0x52c3fefd},
+    jump_poly128{0x1e448b65, 0x3d04f456, 0x0065b6c1, 0x03ede698},
+    jump_poly128{0x999c0c61, 0x8f514f34, 0x208ae8a1, 0xa286055d},
+    jump_poly128{0xfd77b051, 0xdc74937c, 0x87c9caa7, 0x87c3b447},
+    jump_poly128{0x5cb18704, 0x3861888c, 0x421e95f0, 0x84702775},
+    jump_poly128{0x796e8f1c, 0x17386578, 0xa950e8b9, 0x5122b999},
+    jump_poly128{0xfd714f38, 0x6a60580c, 0x1de92dc7, 0x0a378a8d},
+    jump_poly128{0x920394a9, 0x59e5f42e, 0xa82afdb9, 0x29ec5ed3},
+    jump_poly128{0x9d4e636e, 0x91c22db3, 0xf24479f8, 0xb34270ee},
+    jump_poly128{0xf610cdc8, 0x935a2512, 0xa972efe6, 0x866bc548},
+    jump_poly128{0xf67e06e0, 0x830fc62f, 0x426d33f9, 0x36c311b2},
+    jump_poly128{0x82e394f4, 0x8e7ae190, 0x74da71b9, 0x2b8b3ac4},
+    jump_poly128{0x1b17a73e, 0x48ec363c, 0x9f3a8665, 0x1ba09ec7},
+    jump_poly128{0x5eee0d0e, 0x8a54b514, 0x268d5b56, 0x7c53cf77},
+    jump_poly128{0xecb31e06, 0x1def52d6, 0x5ec53d4f, 0xcb831ed8},
+    jump_poly128{0x196075bf, 0xc31db8fb, 0x2e624b60, 0xba7e0917},
+    jump_poly128{0xf59f8398, 0x7e8f6a86, 0xc9ba6afb, 0xc28a81ed},
+    jump_poly128{0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662},
+    jump_poly128{0xeeb0e0a4, 0x77133e23, 0xdc596025, 0x97f55fe2},
+    jump_poly128{0x9e9b45ac, 0x6d495900, 0x69ac41e5, 0x0356e935},
+    jump_poly128{0x407883f3, 0x547d4854, 0x9065599b, 0x662b6ac9},
+    jump_poly128{0x667ee2de, 0x8a954d8b, 0x6551c593, 0x2fcdf7e4},
+    jump_poly128{0xfb5707aa, 0xdaa2886a, 0xb233cd67, 0x0f4183ca},
+    jump_poly128{0x40dbcd63, 0x8e131a4f, 0x224fc251, 0xc64784ee},
+    jump_poly128{0x4f4db4ff, 0x7b6ea15f, 0xb29e13b7, 0x563b1ea7},
+    jump_poly128{0xbbd3ae5a, 0xebf544e9, 0xd28ec540, 0x5ce3332f},
+    jump_poly128{0xd39c61eb, 0x1f4dd02e, 0x95a4e90f, 0xa9ac90e8},
+    jump_poly128{0x790c846c, 0xd428b915, 0xd2660f23, 0x725dcd70},
+    jump_poly128{0x08eff263, 0xf39ff6c1, 0x513d8ba0, 0xca4404ca},
+    jump_poly128{0x26534b4d, 0xcf8db66b, 0x6102f64b, 0xf84f07e3},
+    jump_poly128{0xa88724c5, 0x0870d7d7, 0x181f9787, 0xdc3d5d45},
+    jump_poly128{0xdba73489, 0x0df0ec1f, 0x43005e2e, 0xd543edf1},
+    jump_poly128{0x6d73a1e7, 0xfe43b2a7, 0xf9a46a20, 0x58859a86},
+    jump_poly128{0xa683b6d0, 0xafc4a733, 0x1bf94979, 0xf904dd9f},
+    jump_poly128{0x2ee03d84, 0x75c74e3d, 0x96efbfd6, 0x7d256f6c},
+    jump_poly128{0x3ad0ebe7, 0x13f14f31, 0x796d291c, 0xa42bbfdd},
+    jump_poly128{0xce04ddb0, 0x1fc44a96, 0xb6a00a91, 0x8a6c4326},
+    jump_poly128{0x4e519967, 0x0d7a869e, 0x40012492, 0x6dc7c036},
+    jump_poly128{0x9e4d0a48, 0x6a86db67, 0xae852b9b, 0x6cc51ceb},
+    jump_poly128{0x5a52e97f, 0x77beacce, 0xb8030b6c, 0x5ead7c39},
+    jump_poly128{0x022cefbe, 0x7d88e3d4, 0x858bbdfe, 0x6b644146},
+    jump_poly128{0x90067a45, 0xb7ce03bc, 0xde4ac3e8, 0x99853a2c},
+    jump_poly128{0xe3a7ccf3, 0x35c9b163, 0xbb5b8048, 0x31ac55d8},
+    jump_poly128{0x8d4a33db, 0x169e96ef, 0x3788b4a3, 0x622cd32e},
+    jump_poly128{0x0513f190, 0x06f60339, 0x93608184, 0x4576959d},
+    jump_poly128{0x1a64167b, 0x05c745c5, 0xe2f50d3a, 0x8abc30fa},
+    jump_poly128{0x1741bb62, 0x3afd4ba4, 0xb268faef, 0x18bf57c6},
+    jump_poly128{0x39b7b7b9, 0x31bb1001, 0xd95f2dcc, 0x5686c6e7},
+    jump_poly128{0x54d81f7e, 0x0453f0fe, 0x3bef4345, 0x9d5e1791},
+};
+
+static_assert(poly_equal(XOSHIRO128_JUMP_TABLE[64], jump_poly128{0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b}),
+              "2^64 jump polynomial does not match the reference jump()");
+static_assert(poly_equal(XOSHIRO128_JUMP_TABLE[96], jump_poly128{0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662}),
+              "2^96 jump polynomial does not match the reference long_jump()");
+static_assert(poly_equal(poly_mulmod128(XOSHIRO128_JUMP_TABLE[127], XOSHIRO128_JUMP_TABLE[127]),
+                         XOSHIRO128_JUMP_TABLE[0]),
+              "jump table entries must be successive squares that wrap around after 2^128");
+
+/**
+ * Returns the jump polynomial advancing the xoshiro128 engine by n * 2^shift steps, using one multiplication per set
+ * bit of n.
+ *
+ * @param n The number of strides.
+ * @param shift log2 of the stride.
+ * @return x^(n * 2^shift) mod P.
+ */
+PRNG_ALWAYS_INLINE constexpr jump_poly128 jump_poly128_for(std::uint64_t n, const unsigned shift) noexcept {
+  jump_poly128 result{1, 0, 0, 0};
+  for (auto i = shift; n != 0; n >>= 1, ++i) {
+    if (n & 1) {
+      result = poly_mulmod128(result, XOSHIRO128_JUMP_TABLE[i % 128]);
+    }
+  }
+  return result;
+}
+
+} // namespace internal
+
+} // namespace prng
@@ -23,11 +23,14 @@ Vigna.
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
 #include "macros.hpp"
 #include "splitmix.hpp"
+#include "xoshiro_jump.hpp"
+#include "xoshiro_scrambler.hpp"
 
 #if __cplusplus >= 202002L
 #include <bit>
@@ -36,10 +39,11 @@ Vigna.
 namespace prng {
 
 /**
- * @class XoshiroScalar
+ * @class BasicXoshiroScalar
  * @brief A class implementing the XoshiroScalar random number generator.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro256++), ScramblerPlus or ScramblerStarStar.
  */
-class XoshiroScalar {
+template <class Scrambler = ScramblerPlusPlus> class BasicXoshiroScalar {
 public:
   using result_type = std::uint64_t;
   static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return std::numeric_limits<result_type>::min(); }
@@ -49,23 +53,29 @@ public:
    * @brief Constructs the XoshiroScalar generator with a given seed.
    * @param seed The seed value.
    */
-  PRNG_ALWAYS_INLINE constexpr explicit XoshiroScalar(const result_type seed) noexcept : m_state{} {
-    SplitMix splitmix{seed};
-    for (auto &element : m_state) {
-      element = splitmix();
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiroScalar(const result_type seed) noexcept : m_state{} {
+    // the first four SplitMix outputs, computed independently of each other
+    for (auto i = std::size_t{0}; i < m_state.size(); ++i) {
+      m_state[i] = SplitMix::at(seed, i);
     }
   }
 
+  /**
+   * @brief Constructs the XoshiroScalar generator from a full 256-bit state, e.g. the four words
+   * `SeedSequence::generate_state<std::uint64_t, 4>()` returns. The state must not be all zeros.
+   * @param state The initial state.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiroScalar(const std::array<result_type, 4> &state) noexcept
+      : m_state{state} {}
+
   /**
    * @brief Constructs the XoshiroScalar generator with a given seed and thread ID.
    * @param seed The seed value.
    * @param thread_id The thread ID.
    */
-  PRNG_ALWAYS_INLINE constexpr explicit XoshiroScalar(const result_type seed, const result_type thread_id) noexcept
-      : XoshiroScalar(seed) {
-    for (result_type i = 0; i < thread_id; ++i) {
-      jump();
-    }
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiroScalar(const result_type seed, const result_type thread_id) noexcept
+      : BasicXoshiroScalar(seed) {
+    jump_to_stream(thread_id);
   }
 
   /**
@@ -74,11 +84,11 @@ public:
    * @param thread_id The thread ID.
    * @param cluster_id The cluster ID.
    */
-  PRNG_ALWAYS_INLINE constexpr explicit XoshiroScalar(const result_type seed, const result_type thread_id,
+  PRNG_ALWAYS_INLINE constexpr explicit BasicXoshiroScalar(const result_type seed, const result_type thread_id,
                                                       const result_type cluster_id) noexcept
-      : XoshiroScalar(seed, thread_id) {
-    for (result_type i = 0; i < cluster_id; ++i) {
-      long_jump();
+      : BasicXoshiroScalar(seed, thread_id) {
+    if (cluster_id != 0) {
+      apply_jump(internal::jump_poly_for(cluster_id, 192));
     }
   }
 
@@ -111,25 +121,7 @@ public:
    * It can be used to generate 2^128 non-overlapping subsequences for simd computations.
    */
   PRNG_ALWAYS_INLINE constexpr void jump() noexcept {
-    constexpr result_type JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
-    result_type s0 = 0;
-    result_type s1 = 0;
-    result_type s2 = 0;
-    result_type s3 = 0;
-    for (const auto i : JUMP)
-      for (auto b = 0; b < 64; b++) {
-        if (i & result_type{1} << b) {
-          s0 ^= m_state[0];
-          s1 ^= m_state[1];
-          s2 ^= m_state[2];
-          s3 ^= m_state[3];
-        }
-        next();
-      }
-    m_state[0] = s0;
-    m_state[1] = s1;
-    m_state[2] = s2;
-    m_state[3] = s3;
+    apply_jump(internal::XOSHIRO256_JUMP_TABLE[128]);
   }
 
   /**
@@ -137,25 +129,7 @@ public:
    * It can be used to generate 2^96 non-overlapping subsequences for parallel computations.
    */
   PRNG_ALWAYS_INLINE constexpr void mid_jump() noexcept {
-    constexpr result_type JUMP[] = {0xc04b4f9c5d26c200, 0x69e6e6e431a2d40b, 0x4823b45b89dc689c, 0xf567382197055bf0};
-    result_type s0 = 0;
-    result_type s1 = 0;
-    result_type s2 = 0;
-    result_type s3 = 0;
-    for (const auto i : JUMP)
-      for (auto b = 0; b < 64; b++) {
-        if (i & result_type{1} << b) {
-          s0 ^= m_state[0];
-          s1 ^= m_state[1];
-          s2 ^= m_state[2];
-          s3 ^= m_state[3];
-        }
-        next();
-      }
-    m_state[0] = s0;
-    m_state[1] = s1;
-    m_state[2] = s2;
-    m_state[3] = s3;
+    apply_jump(internal::XOSHIRO256_JUMP_TABLE[160]);
   }
 
   /**
@@ -164,14 +138,49 @@ public:
    * subsequences for parallel distributed computations.
    */
   PRNG_ALWAYS_INLINE constexpr void long_jump() noexcept {
-    constexpr result_type LONG_JUMP[] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241,
-                                         0x39109bb02acbe635};
+    apply_jump(internal::XOSHIRO256_JUMP_TABLE[192]);
+  }
+
+  /**
+   * @brief Advances the generator by n steps, equivalent to n calls to next(). It costs O(log n) polynomial
+   * multiplications plus a single jump instead of n steps.
+   * @param n The number of steps.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(result_type n) noexcept {
+    // a polynomial jump costs 256 steps, so short distances are cheaper to walk
+    if (n <= 256) {
+      for (; n != 0; --n) {
+        next();
+      }
+      return;
+    }
+    apply_jump(internal::jump_poly_for(n, 0));
+  }
+
+  /**
+   * @brief Moves to the k-th subsequence, equivalent to k calls to jump() but in at most one jump.
+   * @param k The subsequence index.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump_to_stream(const result_type k) noexcept {
+    if (k != 0) {
+      apply_jump(internal::jump_poly_for(k, 128));
+    }
+  }
+
+private:
+  std::array<result_type, 4> m_state;
+
+  /**
+   * @brief Advances the state by the jump polynomial `poly`.
+   * @param poly The jump polynomial coefficients.
+   */
+  PRNG_ALWAYS_INLINE constexpr void apply_jump(const internal::jump_poly &poly) noexcept {
     result_type s0 = 0;
     result_type s1 = 0;
     result_type s2 = 0;
     result_type s3 = 0;
-    for (unsigned long i : LONG_JUMP)
-      for (int b = 0; b < 64; b++) {
+    for (const auto i : poly)
+      for (auto b = 0; b < 64; b++) {
         if (i & result_type{1} << b) {
           s0 ^= m_state[0];
           s1 ^= m_state[1];
@@ -180,16 +189,12 @@ public:
         }
         next();
       }
-
     m_state[0] = s0;
     m_state[1] = s1;
     m_state[2] = s2;
     m_state[3] = s3;
   }
 
-private:
-  std::array<result_type, 4> m_state;
-
   /**
    * @brief Rotates the bits of a 64-bit integer to the left.
    * @param x The integer to rotate.
@@ -204,12 +209,21 @@ private:
 #endif
   }
 
+  /**
+   * @brief Scalar rotate used by the scrambler policy.
+   */
+  struct ops {
+    template <int K> static PRNG_ALWAYS_INLINE constexpr result_type rotl(const result_type x) noexcept {
+      return BasicXoshiroScalar::rotl(x, K);
+    }
+  };
+
   /**
    * @brief Generates the next state of the generator.
    * @return The next state.
    */
   PRNG_ALWAYS_INLINE constexpr result_type next() noexcept {
-    const auto result = rotl(m_state[0] + m_state[3], 23) + m_state[0];
+    const auto result = Scrambler::template scramble<ops>(m_state[0], m_state[1], m_state[2], m_state[3]);
     const auto t_shift = m_state[1] << 17;
 
     m_state[2] ^= m_state[0];
@@ -224,4 +238,8 @@ private:
   }
 };
 
+using XoshiroScalar = BasicXoshiroScalar<>;
+using XoshiroPlusScalar = BasicXoshiroScalar<ScramblerPlus>;
+using XoshiroStarStarScalar = BasicXoshiroScalar<ScramblerStarStar>;
+
 } // namespace prng
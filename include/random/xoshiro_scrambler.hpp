@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "macros.hpp"
+
+namespace prng {
+
+namespace internal {
+
+/**
+ * Bits per lane of a state word, for plain integers and for SIMD batches alike.
+ */
+template <class T, class = void> struct word_bits : std::integral_constant<int, sizeof(T) * 8> {};
+template <class T>
+struct word_bits<T, std::void_t<typename T::value_type>>
+    : std::integral_constant<int, sizeof(typename T::value_type) * 8> {};
+
+} // namespace internal
+
+/**
+ * Output functions of the xoshiro256 and xoshiro128 families. All of them read the state before it is advanced, so the
+ * underlying linear engine, its jumps and its seeding are shared. Each policy exposes
+ * `scramble<Ops>(s0, s1, s2, s3)`, where `Ops::rotl<k>(x)` rotates `x` left by `k` bits; this lets the scalar and the
+ * SIMD engines share the formulas while using their own rotate instruction.
+ */
+
+/**
+ * xoshiro256+ and xoshiro128+: a single addition. Its lowest bits are weak, which does not matter for floating-point
+ * output as the conversion to double or float discards them.
+ */
+struct ScramblerPlus {
+  template <class Ops, class T>
+  static PRNG_ALWAYS_INLINE constexpr T scramble(const T &s0, const T &, const T &, const T &s3) noexcept {
+    return s0 + s3;
+  }
+};
+
+/**
+ * xoshiro256++ and xoshiro128++: the default all-purpose scrambler. The rotation is 23 for 64-bit words and 7 for
+ * 32-bit words.
+ */
+struct ScramblerPlusPlus {
+  template <class Ops, class T>
+  static PRNG_ALWAYS_INLINE constexpr T scramble(const T &s0, const T &, const T &, const T &s3) noexcept {
+    constexpr int rotation = internal::word_bits<T>::value == 64 ? 23 : 7;
+    return Ops::template rotl<rotation>(s0 + s3) + s0;
+  }
+};
+
+/**
+ * xoshiro256** and xoshiro128**: recommended when all the bits of the output matter. The multiplications by 5 and 9
+ * are written as shifts and additions, which every SIMD target supports natively.
+ */
+struct ScramblerStarStar {
+  template <class Ops, class T>
+  static PRNG_ALWAYS_INLINE constexpr T scramble(const T &, const T &s1, const T &, const T &) noexcept {
+    const T times5 = (s1 << 2) + s1;
+    const T rotated = Ops::template rotl<7>(times5);
+    return (rotated << 3) + rotated;
+  }
+};
+
+} // namespace prng
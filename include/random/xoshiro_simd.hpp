@@ -22,31 +22,74 @@ Vigna.
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
-#include <memory> // added for std::unique_ptr
+#include <type_traits>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 #include <xsimd/xsimd.hpp>
 
+#include "cache_fill.hpp"
 #include "macros.hpp"
+#include "simd_uniform.hpp"
+#include "xoshiro_jump.hpp"
 #include "xoshiro_scalar.hpp"
+#include "xoshiro_scrambler.hpp"
 
 namespace prng {
 
+namespace internal {
+
 /**
- * Forward declaration of the XoshiroSIMD class.
+ * Widest SIMD register, in 64-bit lanes, of the architectures XoshiroSIMD dispatches to.
  */
-class XoshiroSIMD;
+inline constexpr std::size_t MAX_SIMD_WIDTH = 8;
 
-namespace internal {
+/**
+ * Logical lane count of the canonical output order. Every architecture emulates this many lanes, using several state
+ * groups when its registers are narrower, so the output does not depend on the SIMD width.
+ */
+inline constexpr std::size_t CANONICAL_LANES = MAX_SIMD_WIDTH;
+
+/**
+ * Number of state groups an architecture needs to provide CANONICAL_LANES lanes.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ */
+template <class Arch>
+inline constexpr std::size_t canonical_groups = CANONICAL_LANES / xsimd::batch<std::uint64_t, Arch>::size;
+
+/**
+ * Words of inline state storage XoshiroSIMD reserves, enough for MAX_SIMD_WIDTH lanes of xoshiro256 state.
+ */
+inline constexpr std::size_t XOSHIRO_SIMD_STATE_SIZE = 4 * MAX_SIMD_WIDTH;
+
+/**
+ * SIMD rotate used by the scrambler policies.
+ */
+struct BatchOps {
+  template <int K, class T> static PRNG_ALWAYS_INLINE T rotl(const T &x) noexcept { return xsimd::rotl<K>(x); }
+};
+
+template <class Arch, std::size_t Groups, class Scrambler> struct XoshiroSIMDKernels;
 
 /**
  * Implementation of the XoshiroSIMD class template.
  *
  * @tparam Arch The architecture type for SIMD operations.
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single block per refill.
+ * @tparam Groups Number of independent state groups advanced round-robin, so that several xoshiro dependency chains
+ * are in flight at once. Batch `b` of the output comes from group `b % Groups`.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro256++), ScramblerPlus or ScramblerStarStar.
  */
-template <class Arch> class XoshiroSIMDImpl {
+template <class Arch, std::size_t CacheSize = 256, std::size_t Groups = 1, class Scrambler = ScramblerPlusPlus>
+class XoshiroSIMDImpl {
 public:
   using result_type = std::uint64_t;
   static constexpr PRNG_ALWAYS_INLINE auto(min)() noexcept { return (std::numeric_limits<result_type>::min)(); }
@@ -57,9 +100,28 @@ protected:
   using simd_type = xsimd::batch<result_type, Arch>;
   static constexpr auto RNG_WIDTH = std::uint8_t{4};
   static constexpr auto SIMD_WIDTH = std::uint8_t{simd_type::size};
-  static constexpr auto CACHE_SIZE = std::uint16_t{std::numeric_limits<std::uint8_t>::max() + 1};
+  static constexpr auto GROUPS = Groups;
+  // values produced by one round-robin step over all the groups
+  static constexpr auto BLOCK_SIZE = std::size_t{SIMD_WIDTH} * GROUPS;
+  static constexpr auto CACHE_SIZE = CacheSize == 0 ? BLOCK_SIZE : CacheSize;
+  // values written per unrolled refill step, matching a 256-entry cache but never less than a whole block
+  static constexpr auto UNROLL_SIZE =
+      CACHE_SIZE < 256 ? CACHE_SIZE : (std::max)(BLOCK_SIZE, std::size_t{256} - 256 % BLOCK_SIZE);
+  static_assert(GROUPS > 0, "At least one state group is required");
+  static_assert(CACHE_SIZE % BLOCK_SIZE == 0, "Cache size must be a multiple of the SIMD width times the groups");
+  static_assert(CACHE_SIZE <= std::numeric_limits<std::uint32_t>::max(), "Cache size must fit the cache index");
+  using index_type = std::uint32_t;
 
 public:
+  using batch_type = simd_type;
+  using uniform_batch_type = xsimd::batch<double, Arch>;
+
+  /**
+   * Buffers of at least this many bytes are written with non-temporal stores by fill() and fill_uniform(), as they
+   * would only evict the working set from a typical last-level cache.
+   */
+  static constexpr auto STREAM_THRESHOLD = std::size_t{32} << 20;
+
   /**
    * Constructor that initializes the generator with a seed and an external cache.
    *
@@ -68,17 +130,30 @@ public:
    */
   PRNG_ALWAYS_INLINE constexpr explicit XoshiroSIMDImpl(const result_type seed,
                                                         std::array<result_type, CACHE_SIZE> &cache) noexcept
-      : m_cache(cache), m_state{}, m_index{0} {
-    XoshiroScalar rng{seed};
-    std::array<std::array<result_type, SIMD_WIDTH>, RNG_WIDTH> states{};
-    for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
-      for (auto j = 0UL; j < RNG_WIDTH; ++j) {
-        states[j][i] = rng.getState()[j];
+      : XoshiroSIMDImpl(XoshiroScalar{seed}.getState(), cache) {}
+
+  /**
+   * Constructor that initializes the first lane with a full 256-bit state and an external cache. Every further lane
+   * is one jump() ahead of the previous one, as with a seed.
+   *
+   * @param state The initial state of the first lane; it must not be all zeros.
+   * @param cache Reference to the external cache.
+   */
+  PRNG_ALWAYS_INLINE constexpr explicit XoshiroSIMDImpl(const std::array<result_type, RNG_WIDTH> &state,
+                                                        std::array<result_type, CACHE_SIZE> &cache) noexcept
+      : m_cache(cache), m_state{}, m_index{CACHE_SIZE} {
+    XoshiroScalar rng{state};
+    for (auto &group : m_state) {
+      std::array<std::array<result_type, SIMD_WIDTH>, RNG_WIDTH> states{};
+      for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+        for (auto j = 0UL; j < RNG_WIDTH; ++j) {
+          states[j][i] = rng.getState()[j];
+        }
+        rng.jump();
+      }
+      for (auto i = UINT8_C(0); i < RNG_WIDTH; ++i) {
+        group[i] = simd_type::load_unaligned(states[i].data());
       }
-      rng.jump();
-    }
-    for (auto i = UINT8_C(0); i < RNG_WIDTH; ++i) {
-      m_state[i] = simd_type::load_unaligned(states[i].data());
     }
   }
 
@@ -92,9 +167,7 @@ public:
   PRNG_ALWAYS_INLINE constexpr explicit XoshiroSIMDImpl(const result_type seed, const result_type thread_id,
                                                         std::array<result_type, CACHE_SIZE> &cache) noexcept
       : XoshiroSIMDImpl(seed, cache) {
-    for (result_type i = 0; i < thread_id; ++i) {
-      mid_jump();
-    }
+    jump_to_stream(thread_id);
   }
 
   /**
@@ -109,8 +182,8 @@ public:
                                                         const result_type cluster_id,
                                                         std::array<result_type, CACHE_SIZE> &cache) noexcept
       : XoshiroSIMDImpl(seed, thread_id, cache) {
-    for (result_type i = 0; i < cluster_id; ++i) {
-      long_jump();
+    if (cluster_id != 0) {
+      apply_jump(jump_poly_for(cluster_id, 192));
     }
   }
 
@@ -120,8 +193,9 @@ public:
    * @return The next random number.
    */
   PRNG_ALWAYS_INLINE constexpr auto operator()() noexcept {
-    if (m_index == 0) [[unlikely]] {
+    if (m_index == CACHE_SIZE) [[unlikely]] {
       populate_cache();
+      m_index = 0;
     }
     return m_cache[m_index++];
   }
@@ -137,15 +211,78 @@ public:
   }
 
   /**
-   * Returns the state of the generator at the specified index.
+   * Generates the next SIMD batch straight from the state, without going through the cache. Lane `i` holds the next
+   * value of lane `i`. Values already in the cache are not returned here; operator() still returns them, so mixing
+   * both interfaces reorders the stream but never repeats or drops a value. On a generator that only uses
+   * next_batch(), or whose cache is exhausted, the batches are exactly what operator() would have returned.
+   *
+   * @return The next batch of random numbers.
+   */
+  PRNG_ALWAYS_INLINE batch_type next_batch() noexcept {
+    static_assert(GROUPS == 1, "next_batch() needs a single state group");
+    return next(m_state[0]);
+  }
+
+  /**
+   * Generates the next SIMD batch of uniform random numbers in the range [0, 1), with the semantics of next_batch().
+   *
+   * @return The next batch of uniform random numbers.
+   */
+  PRNG_ALWAYS_INLINE uniform_batch_type next_uniform_batch() noexcept { return internal::to_uniform(next_batch()); }
+
+  /**
+   * Fills a buffer with random numbers. The output is identical to calling operator() `n` times, but whole SIMD
+   * batches are stored directly into the buffer instead of going through the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill(result_type *out, const std::size_t n) noexcept {
+    fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) { return x; }, [this] { populate_cache(); },
+        [this](result_type *dst, const std::size_t count) { return fill_batches(dst, count); });
+  }
+
+  /**
+   * Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling uniform() `n`
+   * times, but whole SIMD batches are converted in registers and stored directly into the buffer.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(double *out, const std::size_t n) noexcept {
+    fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) { return to_uniform(x); }, [this] { populate_cache(); },
+        [this](double *dst, const std::size_t count) { return fill_uniform_batches(dst, count); });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * Fills a span with random numbers.
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * Fills a span with uniform random numbers in the range [0, 1).
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
+
+  /**
+   * Returns the state of the generator at the specified index. Lanes of group `g` start at index `g * SIMD_WIDTH`.
    *
    * @param index The index of the state.
    * @return The state at the specified index.
    */
   PRNG_ALWAYS_INLINE constexpr auto getState(const std::size_t index) const noexcept {
     std::array<result_type, RNG_WIDTH> state{};
+    const auto &group = m_state[index / SIMD_WIDTH];
     for (auto i = UINT8_C(0); i < RNG_WIDTH; ++i) {
-      state[i] = m_state[i].get(index);
+      state[i] = group[i].get(index % SIMD_WIDTH);
     }
     return state;
   }
@@ -155,25 +292,7 @@ public:
    * It can be used to generate 2^128 non-overlapping subsequences for parallel computations.
    */
   PRNG_ALWAYS_INLINE constexpr void jump() noexcept {
-    constexpr result_type JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
-    simd_type s0(0);
-    simd_type s1(0);
-    simd_type s2(0);
-    simd_type s3(0);
-    for (const auto i : JUMP)
-      for (auto b = 0; b < 64; b++) {
-        if (i & result_type{1} << b) {
-          s0 ^= m_state[0];
-          s1 ^= m_state[1];
-          s2 ^= m_state[2];
-          s3 ^= m_state[3];
-        }
-        next();
-      }
-    m_state[0] = s0;
-    m_state[1] = s1;
-    m_state[2] = s2;
-    m_state[3] = s3;
+    apply_jump(XOSHIRO256_JUMP_TABLE[128]);
   }
 
   /**
@@ -181,25 +300,7 @@ public:
    * It can be used to generate 2^96 non-overlapping subsequences for parallel computations.
    */
   PRNG_ALWAYS_INLINE constexpr void mid_jump() noexcept {
-    constexpr result_type MID_JUMP[] = {0xc04b4f9c5d26c200, 0x69e6e6e431a2d40b, 0x4823b45b89dc689c, 0xf567382197055bf0};
-    simd_type s0(0);
-    simd_type s1(0);
-    simd_type s2(0);
-    simd_type s3(0);
-    for (const auto i : MID_JUMP)
-      for (auto b = 0; b < 64; b++) {
-        if (i & result_type{1} << b) {
-          s0 ^= m_state[0];
-          s1 ^= m_state[1];
-          s2 ^= m_state[2];
-          s3 ^= m_state[3];
-        }
-        next();
-      }
-    m_state[0] = s0;
-    m_state[1] = s1;
-    m_state[2] = s2;
-    m_state[3] = s3;
+    apply_jump(XOSHIRO256_JUMP_TABLE[160]);
   }
 
   /**
@@ -208,109 +309,499 @@ public:
    * subsequences for parallel distributed computations.
    */
   PRNG_ALWAYS_INLINE constexpr void long_jump() noexcept {
-    constexpr result_type LONG_JUMP[] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241,
-                                         0x39109bb02acbe635};
-    simd_type s0(0);
-    simd_type s1(0);
-    simd_type s2(0);
-    simd_type s3(0);
-    for (const auto i : LONG_JUMP)
-      for (auto b = 0; b < 64; b++) {
-        if (i & result_type{1} << b) {
-          s0 ^= m_state[0];
-          s1 ^= m_state[1];
-          s2 ^= m_state[2];
-          s3 ^= m_state[3];
+    apply_jump(XOSHIRO256_JUMP_TABLE[192]);
+  }
+
+  /**
+   * Skips n values of the output, equivalent to n calls to operator(). Whole cache refills are skipped by advancing
+   * every lane, which costs O(log n) polynomial multiplications plus a single jump instead of n steps.
+   *
+   * @param n The number of values to skip.
+   */
+  PRNG_ALWAYS_INLINE constexpr void discard(result_type n) noexcept {
+    const auto cached = result_type{CACHE_SIZE - m_index};
+    if (n < cached) {
+      m_index += static_cast<index_type>(n);
+      return;
+    }
+    n -= cached;
+    // every refill advances each lane by CACHE_SIZE / BLOCK_SIZE steps
+    advance(n / CACHE_SIZE * (CACHE_SIZE / BLOCK_SIZE));
+    populate_cache();
+    m_index = static_cast<index_type>(n % CACHE_SIZE);
+  }
+
+  /**
+   * Moves to the k-th subsequence, equivalent to k calls to mid_jump() but in at most one jump.
+   *
+   * @param k The subsequence index.
+   */
+  PRNG_ALWAYS_INLINE constexpr void jump_to_stream(const result_type k) noexcept {
+    if (k != 0) {
+      apply_jump(jump_poly_for(k, 160));
+    }
+  }
+
+private:
+  struct state_tag {};
+
+  /**
+   * Advances every lane by n steps, equivalent to n calls to next(). The cache is not affected.
+   *
+   * @param n The number of steps.
+   */
+  PRNG_ALWAYS_INLINE constexpr void advance(result_type n) noexcept {
+    // a polynomial jump costs 256 steps, so short distances are cheaper to walk
+    if (n <= 256) {
+      for (; n != 0; --n) {
+        for (auto &group : m_state) {
+          next(group);
         }
-        next();
       }
-    m_state[0] = s0;
-    m_state[1] = s1;
-    m_state[2] = s2;
-    m_state[3] = s3;
+      return;
+    }
+    apply_jump(jump_poly_for(n, 0));
+  }
+
+  /**
+   * Constructor that loads the state saved by save_state(), laid out group by group and word by word.
+   *
+   * @param state The saved state, aligned to the architecture alignment.
+   * @param cache Reference to the external cache.
+   */
+  PRNG_ALWAYS_INLINE explicit XoshiroSIMDImpl(state_tag, const result_type *state,
+                                              std::array<result_type, CACHE_SIZE> &cache) noexcept
+      : m_cache(cache), m_state{}, m_index{CACHE_SIZE} {
+    for (auto g = std::size_t{0}; g < GROUPS; ++g) {
+      for (auto i = std::size_t{0}; i < RNG_WIDTH; ++i) {
+        m_state[g][i] = simd_type::load_aligned(state + (g * RNG_WIDTH + i) * SIMD_WIDTH);
+      }
+    }
+  }
+
+  /**
+   * Saves the state of every group.
+   *
+   * @param state Destination of GROUPS * RNG_WIDTH * SIMD_WIDTH words, aligned to the architecture alignment.
+   */
+  PRNG_ALWAYS_INLINE void save_state(result_type *state) const noexcept {
+    for (auto g = std::size_t{0}; g < GROUPS; ++g) {
+      for (auto i = std::size_t{0}; i < RNG_WIDTH; ++i) {
+        m_state[g][i].store_aligned(state + (g * RNG_WIDTH + i) * SIMD_WIDTH);
+      }
+    }
   }
 
-private:
   // removed alignas on reference (has no effect / can be ill-formed)
   std::array<result_type, CACHE_SIZE> &m_cache;
-  alignas(simd_type::arch_type::alignment()) std::array<simd_type, RNG_WIDTH> m_state;
-  std::uint8_t m_index;
+  alignas(simd_type::arch_type::alignment()) std::array<std::array<simd_type, RNG_WIDTH>, GROUPS> m_state;
+  index_type m_index;
 
   /**
-   * Generates the next state of the generator.
+   * Advances the state of every lane by the jump polynomial `poly`.
    *
+   * @param poly The jump polynomial coefficients.
+   */
+  PRNG_ALWAYS_INLINE constexpr void apply_jump(const jump_poly &poly) noexcept {
+    for (auto &state : m_state) {
+      simd_type s0(0);
+      simd_type s1(0);
+      simd_type s2(0);
+      simd_type s3(0);
+      for (const auto i : poly)
+        for (auto b = 0; b < 64; b++) {
+          if (i & result_type{1} << b) {
+            s0 ^= state[0];
+            s1 ^= state[1];
+            s2 ^= state[2];
+            s3 ^= state[3];
+          }
+          next(state);
+        }
+      state[0] = s0;
+      state[1] = s1;
+      state[2] = s2;
+      state[3] = s3;
+    }
+  }
+
+  /**
+   * Generates the next state of a state group.
+   *
+   * @param state The state group to advance.
    * @return The next state.
    */
-  PRNG_ALWAYS_INLINE constexpr auto next() noexcept {
-    const auto result = xsimd::rotl<23>(m_state[0] + m_state[3]) + m_state[0];
-    const auto t = xsimd::bitwise_lshift<17>(m_state[1]);
+  static PRNG_ALWAYS_INLINE constexpr auto next(std::array<simd_type, RNG_WIDTH> &state) noexcept {
+    const auto result = Scrambler::template scramble<BatchOps>(state[0], state[1], state[2], state[3]);
+    const auto t = xsimd::bitwise_lshift<17>(state[1]);
 
-    m_state[2] ^= m_state[0];
-    m_state[3] ^= m_state[1];
+    state[2] ^= state[0];
+    state[3] ^= state[1];
 
-    m_state[1] ^= m_state[2];
-    m_state[0] ^= m_state[3];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
 
-    m_state[2] ^= t;
+    state[2] ^= t;
 
-    m_state[3] = xsimd::rotl<45>(m_state[3]);
+    state[3] = xsimd::rotl<45>(state[3]);
 
     return result;
   }
 
   /**
-   * Unrolled loop to populate the cache.
+   * Advances every group once and hands batch `Gs` of the block to `store`. The groups do not depend on each other,
+   * so their updates can overlap in the pipeline.
+   *
+   * @param store Callable taking the batch and its index in the block.
+   */
+  template <class Store, size_t... Gs>
+  PRNG_ALWAYS_INLINE constexpr void next_block(Store &&store, std::index_sequence<Gs...>) noexcept {
+    (store(next(m_state[Gs]), Gs), ...);
+  }
+
+  /**
+   * Unrolled loop to populate a chunk of the cache.
    *
    * @tparam Is The indices of the cache.
+   * @param out Start of the chunk.
    */
-  template <size_t... Is> PRNG_ALWAYS_INLINE constexpr void unroll_populate(std::index_sequence<Is...>) noexcept {
-    (next().store_aligned(m_cache.data() + Is * SIMD_WIDTH), ...);
+  template <size_t... Is>
+  PRNG_ALWAYS_INLINE constexpr void unroll_populate(result_type *out, std::index_sequence<Is...>) noexcept {
+    (next(m_state[Is % GROUPS]).store_aligned(out + Is * SIMD_WIDTH), ...);
   }
 
   /**
-   * Populates the cache with random numbers.
+   * Populates the cache with random numbers, fully unrolled up to 256 values and in unrolled chunks beyond.
    */
   PRNG_ALWAYS_INLINE constexpr void populate_cache() noexcept {
-    unroll_populate(std::make_index_sequence<CACHE_SIZE / SIMD_WIDTH>{});
+    for (auto offset = std::size_t{0}; offset + UNROLL_SIZE <= CACHE_SIZE; offset += UNROLL_SIZE) {
+      unroll_populate(m_cache.data() + offset, std::make_index_sequence<UNROLL_SIZE / SIMD_WIDTH>{});
+    }
+    unroll_populate(m_cache.data() + CACHE_SIZE - CACHE_SIZE % UNROLL_SIZE,
+                    std::make_index_sequence<CACHE_SIZE % UNROLL_SIZE / SIMD_WIDTH>{});
+  }
+
+  /**
+   * Stores a batch with a non-temporal hint, bypassing the cache hierarchy.
+   *
+   * @param value The batch to store.
+   * @param out Destination, aligned to the architecture alignment.
+   */
+  template <class T>
+  static PRNG_ALWAYS_INLINE void store_stream(const xsimd::batch<T, Arch> &value, T *out) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    if constexpr (std::is_same_v<T, double>) {
+      if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+        _mm512_stream_pd(out, value);
+      } else if constexpr (std::is_base_of_v<xsimd::avx, Arch>) {
+        _mm256_stream_pd(out, value);
+      } else if constexpr (std::is_base_of_v<xsimd::sse2, Arch>) {
+        _mm_stream_pd(out, value);
+      } else {
+        value.store_aligned(out);
+      }
+    } else if constexpr (std::is_base_of_v<xsimd::avx512f, Arch>) {
+      _mm512_stream_si512(reinterpret_cast<__m512i *>(out), value);
+    } else if constexpr (std::is_base_of_v<xsimd::avx2, Arch>) {
+      _mm256_stream_si256(reinterpret_cast<__m256i *>(out), value);
+    } else if constexpr (std::is_base_of_v<xsimd::sse2, Arch>) {
+      _mm_stream_si128(reinterpret_cast<__m128i *>(out), value);
+    } else {
+      value.store_aligned(out);
+    }
+#else
+    value.store_aligned(out);
+#endif
   }
 
-  friend XoshiroSIMD;
+  /**
+   * Writes `blocks` whole blocks starting `head` values before an aligned address. When `head` is not zero the
+   * generated batches straddle the aligned destination batches, so each block is staged in an aligned buffer and read
+   * back at the offset that lines it up with the destination; the first `head` values and the last `SIMD_WIDTH - head`
+   * values are copied one at a time.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param blocks The number of blocks to write; it must not be zero.
+   * @param head The number of values before the first aligned address, below SIMD_WIDTH.
+   * @param convert Callable mapping a generated batch to the output batch.
+   * @param store Callable storing an output batch to an aligned address.
+   */
+  template <class T, class Convert, class Store>
+  PRNG_ALWAYS_INLINE void store_blocks(T *PRNG_RESTRICT out, std::size_t blocks, const std::size_t head,
+                                       Convert &convert, Store &&store) noexcept {
+    using batch = xsimd::batch<T, Arch>;
+    constexpr auto groups = std::make_index_sequence<GROUPS>{};
+    if (head == 0) {
+      for (; blocks != 0; --blocks, out += BLOCK_SIZE) {
+        next_block([&](const simd_type &value, const std::size_t g) { store(convert(value), out + g * SIMD_WIDTH); },
+                   groups);
+      }
+      return;
+    }
+    // the first SIMD_WIDTH values carry the tail of the previous block in front of the current one
+    alignas(simd_type::arch_type::alignment()) std::array<T, SIMD_WIDTH + BLOCK_SIZE> stage;
+    auto *const staged = stage.data() + SIMD_WIDTH;
+    const auto stage_block = [&] {
+      next_block(
+          [&](const simd_type &value, const std::size_t g) { convert(value).store_aligned(staged + g * SIMD_WIDTH); },
+          groups);
+    };
+    stage_block();
+    std::copy_n(staged, head, out);
+    out += head;
+    for (auto g = std::size_t{1}; g < GROUPS; ++g, out += SIMD_WIDTH) {
+      store(batch::load_unaligned(stage.data() + head + g * SIMD_WIDTH), out);
+    }
+    while (--blocks != 0) {
+      batch::load_aligned(stage.data() + BLOCK_SIZE).store_aligned(stage.data());
+      stage_block();
+      for (auto g = std::size_t{0}; g < GROUPS; ++g, out += SIMD_WIDTH) {
+        store(batch::load_unaligned(stage.data() + head + g * SIMD_WIDTH), out);
+      }
+    }
+    std::copy_n(stage.data() + BLOCK_SIZE + head, SIMD_WIDTH - head, out);
+  }
 
-};
+  /**
+   * Writes as many whole blocks as fit in the buffer, bypassing the cache. Values are copied one at a time until the
+   * destination reaches the architecture alignment, so the body always uses aligned stores, or non-temporal ones for
+   * fills past STREAM_THRESHOLD, whatever the alignment of the caller's pointer or the cache index.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The size of the destination buffer.
+   * @param convert Callable mapping a generated batch to the output batch.
+   * @return The number of values written.
+   */
+  template <class T, class Convert>
+  PRNG_ALWAYS_INLINE std::size_t fill_blocks(T *PRNG_RESTRICT out, const std::size_t n, Convert &&convert) noexcept {
+    const auto count = n - n % BLOCK_SIZE;
+    if (count == 0) {
+      return 0;
+    }
+    constexpr auto alignment = std::size_t{simd_type::arch_type::alignment()};
+    const auto misalignment = static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(out) % alignment);
+    if (misalignment % sizeof(T) != 0) {
+      // no number of whole values reaches the alignment
+      for (const auto *const end = out + count; out != end; out += BLOCK_SIZE) {
+        next_block(
+            [&](const simd_type &value, const std::size_t g) { convert(value).store_unaligned(out + g * SIMD_WIDTH); },
+            std::make_index_sequence<GROUPS>{});
+      }
+      return count;
+    }
+    const auto head = misalignment == 0 ? std::size_t{0} : (alignment - misalignment) / sizeof(T);
+    if (count * sizeof(T) >= STREAM_THRESHOLD) {
+      store_blocks(out, count / BLOCK_SIZE, head, convert,
+                   [](const xsimd::batch<T, Arch> &value, T *dst) { store_stream(value, dst); });
+#if defined(__x86_64__) || defined(_M_X64)
+      _mm_sfence();
+#endif
+    } else {
+      store_blocks(out, count / BLOCK_SIZE, head, convert,
+                   [](const xsimd::batch<T, Arch> &value, T *dst) { value.store_aligned(dst); });
+    }
+    return count;
+  }
 
-struct XoshiroSIMDCreator;
+  /**
+   * Writes as many whole blocks as fit in the buffer, bypassing the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The size of the destination buffer.
+   * @return The number of values written.
+   */
+  PRNG_ALWAYS_INLINE std::size_t fill_batches(result_type *PRNG_RESTRICT out, const std::size_t n) noexcept {
+    return fill_blocks(out, n, [](const simd_type &value) { return value; });
+  }
+
+  /**
+   * Writes as many whole blocks of uniform doubles as fit in the buffer, bypassing the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The size of the destination buffer.
+   * @return The number of values written.
+   */
+  PRNG_ALWAYS_INLINE std::size_t fill_uniform_batches(double *PRNG_RESTRICT out, const std::size_t n) noexcept {
+    return fill_blocks(out, n, [](const simd_type &value) { return internal::to_uniform(value); });
+  }
+
+  template <class, std::size_t, class> friend struct XoshiroSIMDKernels;
+};
 
 } // namespace internal
 
 /**
  * XoshiroSIMD class using the best available architecture.
+ *
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single block per refill.
+ * @tparam Groups Number of independent state groups advanced round-robin.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro256++), ScramblerPlus or ScramblerStarStar.
  */
-class XoshiroNative : public internal::XoshiroSIMDImpl<xsimd::best_arch> {
+template <std::size_t CacheSize = 256, std::size_t Groups = 1, class Scrambler = ScramblerPlusPlus>
+class BasicXoshiroNative : public internal::XoshiroSIMDImpl<xsimd::best_arch, CacheSize, Groups, Scrambler> {
+  using base_type = internal::XoshiroSIMDImpl<xsimd::best_arch, CacheSize, Groups, Scrambler>;
+  using typename base_type::simd_type;
+  using base_type::CACHE_SIZE;
+
 public:
-  using XoshiroSIMDImpl::XoshiroSIMDImpl;
+  using typename base_type::result_type;
+  using base_type::base_type;
 
   /**
    * Constructor that initializes the generator with a seed.
    *
    * @param seed The seed value.
    */
-  PRNG_ALWAYS_INLINE explicit XoshiroNative(const result_type seed) noexcept : XoshiroSIMDImpl(seed, m_cache) {}
-  PRNG_ALWAYS_INLINE explicit XoshiroNative(const result_type seed, const result_type thread_id) noexcept
-      : XoshiroSIMDImpl(seed, thread_id, m_cache) {}
-  PRNG_ALWAYS_INLINE explicit XoshiroNative(const result_type seed, const result_type thread_id,
-                                            const result_type cluster_id) noexcept
-      : XoshiroSIMDImpl(seed, thread_id, cluster_id, m_cache) {}
+  PRNG_ALWAYS_INLINE explicit BasicXoshiroNative(const result_type seed) noexcept : base_type(seed, m_cache) {}
+
+  /**
+   * Constructor that initializes the first lane with a full 256-bit state, e.g. from a SeedSequence.
+   *
+   * @param state The initial state of the first lane; it must not be all zeros.
+   */
+  PRNG_ALWAYS_INLINE explicit BasicXoshiroNative(const std::array<result_type, 4> &state) noexcept
+      : base_type(state, m_cache) {}
+  PRNG_ALWAYS_INLINE explicit BasicXoshiroNative(const result_type seed, const result_type thread_id) noexcept
+      : base_type(seed, thread_id, m_cache) {}
+  PRNG_ALWAYS_INLINE explicit BasicXoshiroNative(const result_type seed, const result_type thread_id,
+                                                 const result_type cluster_id) noexcept
+      : base_type(seed, thread_id, cluster_id, m_cache) {}
+
+  // the base class refers to m_cache, so a copy or move would keep pointing into this object
+  BasicXoshiroNative(const BasicXoshiroNative &) = delete;
+  BasicXoshiroNative &operator=(const BasicXoshiroNative &) = delete;
 
 private:
   alignas(simd_type::arch_type::alignment()) std::array<result_type, CACHE_SIZE> m_cache{};
 };
 
+using XoshiroNative = BasicXoshiroNative<>;
+using XoshiroPlusNative = BasicXoshiroNative<256, 1, ScramblerPlus>;
+using XoshiroStarStarNative = BasicXoshiroNative<256, 1, ScramblerStarStar>;
+
+/**
+ * XoshiroNative in canonical output order: CANONICAL_LANES logical lanes, lane `l` seeded with `l` jumps, emitted in
+ * lane order. The sequence is the same for every SIMD width.
+ *
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single block per refill.
+ */
+template <std::size_t CacheSize = 256>
+using BasicXoshiroNativeCanonical = BasicXoshiroNative<CacheSize, internal::canonical_groups<xsimd::best_arch>>;
+
+using XoshiroNativeCanonical = BasicXoshiroNativeCanonical<>;
+
+namespace internal {
+
+/**
+ * Entry points of one dispatch target. They operate on state saved in XoshiroSIMD's inline storage, so the generator
+ * needs neither a heap allocation nor virtual calls.
+ */
+struct XoshiroSIMDTable {
+  using result_type = std::uint64_t;
+  void (*seed)(result_type *state, result_type seed, result_type thread_id, result_type cluster_id) noexcept;
+  void (*seed_state)(result_type *state, const result_type *initial) noexcept;
+  std::size_t (*fill_batches)(result_type *state, result_type *out, std::size_t n) noexcept;
+  std::size_t (*fill_uniform_batches)(result_type *state, double *out, std::size_t n) noexcept;
+  void (*jump)(result_type *state) noexcept;
+  void (*long_jump)(result_type *state) noexcept;
+  void (*discard)(result_type *state, result_type n) noexcept;
+  void (*jump_to_stream)(result_type *state, result_type k) noexcept;
+};
+
+/**
+ * Implementations of the XoshiroSIMDTable entry points on top of internal::XoshiroSIMDImpl<Arch>. Each call loads the
+ * state into registers, runs the generator and saves the state again.
+ *
+ * @tparam Arch The architecture type for SIMD operations.
+ * @tparam Groups Number of interleaved state groups.
+ * @tparam Scrambler The output function.
+ */
+template <class Arch, std::size_t Groups, class Scrambler> struct XoshiroSIMDKernels {
+  using impl_type = XoshiroSIMDImpl<Arch, 0, Groups, Scrambler>;
+  using result_type = typename impl_type::result_type;
+  // the impl never touches its cache here, it only needs one to be constructed
+  using cache_type = std::array<result_type, impl_type::CACHE_SIZE>;
+  static_assert(Groups * impl_type::RNG_WIDTH * impl_type::SIMD_WIDTH <= XOSHIRO_SIMD_STATE_SIZE,
+                "The state does not fit the inline storage");
+
+  static void seed(result_type *state, const result_type seed_value, const result_type thread_id,
+                   const result_type cluster_id) noexcept {
+    cache_type cache;
+    impl_type(seed_value, thread_id, cluster_id, cache).save_state(state);
+  }
+  static void seed_state(result_type *state, const result_type *initial) noexcept {
+    cache_type cache;
+    impl_type({initial[0], initial[1], initial[2], initial[3]}, cache).save_state(state);
+  }
+  static std::size_t fill_batches(result_type *state, result_type *out, const std::size_t n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    const auto count = impl.fill_batches(out, n);
+    impl.save_state(state);
+    return count;
+  }
+  static std::size_t fill_uniform_batches(result_type *state, double *out, const std::size_t n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    const auto count = impl.fill_uniform_batches(out, n);
+    impl.save_state(state);
+    return count;
+  }
+  static void jump(result_type *state) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.jump();
+    impl.save_state(state);
+  }
+  static void long_jump(result_type *state) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.long_jump();
+    impl.save_state(state);
+  }
+  // n counts output values and must be a multiple of the block size
+  static void discard(result_type *state, const result_type n) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.advance(n / impl_type::BLOCK_SIZE);
+    impl.save_state(state);
+  }
+  static void jump_to_stream(result_type *state, const result_type k) noexcept {
+    cache_type cache;
+    impl_type impl(typename impl_type::state_tag{}, state, cache);
+    impl.jump_to_stream(k);
+    impl.save_state(state);
+  }
+
+  static constexpr XoshiroSIMDTable table{&seed, &seed_state, &fill_batches, &fill_uniform_batches, &jump,
+                                          &long_jump, &discard, &jump_to_stream};
+};
+
+} // namespace internal
+
+/**
+ * Returns the entry points of the best architecture the CPU supports. The architecture is detected on the first call
+ * only, every later call returns the same table.
+ *
+ * @tparam Scrambler The output function. ScramblerPlusPlus, ScramblerPlus and ScramblerStarStar are instantiated.
+ * @param canonical Whether to emit the ISA-independent canonical order.
+ * @return The dispatch table.
+ */
+template <class Scrambler> const internal::XoshiroSIMDTable &xoshiro_simd_table(bool canonical) noexcept;
+
 /**
  * XoshiroSIMD class that provides a high-level interface for the generator.
+ *
+ * @tparam CacheSize Number of values produced per cache refill. Zero selects a single refill of the widest supported
+ * SIMD register.
+ * @tparam Canonical Emit the canonical order of XoshiroNativeCanonical, so the same seed gives the same numbers on
+ * every dispatch target.
+ * @tparam Scrambler The output function: ScramblerPlusPlus (xoshiro256++), ScramblerPlus or ScramblerStarStar.
  */
-class XoshiroSIMD {
+template <std::size_t CacheSize = 256, bool Canonical = false, class Scrambler = ScramblerPlusPlus>
+class BasicXoshiroSIMD {
 public:
-  using result_type = internal::XoshiroSIMDImpl<xsimd::best_arch>::result_type;
+  using result_type = internal::XoshiroSIMDTable::result_type;
   constexpr static PRNG_ALWAYS_INLINE result_type(min)() noexcept {
     return internal::XoshiroSIMDImpl<xsimd::best_arch>::min();
   }
@@ -318,7 +809,22 @@ public:
     return internal::XoshiroSIMDImpl<xsimd::best_arch>::max();
   }
 
-  explicit XoshiroSIMD(result_type seed, result_type thread_id = 0, result_type cluster_id = 0) noexcept;
+  explicit BasicXoshiroSIMD(const result_type seed, const result_type thread_id = 0,
+                            const result_type cluster_id = 0) noexcept
+      : m_table{&xoshiro_simd_table<Scrambler>(Canonical)} {
+    m_table->seed(m_state.data(), seed, thread_id, cluster_id);
+  }
+
+  /**
+   * Constructor that initializes the first lane with a full 256-bit state, e.g. from a SeedSequence. Further lanes
+   * are jump() apart, as with a seed.
+   *
+   * @param state The initial state of the first lane; it must not be all zeros.
+   */
+  explicit BasicXoshiroSIMD(const std::array<result_type, 4> &state) noexcept
+      : m_table{&xoshiro_simd_table<Scrambler>(Canonical)} {
+    m_table->seed_state(m_state.data(), state.data());
+  }
 
   /**
    * Generates the next random number.
@@ -326,8 +832,9 @@ public:
    * @return The next random number.
    */
   PRNG_ALWAYS_INLINE result_type operator()() noexcept {
-    if (m_index == 0) [[unlikely]] {
-      pImpl->populate_cache();
+    if (m_index == CACHE_SIZE) [[unlikely]] {
+      populate_cache();
+      m_index = 0;
     }
     return m_cache[m_index++];
   }
@@ -342,104 +849,157 @@ public:
     return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
   }
 
-  // Bulk fill helpers are implemented in the Python extension to reduce
-  // surface area of the core C++ API. Use per-sample operator()/uniform().
+  /**
+   * Fills a buffer with random numbers. The output is identical to calling operator() `n` times, but whole SIMD
+   * batches are stored directly into the buffer instead of going through the cache.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill(result_type *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) noexcept { return x; },
+        [this]() noexcept { populate_cache(); },
+        [this](result_type *dst, const std::size_t count) noexcept {
+          return m_table->fill_batches(m_state.data(), dst, count);
+        });
+  }
+
+  /**
+   * Fills a buffer with uniform random numbers in the range [0, 1). The output is identical to calling uniform() `n`
+   * times, but whole SIMD batches are converted in registers and stored directly into the buffer.
+   *
+   * @param out Pointer to the destination buffer.
+   * @param n The number of values to generate.
+   */
+  void fill_uniform(double *out, std::size_t n) noexcept {
+    internal::fill_through_cache(
+        m_cache, m_index, out, n, [](const result_type x) noexcept { return internal::to_uniform(x); },
+        [this]() noexcept { populate_cache(); },
+        [this](double *dst, const std::size_t count) noexcept {
+          return m_table->fill_uniform_batches(m_state.data(), dst, count);
+        });
+  }
+
+#if __cplusplus >= 202002L
+  /**
+   * Fills a span with random numbers.
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill(const std::span<result_type> out) noexcept { fill(out.data(), out.size()); }
+
+  /**
+   * Fills a span with uniform random numbers in the range [0, 1).
+   *
+   * @param out The destination span.
+   */
+  PRNG_ALWAYS_INLINE void fill_uniform(const std::span<double> out) noexcept { fill_uniform(out.data(), out.size()); }
+#endif
 
   /**
    * Jump function for the generator.
    */
-  PRNG_ALWAYS_INLINE void jump() noexcept { pImpl->jump(); }
+  PRNG_ALWAYS_INLINE void jump() noexcept { m_table->jump(m_state.data()); }
 
   /**
    * Long-jump function for the generator.
    */
-  PRNG_ALWAYS_INLINE void long_jump() noexcept { pImpl->long_jump(); }
+  PRNG_ALWAYS_INLINE void long_jump() noexcept { m_table->long_jump(m_state.data()); }
 
-protected:
-  static constexpr auto CACHE_SIZE = internal::XoshiroSIMDImpl<xsimd::default_arch>::CACHE_SIZE;
+  /**
+   * Skips n values of the output, equivalent to n calls to operator(), in O(log n) time.
+   *
+   * @param n The number of values to skip.
+   */
+  PRNG_ALWAYS_INLINE void discard(result_type n) noexcept {
+    const auto cached = result_type{CACHE_SIZE - m_index};
+    if (n < cached) {
+      m_index += static_cast<std::uint32_t>(n);
+      return;
+    }
+    n -= cached;
+    // the cache size is a multiple of the block of every dispatch target
+    m_table->discard(m_state.data(), n - n % CACHE_SIZE);
+    populate_cache();
+    m_index = static_cast<std::uint32_t>(n % CACHE_SIZE);
+  }
 
   /**
-   * Abstract interface to hide the templated implementation.
+   * Moves to the k-th subsequence, equivalent to k mid jumps.
    */
-  struct IXoshiroSIMD {
-    virtual ~IXoshiroSIMD() = default;
-    virtual void populate_cache() noexcept = 0;
-    virtual void jump() noexcept = 0;
-    virtual void long_jump() noexcept = 0;
-  };
+  PRNG_ALWAYS_INLINE void jump_to_stream(const result_type k) noexcept {
+    m_table->jump_to_stream(m_state.data(), k);
+  }
+
+protected:
+  static constexpr auto CACHE_SIZE = CacheSize == 0 ? internal::MAX_SIMD_WIDTH : CacheSize;
+  static_assert(CACHE_SIZE % internal::MAX_SIMD_WIDTH == 0,
+                "Cache size must be a multiple of the widest supported SIMD width");
+  static_assert(CACHE_SIZE <= std::numeric_limits<std::uint32_t>::max(), "Cache size must fit the cache index");
 
   /**
-   * Templated wrapper that delegates to internal::XoshiroSIMDImpl<Arch>.
-   *
-   * @tparam Arch The architecture type for SIMD operations.
+   * Refills the whole cache with one call into the dispatched implementation.
    */
-  template <class Arch> class ImplWrapper : public IXoshiroSIMD {
-    internal::XoshiroSIMDImpl<Arch> impl;
-
-  public:
-    PRNG_ALWAYS_INLINE explicit ImplWrapper(result_type seed, result_type thread_id, result_type cluster_id,
-                                            std::array<result_type, CACHE_SIZE> &cache) noexcept
-        : impl(seed, thread_id, cluster_id, cache) {}
-    PRNG_ALWAYS_INLINE void populate_cache() noexcept final { impl.populate_cache(); }
-    PRNG_ALWAYS_INLINE void jump() noexcept final { impl.jump(); }
-    PRNG_ALWAYS_INLINE void long_jump() noexcept final { impl.long_jump(); }
-  };
-
-  alignas(64) std::array<result_type, CACHE_SIZE> m_cache;
-  std::unique_ptr<IXoshiroSIMD> pImpl;
-  std::uint8_t m_index{0}; // ensure zero-initialized
-
-  friend std::unique_ptr<IXoshiroSIMD> create_xoshiro_simd_impl(result_type seed, result_type thread_id,
-                                                                result_type cluster_id,
-                                                                std::array<result_type, CACHE_SIZE> &cache);
-  friend internal::XoshiroSIMDCreator;
+  PRNG_ALWAYS_INLINE void populate_cache() noexcept {
+    m_table->fill_batches(m_state.data(), m_cache.data(), CACHE_SIZE);
+  }
+
+  alignas(64) std::array<result_type, CACHE_SIZE> m_cache{};
+  alignas(64) std::array<result_type, internal::XOSHIRO_SIMD_STATE_SIZE> m_state{};
+  const internal::XoshiroSIMDTable *m_table;
+  std::uint32_t m_index{CACHE_SIZE};
 };
 
-/**
- * Extern function declaration to create a XoshiroSIMD implementation.
- *
- * @param seed The seed value.
- * @param thread_id The thread ID.
- * @param cluster_id The cluster ID.
- * @param cache Reference to the external cache.
- * @return A unique pointer to the XoshiroSIMD implementation.
- */
-std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-create_xoshiro_simd_impl(XoshiroSIMD::result_type seed, XoshiroSIMD::result_type thread_id,
-                         XoshiroSIMD::result_type cluster_id,
-                         std::array<XoshiroSIMD::result_type, XoshiroSIMD::CACHE_SIZE> &cache);
+using XoshiroSIMD = BasicXoshiroSIMD<>;
+using XoshiroSIMDCanonical = BasicXoshiroSIMD<256, true>;
+using XoshiroPlusSIMD = BasicXoshiroSIMD<256, false, ScramblerPlus>;
+using XoshiroStarStarSIMD = BasicXoshiroSIMD<256, false, ScramblerStarStar>;
+
+static_assert(std::is_trivially_copyable_v<XoshiroSIMD>);
 
 namespace internal {
 
 /**
- * Functor used by xsimd::dispatch to create a XoshiroSIMD implementation.
+ * Functor used by xsimd::dispatch to select the XoshiroSIMD entry points.
+ *
+ * @tparam Scrambler The output function.
  */
-struct XoshiroSIMDCreator {
-  XoshiroSIMD::result_type seed, thread_id, cluster_id;
-  std::array<XoshiroSIMD::result_type, XoshiroSIMD::CACHE_SIZE> &cache;
+template <class Scrambler> struct XoshiroSIMDTableCreator {
+  bool canonical;
 
   /**
-   * Operator that creates a XoshiroSIMD implementation for the given architecture.
+   * Operator that returns the XoshiroSIMD entry points for the given architecture.
    *
    * @tparam Arch The architecture type for SIMD operations.
    * @param arch The architecture tag.
-   * @return A unique pointer to the XoshiroSIMD implementation.
+   * @return The dispatch table.
    */
-  template <class Arch> std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> operator()(Arch) const;
+  template <class Arch> const XoshiroSIMDTable *operator()(Arch) const noexcept;
 };
 
-template <class Arch> std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator()(Arch) const {
-  return std::make_unique<XoshiroSIMD::ImplWrapper<Arch>>(seed, thread_id, cluster_id, cache);
+template <class Scrambler>
+template <class Arch>
+const XoshiroSIMDTable *XoshiroSIMDTableCreator<Scrambler>::operator()(Arch) const noexcept {
+  if (canonical) {
+    return &XoshiroSIMDKernels<Arch, canonical_groups<Arch>, Scrambler>::table;
+  }
+  return &XoshiroSIMDKernels<Arch, 1, Scrambler>::table;
 }
 
-extern template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-XoshiroSIMDCreator::operator()<xsimd::sse2>(xsimd::sse2) const;
-extern template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-XoshiroSIMDCreator::operator()<xsimd::sse4_2>(xsimd::sse4_2) const;
-extern template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-XoshiroSIMDCreator::operator()<xsimd::fma3<xsimd::avx2>>(xsimd::fma3<xsimd::avx2>) const;
-extern template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-XoshiroSIMDCreator::operator()<xsimd::avx512f>(xsimd::avx512f) const;
+// Declares (PREFIX = extern) or defines the entry points of every scrambler for one architecture.
+#define PRNG_XOSHIRO_SIMD_TABLES(PREFIX, ARCH)                                                                       \
+  PREFIX template const XoshiroSIMDTable *XoshiroSIMDTableCreator<ScramblerPlusPlus>::operator()<ARCH>(ARCH)          \
+      const noexcept;                                                                                                \
+  PREFIX template const XoshiroSIMDTable *XoshiroSIMDTableCreator<ScramblerPlus>::operator()<ARCH>(ARCH)              \
+      const noexcept;                                                                                                \
+  PREFIX template const XoshiroSIMDTable *XoshiroSIMDTableCreator<ScramblerStarStar>::operator()<ARCH>(ARCH)          \
+      const noexcept;
+
+PRNG_XOSHIRO_SIMD_TABLES(extern, xsimd::sse2)
+PRNG_XOSHIRO_SIMD_TABLES(extern, xsimd::sse4_2)
+PRNG_XOSHIRO_SIMD_TABLES(extern, xsimd::fma3<xsimd::avx2>)
+PRNG_XOSHIRO_SIMD_TABLES(extern, xsimd::avx512f)
 
 } // namespace internal
 
@@ -1,14 +1,17 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/array.h>
 #include <numpy/random/bitgen.h>
 #include <type_traits>  // std::void_t, std::true_type, std::false_type
-#include <utility>      // std::forward
+#include <utility>      // std::forward, std::declval
 #include <stdexcept>
 #include <memory>
 #include <cstring>
 #include <vector>
 
 #include "random/macros.hpp"
+#include "random/pcg64.hpp"
+#include "random/philox_simd.hpp"
 #include "random/splitmix.hpp"
 #include "random/xoshiro.hpp"
 #include "random/xoshiro_simd.hpp"
@@ -52,7 +55,7 @@ private:
 
 class PyXoshiroSIMD : public XoshiroSIMD {
 public:
-  using XoshiroSIMD::XoshiroSIMD;
+  using BasicXoshiroSIMD::BasicXoshiroSIMD;
 
   PRNG_ALWAYS_INLINE uint64_t random_raw() noexcept { return (*this)(); }
   PRNG_ALWAYS_INLINE double uniform() noexcept { return XoshiroSIMD::uniform(); }
@@ -62,97 +65,41 @@ public:
   // Fast bulk fill using internal cache; accepts 1D C-contiguous
   PRNG_ALWAYS_INLINE void fill_uniform_array(nb::ndarray<nb::numpy, double, nb::ndim<1>, nb::c_contig> arr) noexcept {
     nb::gil_scoped_release release;
-    auto* out = arr.data();
-    const std::size_t n = arr.size();
-    std::size_t produced = 0;
-    while (produced < n) {
-      if (m_index == 0) [[unlikely]] {
-        pImpl->populate_cache();
-      }
-      const std::size_t available = static_cast<std::size_t>(CACHE_SIZE) - m_index;
-      const std::size_t to_copy = (n - produced < available) ? (n - produced) : available;
-      for (std::size_t i = 0; i < to_copy; ++i) {
-        out[produced + i] = static_cast<double>(m_cache[m_index + i] >> 11) * kInvPow53;
-      }
-      m_index = static_cast<std::uint8_t>(m_index + to_copy);
-      if (m_index == CACHE_SIZE) {
-        m_index = 0;
-      }
-      produced += to_copy;
-    }
+    fill_uniform(arr.data(), arr.size());
   }
 
   // Overload: accept 1D F-contiguous
   PRNG_ALWAYS_INLINE void fill_uniform_array(nb::ndarray<nb::numpy, double, nb::ndim<1>, nb::f_contig> arr) noexcept {
     nb::gil_scoped_release release;
-    auto* out = arr.data();
-    const std::size_t n = arr.size();
-    std::size_t produced = 0;
-    while (produced < n) {
-      if (m_index == 0) [[unlikely]] {
-        pImpl->populate_cache();
-      }
-      const std::size_t available = static_cast<std::size_t>(CACHE_SIZE) - m_index;
-      const std::size_t to_copy = (n - produced < available) ? (n - produced) : available;
-      for (std::size_t i = 0; i < to_copy; ++i) {
-        out[produced + i] = static_cast<double>(m_cache[m_index + i] >> 11) * kInvPow53;
-      }
-      m_index = static_cast<std::uint8_t>(m_index + to_copy);
-      if (m_index == CACHE_SIZE) {
-        m_index = 0;
-      }
-      produced += to_copy;
-    }
+    fill_uniform(arr.data(), arr.size());
   }
 
   PRNG_ALWAYS_INLINE void fill_uint64_array(
       nb::ndarray<nb::numpy, std::uint64_t, nb::ndim<1>, nb::c_contig> arr) noexcept {
     nb::gil_scoped_release release;
-    auto* out = arr.data();
-    const std::size_t n = arr.size();
-    std::size_t produced = 0;
-    while (produced < n) {
-      if (m_index == 0) [[unlikely]] {
-        pImpl->populate_cache();
-      }
-      const std::size_t available = static_cast<std::size_t>(CACHE_SIZE) - m_index;
-      const std::size_t to_copy = (n - produced < available) ? (n - produced) : available;
-      // Copy contiguous block directly
-      std::memcpy(out + produced, m_cache.data() + m_index, to_copy * sizeof(std::uint64_t));
-      m_index = static_cast<std::uint8_t>(m_index + to_copy);
-      if (m_index == CACHE_SIZE) {
-        m_index = 0;
-      }
-      produced += to_copy;
-    }
+    fill(arr.data(), arr.size());
   }
 
   // Overload: accept 1D F-contiguous for uint64
   PRNG_ALWAYS_INLINE void fill_uint64_array(
       nb::ndarray<nb::numpy, std::uint64_t, nb::ndim<1>, nb::f_contig> arr) noexcept {
     nb::gil_scoped_release release;
-    auto* out = arr.data();
-    const std::size_t n = arr.size();
-    std::size_t produced = 0;
-    while (produced < n) {
-      if (m_index == 0) [[unlikely]] {
-        pImpl->populate_cache();
-      }
-      const std::size_t available = static_cast<std::size_t>(CACHE_SIZE) - m_index;
-      const std::size_t to_copy = (n - produced < available) ? (n - produced) : available;
-      std::memcpy(out + produced, m_cache.data() + m_index, to_copy * sizeof(std::uint64_t));
-      m_index = static_cast<std::uint8_t>(m_index + to_copy);
-      if (m_index == CACHE_SIZE) {
-        m_index = 0;
-      }
-      produced += to_copy;
-    }
+    fill(arr.data(), arr.size());
   }
 };
 
 // -----------------------------------------------------------------------------
  
 
+// -----------------------------------------------------------------------------
+// Detects generators exposing a vectorized bulk uniform fill
+template <typename Rng, typename = void>
+struct has_fill_uniform : std::false_type {};
+
+template <typename Rng>
+struct has_fill_uniform<Rng, std::void_t<decltype(std::declval<Rng&>().fill_uniform(
+                                 std::declval<double*>(), std::declval<std::size_t>()))>> : std::true_type {};
+
 // -----------------------------------------------------------------------------
 // DirectBitGen: optimized adapter
 template <typename Rng>
@@ -175,8 +122,12 @@ struct alignas(64) DirectBitGen {
   }
 
   PRNG_ALWAYS_INLINE void refill() noexcept {
-    for (std::size_t i = 0; i < DCACHE; ++i) {
-      dcache[i] = static_cast<double>(rng() >> 11) * kInvPow53;
+    if constexpr (has_fill_uniform<Rng>::value) {
+      rng.fill_uniform(dcache.data(), DCACHE);
+    } else {
+      for (std::size_t i = 0; i < DCACHE; ++i) {
+        dcache[i] = static_cast<double>(rng() >> 11) * kInvPow53;
+      }
     }
     dpos = 0;
   }
@@ -202,6 +153,38 @@ struct alignas(64) DirectBitGen {
   }
 };
 
+// -----------------------------------------------------------------------------
+// NumPyBitGen: adapter for generators that reproduce a NumPy BitGenerator stream
+// exactly, so every callback forwards to the generator's own NumPy-compatible
+// method instead of going through a double cache.
+template <typename Rng>
+struct alignas(64) NumPyBitGen {
+  Rng      rng;
+  bitgen_t base;
+
+  template <typename... Args>
+  PRNG_ALWAYS_INLINE explicit NumPyBitGen(Args&&... args) noexcept
+  : rng(std::forward<Args>(args)...), base{} {
+    base.state       = this;
+    base.next_uint64 = &NumPyBitGen::next_u64;
+    base.next_uint32 = &NumPyBitGen::next_u32;
+    base.next_double = &NumPyBitGen::next_f64;
+    base.next_raw    = base.next_uint64;
+  }
+
+  PRNG_ALWAYS_INLINE static uint64_t next_u64(void* s) noexcept {
+    return static_cast<NumPyBitGen*>(s)->rng();
+  }
+
+  PRNG_ALWAYS_INLINE static uint32_t next_u32(void* s) noexcept {
+    return static_cast<NumPyBitGen*>(s)->rng.next_uint32();
+  }
+
+  PRNG_ALWAYS_INLINE static double next_f64(void* s) noexcept {
+    return static_cast<NumPyBitGen*>(s)->rng.uniform();
+  }
+};
+
 // -----------------------------------------------------------------------------
 // Capsule management: keep NumPy-facing pointer = bitgen_t*, but own the
 // DirectBitGen<T> via the capsule *context*, so we can delete safely.
@@ -255,14 +238,30 @@ PRNG_ALWAYS_INLINE nb::object make_xoshiro_native_bitgenerator(uint64_t seed, ui
   return make_direct_bitgenerator<XoshiroNative>(seed, thread, cluster);
 }
 
+PRNG_ALWAYS_INLINE nb::object make_philox_bitgenerator(const Philox::key_type& key,
+                                                      const Philox::counter_type& counter) {
+  auto* gen = new NumPyBitGen<PhiloxDispatch>(key, counter);
+  return make_direct_bitgenerator_capsule(gen);
+}
+
+PRNG_ALWAYS_INLINE nb::object make_pcg64dxsm_bitgenerator(const PCG64DXSM::state_type& state,
+                                                         const PCG64DXSM::state_type& inc) {
+  auto* gen = new NumPyBitGen<PCG64DXSM>(state, inc);
+  return make_direct_bitgenerator_capsule(gen);
+}
+
+PRNG_ALWAYS_INLINE nb::object make_seeded_pcg64dxsm_bitgenerator(const PCG64DXSM::state_type& initstate,
+                                                                const PCG64DXSM::state_type& initseq) {
+  auto* gen = new NumPyBitGen<PCG64DXSM>(PCG64DXSM::seeded(initstate, initseq));
+  return make_direct_bitgenerator_capsule(gen);
+}
+
 PRNG_ALWAYS_INLINE void fill_xoshiro_simd_array(uint64_t seed, nb::ndarray<nb::numpy, double, nb::ndim<1>, nb::c_contig> arr) {
   nb::gil_scoped_release release;
   auto* out = arr.data();
   const std::size_t n = arr.size();
   prng::XoshiroSIMD rng(seed);
-  for (std::size_t i = 0; i < n; ++i) {
-    out[i] = static_cast<double>(rng() >> 11) * kInvPow53;
-  }
+  rng.fill_uniform(out, n);
 }
 
 PRNG_ALWAYS_INLINE void fill_xoshiro_simd_uint64(uint64_t seed, nb::ndarray<nb::numpy, std::uint64_t, nb::ndim<1>, nb::c_contig> arr) {
@@ -270,9 +269,7 @@ PRNG_ALWAYS_INLINE void fill_xoshiro_simd_uint64(uint64_t seed, nb::ndarray<nb::
   auto* out = arr.data();
   const std::size_t n = arr.size();
   prng::XoshiroSIMD rng(seed);
-  for (std::size_t i = 0; i < n; ++i) {
-    out[i] = rng();
-  }
+  rng.fill(out, n);
 }
 
 // -----------------------------------------------------------------------------
@@ -332,6 +329,16 @@ NB_MODULE(pyrandom_ext, m) {
         nb::arg("seed"), nb::arg("thread"), nb::arg("cluster"),
         "Return a NumPy BitGenerator backed by XoshiroNative (seed, thread, cluster)");
 
+  m.def("create_philox_bit_generator", &make_philox_bitgenerator, nb::arg("key"), nb::arg("counter"),
+        "Return a NumPy BitGenerator backed by PhiloxDispatch, stream-compatible with numpy.random.Philox");
+
+  m.def("create_pcg64dxsm_bit_generator", &make_pcg64dxsm_bitgenerator, nb::arg("state"), nb::arg("inc"),
+        "Return a NumPy BitGenerator backed by PCG64DXSM with the given raw state and increment");
+
+  m.def("create_seeded_pcg64dxsm_bit_generator", &make_seeded_pcg64dxsm_bitgenerator, nb::arg("initstate"),
+        nb::arg("initseq"),
+        "Return a NumPy BitGenerator backed by PCG64DXSM, seeded like numpy.random.PCG64DXSM");
+
   m.def("fill_xoshiro_simd_array", &fill_xoshiro_simd_array, nb::arg("seed"), nb::arg("out"),
         "Fill a 1D numpy.ndarray[float64, C-contiguous] using XoshiroSIMD core bulk-fill (releases GIL)");
 
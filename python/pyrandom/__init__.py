@@ -8,6 +8,9 @@ from pyrandom_ext import (
     create_xoshiro_bit_generator,                  # Xoshiro (scalar)
     create_bit_generator as create_xoshiro_simd_bit_generator,  # XoshiroSIMD
     create_xoshiro_native_bit_generator,           # XoshiroNative (overloaded)
+    create_philox_bit_generator,                   # PhiloxDispatch
+    create_pcg64dxsm_bit_generator,                # PCG64DXSM (raw state)
+    create_seeded_pcg64dxsm_bit_generator,         # PCG64DXSM (seeded)
     # Core persistent RNG with bulk-fill
     XoshiroSIMD as _CoreXoshiroSIMD,
 )
@@ -116,9 +119,63 @@ def XoshiroNative(
     return np.random.Generator(_CapsuleBitGen(cap))
 
 
+def _int_to_words(value: int, words: int, name: str) -> list:
+    """Split a non-negative integer into `words` 64-bit words, least significant first."""
+    value = int(value)
+    if value < 0 or value >= 1 << (64 * words):
+        raise ValueError(f"{name} must be a non-negative integer below 2**{64 * words}")
+    return [(value >> (64 * i)) & 0xFFFFFFFFFFFFFFFF for i in range(words)]
+
+
+def Philox(
+        seed=None,
+        key: Optional[int] = None,
+        counter: int = 0,
+) -> np.random.Generator:
+    """np.random.Generator backed by the SIMD Philox4x64-10.
+
+    The stream is identical to ``np.random.Generator(np.random.Philox(seed))``:
+    the key is derived from ``np.random.SeedSequence(seed)`` unless given
+    explicitly as a 128-bit integer, and ``counter`` is a 256-bit integer.
+    """
+    if key is None:
+        key_words = [int(w) for w in np.random.SeedSequence(seed).generate_state(2, np.uint64)]
+    elif seed is not None:
+        raise ValueError("seed and key cannot be both used")
+    else:
+        key_words = _int_to_words(key, 2, "key")
+    cap = create_philox_bit_generator(key_words, _int_to_words(counter, 4, "counter"))
+    return np.random.Generator(_CapsuleBitGen(cap))
+
+
+def PCG64DXSM(
+        seed=None,
+        state: Optional[int] = None,
+        inc: Optional[int] = None,
+) -> np.random.Generator:
+    """np.random.Generator backed by PCG64DXSM.
+
+    The stream is identical to ``np.random.Generator(np.random.PCG64DXSM(seed))``:
+    the generator is seeded from ``np.random.SeedSequence(seed)`` unless the raw
+    128-bit ``state`` and odd ``inc`` are given, as in NumPy's ``state`` dict.
+    """
+    if state is None and inc is None:
+        words = [int(w) for w in np.random.SeedSequence(seed).generate_state(4, np.uint64)]
+        cap = create_seeded_pcg64dxsm_bit_generator([words[1], words[0]], [words[3], words[2]])
+    elif seed is not None:
+        raise ValueError("seed and state cannot be both used")
+    elif state is None or inc is None:
+        raise ValueError("state and inc must be given together")
+    else:
+        cap = create_pcg64dxsm_bit_generator(_int_to_words(state, 2, "state"), _int_to_words(inc, 2, "inc"))
+    return np.random.Generator(_CapsuleBitGen(cap))
+
+
 __all__ = [
     "SplitMix",
     "Xoshiro",
     "XoshiroSIMD",
     "XoshiroNative",
+    "Philox",
+    "PCG64DXSM",
 ]
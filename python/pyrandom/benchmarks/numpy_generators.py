@@ -47,8 +47,11 @@ def _benchmark(name: str, factory: Callable[[], np.random.Generator], *, size: i
 def main() -> None:
     generators: Dict[str, Callable[[], np.random.Generator]] = {
         "Philox": lambda: np.random.Generator(np.random.Philox(1234)),
+        "pyrandom Philox": lambda: pyrandom.Philox(1234),
         "XoshiroSIMD": lambda: pyrandom.XoshiroSIMD(1234),
         "PCG64": lambda: np.random.Generator(np.random.PCG64(1234)),
+        "PCG64DXSM": lambda: np.random.Generator(np.random.PCG64DXSM(1234)),
+        "pyrandom PCG64DXSM": lambda: pyrandom.PCG64DXSM(1234),
         "XoshiroNative": lambda: pyrandom.XoshiroNative(1234),
         "MT19937": lambda: np.random.Generator(np.random.MT19937(1234)),
         "default_rng": lambda: np.random.default_rng(1234),
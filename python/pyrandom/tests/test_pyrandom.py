@@ -42,3 +42,51 @@ def test_xoshiro_distributions():
 def test_simd_distributions():
     _run_distribution_checks(pyrandom.XoshiroSIMD(123))
 
+
+def test_philox_distributions():
+    _run_distribution_checks(pyrandom.Philox(123))
+
+
+def test_philox_matches_numpy():
+    for seed in (0, 123, 2**63 + 5):
+        ours = pyrandom.Philox(seed)
+        reference = np.random.Generator(np.random.Philox(seed))
+        assert np.array_equal(ours.integers(0, 2**64, size=1001, dtype=np.uint64),
+                              reference.integers(0, 2**64, size=1001, dtype=np.uint64))
+        assert np.array_equal(ours.integers(0, 2**32, size=1001, dtype=np.uint32),
+                              reference.integers(0, 2**32, size=1001, dtype=np.uint32))
+        assert np.array_equal(ours.random(1001), reference.random(1001))
+        assert np.array_equal(ours.normal(size=1001), reference.normal(size=1001))
+
+
+def test_philox_key_and_counter_match_numpy():
+    key, counter = 2**127 + 12345, 2**200 + 2**64 - 3
+    ours = pyrandom.Philox(key=key, counter=counter)
+    reference = np.random.Generator(np.random.Philox(key=key, counter=counter))
+    assert np.array_equal(ours.random(257), reference.random(257))
+
+
+def test_pcg64dxsm_distributions():
+    _run_distribution_checks(pyrandom.PCG64DXSM(123))
+
+
+def test_pcg64dxsm_matches_numpy():
+    for seed in (0, 123, 2**63 + 5):
+        ours = pyrandom.PCG64DXSM(seed)
+        reference = np.random.Generator(np.random.PCG64DXSM(seed))
+        assert np.array_equal(ours.integers(0, 2**64, size=1001, dtype=np.uint64),
+                              reference.integers(0, 2**64, size=1001, dtype=np.uint64))
+        assert np.array_equal(ours.integers(0, 2**32, size=1001, dtype=np.uint32),
+                              reference.integers(0, 2**32, size=1001, dtype=np.uint32))
+        assert np.array_equal(ours.random(1001), reference.random(1001))
+        assert np.array_equal(ours.normal(size=1001), reference.normal(size=1001))
+
+
+def test_pcg64dxsm_state_matches_numpy():
+    state, inc = 2**127 + 12345, 2**100 + 7
+    ours = pyrandom.PCG64DXSM(state=state, inc=inc)
+    bit_generator = np.random.PCG64DXSM()
+    bit_generator.state = {"bit_generator": "PCG64DXSM", "state": {"state": state, "inc": inc},
+                           "has_uint32": 0, "uinteger": 0}
+    reference = np.random.Generator(bit_generator)
+    assert np.array_equal(ours.random(257), reference.random(257))
@@ -0,0 +1,84 @@
+#include "random/aes_ctr_simd.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace prng {
+
+namespace internal {
+
+namespace {
+
+/**
+ * Reads the ECX register of a CPUID leaf, or 0 when the leaf is not supported.
+ */
+unsigned cpuid_ecx(const unsigned leaf, const unsigned subleaf) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int info[4];
+  __cpuid(info, 0);
+  if (static_cast<unsigned>(info[0]) < leaf) {
+    return 0;
+  }
+  __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+  return static_cast<unsigned>(info[2]);
+#elif defined(__x86_64__) || defined(__i386__)
+  unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid_count(leaf, subleaf, &eax, &ebx, &ecx, &edx) == 0) {
+    return 0;
+  }
+  return ecx;
+#else
+  static_cast<void>(leaf);
+  static_cast<void>(subleaf);
+  return 0;
+#endif
+}
+
+} // namespace
+
+bool cpu_has_aes() noexcept {
+  static const bool has_aes = (cpuid_ecx(1, 0) >> 25 & 1) != 0;
+  return has_aes;
+}
+
+bool cpu_has_vaes() noexcept {
+  static const bool has_vaes = (cpuid_ecx(7, 0) >> 9 & 1) != 0;
+  return has_vaes;
+}
+
+} // namespace internal
+
+using namespace internal;
+
+template <std::uint8_t R> const AESCTRTable &aes_ctr_table() noexcept {
+  // AES-NI and VAES are not part of any x86-64 level, so they are checked on top of the architecture xsimd detects,
+  // once per process.
+  static const auto *const table = []() noexcept -> const AESCTRTable * {
+    const AESCTRTableCreator<R> creator{};
+    if (!cpu_has_aes()) {
+      return &AESCTRKernels<R, aes_software>::table;
+    }
+    const auto available = xsimd::available_architectures();
+    if (cpu_has_vaes()) {
+      if (available.avx512f) {
+        return creator(xsimd::avx512f{});
+      }
+      if (available.fma3_avx2) {
+        return creator(xsimd::fma3<xsimd::avx2>{});
+      }
+    }
+    if (available.sse4_2) {
+      return creator(xsimd::sse4_2{});
+    }
+    return creator(xsimd::sse2{});
+  }();
+  return *table;
+}
+
+template const AESCTRTable &aes_ctr_table<5>() noexcept;
+template const AESCTRTable &aes_ctr_table<10>() noexcept;
+
+} // namespace prng
@@ -0,0 +1,19 @@
+#include "random/chacha_simd.hpp"
+
+namespace prng {
+
+using namespace internal;
+
+template <std::uint8_t R> const ChaChaSIMDTable &chacha_simd_table() noexcept {
+  // Dispatch to the appropriate implementation based on runtime-detected
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(ChaChaSIMDTableCreator<R>{})();
+  return *table;
+}
+
+template const ChaChaSIMDTable &chacha_simd_table<8>() noexcept;
+template const ChaChaSIMDTable &chacha_simd_table<12>() noexcept;
+template const ChaChaSIMDTable &chacha_simd_table<20>() noexcept;
+
+} // namespace prng
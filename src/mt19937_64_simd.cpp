@@ -0,0 +1,15 @@
+#include "random/mt19937_64_simd.hpp"
+
+namespace prng {
+
+using namespace internal;
+
+const MT19937_64SIMDTable &mt19937_64_simd_table() noexcept {
+  // Dispatch to the appropriate implementation based on runtime-detected
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(MT19937_64SIMDTableCreator{})();
+  return *table;
+}
+
+} // namespace prng
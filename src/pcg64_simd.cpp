@@ -0,0 +1,15 @@
+#include "random/pcg64_simd.hpp"
+
+namespace prng {
+
+using namespace internal;
+
+const PCG64DXSMSIMDTable &pcg64_simd_table() noexcept {
+  // Dispatch to the appropriate implementation based on runtime-detected
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(PCG64DXSMSIMDTableCreator{})();
+  return *table;
+}
+
+} // namespace prng
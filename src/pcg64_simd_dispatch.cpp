@@ -0,0 +1,30 @@
+#include <random/pcg64_simd.hpp>
+#include <xsimd/xsimd.hpp>
+
+namespace prng {
+
+namespace internal {
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__AVX512F__)
+PRNG_PCG64_SIMD_TABLES(, xsimd::avx512f)
+#elif defined(__AVX__) && defined(__AVX2__) && defined(__FMA__)
+PRNG_PCG64_SIMD_TABLES(, xsimd::fma3<xsimd::avx2>)
+#elif defined(__SSE4_1__) && defined(__SSE4_2__) && defined(__SSSE3__) && defined(__SSE3__)
+PRNG_PCG64_SIMD_TABLES(, xsimd::sse4_2)
+#elif defined(__SSE__) && defined(__SSE2__) && defined(__MMX__)
+PRNG_PCG64_SIMD_TABLES(, xsimd::sse2)
+
+#else
+#error "no SIMD instruction set enabled"
+#endif
+
+#else
+// here we can add mac and arm support
+#error "Unsupported x86-64 architecture"
+
+#endif
+
+} // namespace internal
+
+} // namespace prng
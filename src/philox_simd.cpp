@@ -0,0 +1,15 @@
+#include "random/philox_simd.hpp"
+
+namespace prng {
+
+using namespace internal;
+
+const PhiloxSIMDTable &philox_simd_table() noexcept {
+  // Dispatch to the appropriate implementation based on runtime-detected
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(PhiloxSIMDTableCreator{})();
+  return *table;
+}
+
+} // namespace prng
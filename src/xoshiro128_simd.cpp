@@ -0,0 +1,18 @@
+#include "random/xoshiro128_simd.hpp"
+
+namespace prng {
+
+using namespace internal;
+
+template <class Scrambler> const Xoshiro128SIMDTable &xoshiro128_simd_table() noexcept {
+  // Dispatch to the appropriate implementation based on runtime-detected
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(Xoshiro128SIMDTableCreator<Scrambler>{})();
+  return *table;
+}
+
+template const Xoshiro128SIMDTable &xoshiro128_simd_table<ScramblerPlusPlus>() noexcept;
+template const Xoshiro128SIMDTable &xoshiro128_simd_table<ScramblerStarStar>() noexcept;
+
+} // namespace prng
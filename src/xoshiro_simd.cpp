@@ -4,19 +4,17 @@ namespace prng {
 
 using namespace internal;
 
-std::unique_ptr<XoshiroSIMD::IXoshiroSIMD>
-create_xoshiro_simd_impl(XoshiroSIMD::result_type seed, XoshiroSIMD::result_type thread_id,
-                         XoshiroSIMD::result_type cluster_id,
-                         std::array<XoshiroSIMD::result_type, XoshiroSIMD::CACHE_SIZE> &cache) {
+template <class Scrambler> const XoshiroSIMDTable &xoshiro_simd_table(const bool canonical) noexcept {
   // Dispatch to the appropriate implementation based on runtime-detected
-  // architecture.
-  return xsimd::dispatch<xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>>(
-      XoshiroSIMDCreator{seed, thread_id, cluster_id, cache})();
+  // architecture, once per process.
+  using arch_list = xsimd::arch_list<xsimd::avx512f, xsimd::fma3<xsimd::avx2>, xsimd::sse4_2, xsimd::sse2>;
+  static const auto *const table = xsimd::dispatch<arch_list>(XoshiroSIMDTableCreator<Scrambler>{false})();
+  static const auto *const canonical_table = xsimd::dispatch<arch_list>(XoshiroSIMDTableCreator<Scrambler>{true})();
+  return canonical ? *canonical_table : *table;
 }
 
-// Definitions of XoshiroSIMD's member functions.
-XoshiroSIMD::XoshiroSIMD(const result_type seed, const result_type thread_id, const result_type cluster_id) noexcept
-    : m_cache{}, pImpl{create_xoshiro_simd_impl(seed, thread_id, cluster_id, m_cache)}, m_index{0} {}
+template const XoshiroSIMDTable &xoshiro_simd_table<ScramblerPlusPlus>(bool canonical) noexcept;
+template const XoshiroSIMDTable &xoshiro_simd_table<ScramblerPlus>(bool canonical) noexcept;
+template const XoshiroSIMDTable &xoshiro_simd_table<ScramblerStarStar>(bool canonical) noexcept;
 
-// fill_uniform / fill_uint64 have been moved to the Python extension.
 } // namespace prng
@@ -1,20 +1,19 @@
-#include <memory>
 #include <random/xoshiro_simd.hpp>
 #include <xsimd/xsimd.hpp>
 
 namespace prng {
 
-using XoshiroSIMDCreator = internal::XoshiroSIMDCreator;
+namespace internal {
 
 #if defined(__x86_64__) || defined(_M_X64)
 #if defined(__AVX512F__)
-template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator()<xsimd::avx512f>(xsimd::avx512f) const;
+PRNG_XOSHIRO_SIMD_TABLES(, xsimd::avx512f)
 #elif defined(__AVX__) && defined(__AVX2__) && defined(__FMA__)
-template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator()<xsimd::fma3<xsimd::avx2>>(xsimd::fma3<xsimd::avx2>) const;
+PRNG_XOSHIRO_SIMD_TABLES(, xsimd::fma3<xsimd::avx2>)
 #elif defined(__SSE4_1__) && defined(__SSE4_2__) && defined(__SSSE3__) && defined(__SSE3__)
-template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator()<xsimd::sse4_2>(xsimd::sse4_2) const;
+PRNG_XOSHIRO_SIMD_TABLES(, xsimd::sse4_2)
 #elif defined(__SSE__) && defined(__SSE2__) && defined(__MMX__)
-template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator()<xsimd::sse2>(xsimd::sse2) const;
+PRNG_XOSHIRO_SIMD_TABLES(, xsimd::sse2)
 
 #else
 #error "no SIMD instruction set enabled"
@@ -26,4 +25,6 @@ template std::unique_ptr<XoshiroSIMD::IXoshiroSIMD> XoshiroSIMDCreator::operator
 
 #endif
 
+} // namespace internal
+
 } // namespace prng
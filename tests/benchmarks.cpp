@@ -1,13 +1,36 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <mutex>
 #include <nanobench.h>
 #include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <random/aes_ctr.hpp>
+#include <random/aes_ctr_simd.hpp>
 #include <random/chacha.hpp>
+#include <random/chacha_bank.hpp>
+#include <random/chacha_row.hpp>
+#include <random/chacha_shared.hpp>
 #include <random/chacha_simd.hpp>
+#include <random/mt19937_64_simd.hpp>
+#include <random/pcg64.hpp>
+#include <random/pcg64_simd.hpp>
+#include <random/philox.hpp>
+#include <random/philox_simd.hpp>
+#include <random/seed_sequence.hpp>
+#include <random/sobol.hpp>
+#include <random/splitmix_simd.hpp>
+#include <random/xoshiro128_simd.hpp>
 #include <random/xoshiro_simd.hpp>
 
 #include "xoshiro256plusplus.c"
 
 static constexpr auto iterations = 1;
+static constexpr auto fill_size = 1 << 16;
 
 namespace {
 
@@ -24,6 +47,70 @@ ankerl::nanobench::Bench make_bench(const char *title, const char *unit,
     .relative(true);
 }
 
+/**
+ * Runs `work` on `count` threads and waits for all of them.
+ */
+template <class Work> void run_threads(const unsigned count, const Work &work) {
+  std::vector<std::thread> threads;
+  for (auto i = 0U; i < count; ++i) {
+    threads.emplace_back(work);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * Compares one, two and four interleaved xoshiro state groups on a single instruction set, skipping it when the CPU
+ * does not support it.
+ */
+template <class Arch>
+void bench_state_groups(const std::uint64_t seed, std::vector<std::uint64_t> &buffer, const bool available) {
+  using ankerl::nanobench::doNotOptimizeAway;
+  if (!available) {
+    std::cout << Arch::name() << " is not available on this CPU, skipping state groups" << std::endl;
+    return;
+  }
+  alignas(Arch::alignment()) std::array<std::uint64_t, 256> cache_1{};
+  alignas(Arch::alignment()) std::array<std::uint64_t, 256> cache_2{};
+  alignas(Arch::alignment()) std::array<std::uint64_t, 256> cache_4{};
+  prng::internal::XoshiroSIMDImpl<Arch, 256, 1> groups_1(seed, cache_1);
+  prng::internal::XoshiroSIMDImpl<Arch, 256, 2> groups_2(seed, cache_2);
+  prng::internal::XoshiroSIMDImpl<Arch, 256, 4> groups_4(seed, cache_4);
+  const auto title = std::string("Interleaved state groups ") + Arch::name();
+  make_bench(title.c_str(), "sample", static_cast<double>(buffer.size()))
+    .run("XoshiroSIMD 1 group fill UINT64", [&] {
+      groups_1.fill(buffer.data(), buffer.size());
+      doNotOptimizeAway(buffer.data());
+    })
+    .run("XoshiroSIMD 2 groups fill UINT64", [&] {
+      groups_2.fill(buffer.data(), buffer.size());
+      doNotOptimizeAway(buffer.data());
+    })
+    .run("XoshiroSIMD 4 groups fill UINT64", [&] {
+      groups_4.fill(buffer.data(), buffer.size());
+      doNotOptimizeAway(buffer.data());
+    })
+    .run("XoshiroSIMD 1 group loop UINT64", [&] {
+      for (auto &value : buffer) {
+        value = groups_1();
+      }
+      doNotOptimizeAway(buffer.data());
+    })
+    .run("XoshiroSIMD 2 groups loop UINT64", [&] {
+      for (auto &value : buffer) {
+        value = groups_2();
+      }
+      doNotOptimizeAway(buffer.data());
+    })
+    .run("XoshiroSIMD 4 groups loop UINT64", [&] {
+      for (auto &value : buffer) {
+        value = groups_4();
+      }
+      doNotOptimizeAway(buffer.data());
+    });
+}
+
 } // namespace
 
 int main() {
@@ -47,6 +134,33 @@ int main() {
   SimdChaCha20 chacha_simd_double(chacha_key, chacha_counter, chacha_nonce);
   ScalarChaCha20 chacha_scalar_dist(chacha_key, chacha_counter, chacha_nonce);
   SimdChaCha20 chacha_simd_dist(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaDispatch<20> chacha_dispatch_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaDispatch<20> chacha_dispatch_double(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaRow<20> chacha_row_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha12 chacha12_scalar_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha12SIMD chacha12_simd_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha8 chacha8_scalar_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha8SIMD chacha8_simd_uint64(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha12Dispatch chacha12_dispatch(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaCha8Dispatch chacha8_dispatch(chacha_key, chacha_counter, chacha_nonce);
+  constexpr prng::Philox::key_type philox_key = {0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL};
+  prng::Philox philox_scalar(philox_key);
+  prng::PhiloxSIMD<xsimd::best_arch> philox_simd(philox_key);
+  prng::PhiloxDispatch philox_dispatch(philox_key);
+  constexpr prng::AESCTR10::key_type aes_key = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  std::cout << "AES-NI: " << prng::AESCTR10Dispatch::accelerated() << std::endl;
+  prng::AESCTR10 aes10_scalar(aes_key, chacha_counter, chacha_nonce);
+  prng::AESCTR10Dispatch aes10_dispatch(aes_key, chacha_counter, chacha_nonce);
+  prng::AESCTR5Dispatch aes5_dispatch(aes_key, chacha_counter, chacha_nonce);
+  prng::CryptoDispatch crypto_dispatch(chacha_key, chacha_counter, chacha_nonce);
+  auto pcg64_scalar = prng::PCG64DXSM::seeded({seed, 0}, {0, 0});
+  prng::PCG64DXSMSIMD<xsimd::best_arch> pcg64_simd({seed, 0});
+  prng::PCG64DXSMDispatch pcg64_dispatch({seed, 0});
+  prng::SplitMix splitmix_scalar(seed);
+  prng::SplitMixSIMD<xsimd::best_arch> splitmix_simd(seed);
+  prng::MT19937_64SIMD<xsimd::best_arch> mt_simd(seed);
+  prng::MT19937_64Dispatch mt_dispatch(seed);
 
   s[0] = reference.getState()[0];
   s[1] = reference.getState()[1];
@@ -91,6 +205,567 @@ int main() {
       for (int i = 0; i < iterations; ++i) {
         doNotOptimizeAway(chacha_simd_uint64());
       }
+    })
+    .run("ChaCha20 Dispatch UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha_dispatch_uint64());
+      }
+    })
+    .run("ChaCha20 row UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha_row_uint64());
+      }
+    })
+    .run("ChaCha12 scalar UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha12_scalar_uint64());
+      }
+    })
+    .run("ChaCha12 SIMD UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha12_simd_uint64());
+      }
+    })
+    .run("ChaCha8 scalar UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha8_scalar_uint64());
+      }
+    })
+    .run("ChaCha8 SIMD UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(chacha8_simd_uint64());
+      }
+    })
+    .run("Philox scalar UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(philox_scalar());
+      }
+    })
+    .run("Philox SIMD UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(philox_simd());
+      }
+    })
+    .run("Philox Dispatch UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(philox_dispatch());
+      }
+    })
+    .run("AES128-CTR scalar UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(aes10_scalar());
+      }
+    })
+    .run("AES128-CTR Dispatch UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(aes10_dispatch());
+      }
+    })
+    .run("PCG64DXSM scalar UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(pcg64_scalar());
+      }
+    })
+    .run("PCG64DXSM SIMD UINT64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(pcg64_simd());
+      }
+    });
+
+  // a fresh generator per run: construction plus the latency of the first block (or batch of blocks)
+  make_bench("ChaCha20 time to first output", "generator", 1.0)
+    .run("ChaCha20 scalar first UINT64", [&] {
+      ScalarChaCha20 fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh());
+    })
+    .run("ChaCha20 SIMD first UINT64", [&] {
+      SimdChaCha20 fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh());
+    })
+    .run("ChaCha20 row first UINT64", [&] {
+      prng::ChaChaRow<20> fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh());
+    })
+    .run("ChaCha20 scalar first block", [&] {
+      ScalarChaCha20 fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh.block());
+    })
+    .run("ChaCha20 SIMD first block", [&] {
+      SimdChaCha20 fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh.block());
+    })
+    .run("ChaCha20 row first block", [&] {
+      prng::ChaChaRow<20> fresh(chacha_key, chacha_counter, chacha_nonce);
+      doNotOptimizeAway(fresh.block());
+    });
+
+  std::vector<std::uint64_t> fill_buffer(fill_size);
+  // random positions for SplitMix random access
+  std::vector<std::uint64_t> splitmix_indices(fill_size);
+  for (auto &index : splitmix_indices) {
+    index = mt();
+  }
+  make_bench("UINT64 bulk fill", "sample", static_cast<double>(fill_size))
+    .run("XoshiroSIMD loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = rng();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("XoshiroSIMD fill UINT64", [&] {
+      rng.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("Dispatch Xoshiro loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = dispatch();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("Dispatch Xoshiro fill UINT64", [&] {
+      dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 Dispatch fill UINT64", [&] {
+      chacha_dispatch_uint64.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("Philox scalar loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = philox_scalar();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("Philox SIMD fill UINT64", [&] {
+      philox_simd.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("Philox Dispatch fill UINT64", [&] {
+      philox_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("AES128-CTR Dispatch fill UINT64", [&] {
+      aes10_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("AES-CTR 5 rounds Dispatch fill UINT64", [&] {
+      aes5_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("CryptoDispatch fill UINT64", [&] {
+      crypto_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("PCG64DXSM scalar loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = pcg64_scalar();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("PCG64DXSM SIMD fill UINT64", [&] {
+      pcg64_simd.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("PCG64DXSM Dispatch fill UINT64", [&] {
+      pcg64_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("MersenneTwister loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = mt();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("MT19937_64 SIMD fill UINT64", [&] {
+      mt_simd.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("MT19937_64 Dispatch fill UINT64", [&] {
+      mt_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("SplitMix scalar loop UINT64", [&] {
+      for (auto &value : fill_buffer) {
+        value = splitmix_scalar();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("SplitMixSIMD fill UINT64", [&] {
+      splitmix_simd.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("SplitMixSIMD at UINT64", [&] {
+      prng::SplitMixSIMD<xsimd::best_arch>::at(seed, splitmix_indices.data(), fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    });
+
+  // batch depth is the number of SIMD batches whose rounds are interleaved; the keystream is the same for all of them
+  prng::ChaChaSIMD<20, xsimd::best_arch, 1> chacha20_depth1(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<20, xsimd::best_arch, 2> chacha20_depth2(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<20, xsimd::best_arch, 4> chacha20_depth4(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<12, xsimd::best_arch, 2> chacha12_depth2(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<8, xsimd::best_arch, 2> chacha8_depth2(chacha_key, chacha_counter, chacha_nonce);
+  make_bench("ChaCha rounds and batch depth", "sample", static_cast<double>(fill_size))
+    .run("ChaCha20 SIMD depth 1 fill UINT64", [&] {
+      chacha20_depth1.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD depth 2 fill UINT64", [&] {
+      chacha20_depth2.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD depth 4 fill UINT64", [&] {
+      chacha20_depth4.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha12 SIMD depth 2 fill UINT64", [&] {
+      chacha12_depth2.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha8 SIMD depth 2 fill UINT64", [&] {
+      chacha8_depth2.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha12 Dispatch fill UINT64", [&] {
+      chacha12_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha8 Dispatch fill UINT64", [&] {
+      chacha8_dispatch.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    });
+
+  // what the transpose to the standard block order costs, on SSE2 and on the widest instruction set compiled for
+  prng::ChaChaSIMD<20, xsimd::sse2> chacha20_sse2_standard(chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<20, xsimd::sse2, 1, prng::ChaChaOrder::lane_interleaved> chacha20_sse2_interleaved(
+    chacha_key, chacha_counter, chacha_nonce);
+  prng::ChaChaSIMD<20, xsimd::best_arch, prng::internal::chacha_default_depth<xsimd::best_arch>(),
+                   prng::ChaChaOrder::lane_interleaved>
+    chacha20_best_interleaved(chacha_key, chacha_counter, chacha_nonce);
+  make_bench("ChaCha20 output order", "sample", static_cast<double>(fill_size))
+    .run("ChaCha20 SSE2 standard fill UINT64", [&] {
+      chacha20_sse2_standard.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SSE2 lane-interleaved fill UINT64", [&] {
+      chacha20_sse2_interleaved.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD standard fill UINT64", [&] {
+      chacha_simd_uint64.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD lane-interleaved fill UINT64", [&] {
+      chacha20_best_interleaved.fill(fill_buffer.data(), fill_buffer.size());
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD standard UINT64 loop", [&] {
+      for (auto &value : fill_buffer) {
+        value = chacha_simd_uint64();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("ChaCha20 SIMD lane-interleaved UINT64 loop", [&] {
+      for (auto &value : fill_buffer) {
+        value = chacha20_best_interleaved();
+      }
+      doNotOptimizeAway(fill_buffer.data());
+    });
+
+  // one block per entity and step: a bank of streams against one generator object per entity
+  constexpr auto entity_count = std::size_t{4096};
+  prng::ChaChaBank<20> chacha_bank(chacha_key, entity_count, chacha_counter);
+  std::vector<ScalarChaCha20> chacha_entities_scalar;
+  std::vector<SimdChaCha20> chacha_entities_simd;
+  for (auto i = std::size_t{0}; i < entity_count; ++i) {
+    chacha_entities_scalar.emplace_back(chacha_key, chacha_counter, i);
+    chacha_entities_simd.emplace_back(chacha_key, chacha_counter, i);
+  }
+  std::vector<ScalarChaCha20::matrix_type> entity_blocks(entity_count);
+  std::cout << "ChaCha bank bytes per stream: " << prng::ChaChaBank<20>::stream_bytes()
+            << ", ChaChaSIMD bytes per object: " << sizeof(SimdChaCha20) << std::endl;
+  make_bench("ChaCha20 per-entity streams", "block", static_cast<double>(entity_count))
+    .run("ChaCha20 scalar per entity", [&] {
+      for (auto i = std::size_t{0}; i < entity_count; ++i) {
+        entity_blocks[i] = chacha_entities_scalar[i].block();
+      }
+      doNotOptimizeAway(entity_blocks.data());
+    })
+    .run("ChaCha20 SIMD per entity", [&] {
+      for (auto i = std::size_t{0}; i < entity_count; ++i) {
+        entity_blocks[i] = chacha_entities_simd[i].block();
+      }
+      doNotOptimizeAway(entity_blocks.data());
+    })
+    .run("ChaCha20 bank", [&] {
+      chacha_bank.next_blocks(entity_blocks.data());
+      doNotOptimizeAway(entity_blocks.data());
+    });
+
+  std::vector<std::byte> keystream_buffer(fill_size * sizeof(std::uint64_t));
+  make_bench("ChaCha20 keystream", "byte", static_cast<double>(keystream_buffer.size()))
+    .run("ChaCha20 SIMD block() loop", [&] {
+      for (auto i = std::size_t{0}; i < keystream_buffer.size(); i += 64) {
+        const auto block = chacha_simd_uint64.block();
+        std::memcpy(keystream_buffer.data() + i, block.data(), 64);
+      }
+      doNotOptimizeAway(keystream_buffer.data());
+    })
+    .run("ChaCha20 SIMD fill_bytes", [&] {
+      chacha_simd_uint64.fill_bytes(keystream_buffer.data(), keystream_buffer.size());
+      doNotOptimizeAway(keystream_buffer.data());
+    })
+    .run("ChaCha20 SIMD xor_keystream", [&] {
+      chacha_simd_uint64.xor_keystream(keystream_buffer.data(), keystream_buffer.size());
+      doNotOptimizeAway(keystream_buffer.data());
+    });
+
+  std::vector<double> fill_uniform_buffer(fill_size);
+  make_bench("DOUBLE bulk fill", "sample", static_cast<double>(fill_size))
+    .run("XoshiroSIMD loop DOUBLE", [&] {
+      for (auto &value : fill_uniform_buffer) {
+        value = rng.uniform();
+      }
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("XoshiroSIMD fill_uniform DOUBLE", [&] {
+      rng.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Dispatch Xoshiro fill_uniform DOUBLE", [&] {
+      dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("ChaCha20 SIMD fill_uniform DOUBLE", [&] {
+      chacha_simd_double.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("ChaCha20 Dispatch fill_uniform DOUBLE", [&] {
+      chacha_dispatch_double.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Philox Dispatch fill_uniform DOUBLE", [&] {
+      philox_dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("AES128-CTR Dispatch fill_uniform DOUBLE", [&] {
+      aes10_dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("PCG64DXSM Dispatch fill_uniform DOUBLE", [&] {
+      pcg64_dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("MT19937_64 Dispatch fill_uniform DOUBLE", [&] {
+      mt_dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    });
+
+  // 8-dimensional points, restarted at the first point so that runs never exhaust the 2^32 points
+  constexpr auto sobol_dims = std::size_t{8};
+  constexpr auto sobol_points = fill_size / sobol_dims;
+  prng::Sobol<sobol_dims> sobol_plain;
+  prng::Sobol<sobol_dims> sobol_matrix(seed, prng::SobolScrambling::linear_matrix);
+  prng::Sobol<sobol_dims> sobol_owen(seed, prng::SobolScrambling::owen);
+  make_bench("Quasi-random points", "sample", static_cast<double>(fill_size))
+    .run("XoshiroSIMD uniform loop DOUBLE", [&] {
+      for (auto &value : fill_uniform_buffer) {
+        value = dispatch.uniform();
+      }
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("XoshiroSIMD fill_uniform DOUBLE", [&] {
+      dispatch.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Sobol<8> fill DOUBLE", [&] {
+      sobol_plain.seek(0);
+      sobol_plain.fill(fill_uniform_buffer.data(), sobol_points);
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Sobol<8> linear matrix scrambled fill DOUBLE", [&] {
+      sobol_matrix.seek(0);
+      sobol_matrix.fill(fill_uniform_buffer.data(), sobol_points);
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Sobol<8> Owen scrambled fill DOUBLE", [&] {
+      sobol_owen.seek(0);
+      sobol_owen.fill(fill_uniform_buffer.data(), sobol_points);
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    });
+
+  prng::BasicXoshiroNative<0> native_cache_0(seed);
+  prng::BasicXoshiroNative<64> native_cache_64(seed);
+  prng::BasicXoshiroNative<1024> native_cache_1024(seed);
+  prng::BasicXoshiroNative<4096> native_cache_4096(seed);
+  prng::BasicXoshiroSIMD<0> dispatch_cache_0(seed);
+  prng::BasicXoshiroSIMD<1024> dispatch_cache_1024(seed);
+  make_bench("Cache size", "sample", static_cast<double>(iterations))
+    .run("XoshiroSIMD cache 0", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(native_cache_0());
+      }
+    })
+    .run("XoshiroSIMD cache 64", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(native_cache_64());
+      }
+    })
+    .run("XoshiroSIMD cache 256", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(rng());
+      }
+    })
+    .run("XoshiroSIMD cache 1024", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(native_cache_1024());
+      }
+    })
+    .run("XoshiroSIMD cache 4096", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(native_cache_4096());
+      }
+    })
+    .run("Dispatch Xoshiro cache 0", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(dispatch_cache_0());
+      }
+    })
+    .run("Dispatch Xoshiro cache 256", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(dispatch());
+      }
+    })
+    .run("Dispatch Xoshiro cache 1024", [&] {
+      for (int i = 0; i < iterations; ++i) {
+        doNotOptimizeAway(dispatch_cache_1024());
+      }
+    });
+
+  // the same group counts on SSE2 and on every wider instruction set compiled for
+  const auto available = xsimd::available_architectures();
+  bench_state_groups<xsimd::sse2>(seed, fill_buffer, available.sse2);
+#if XSIMD_WITH_AVX2
+  bench_state_groups<xsimd::avx2>(seed, fill_buffer, available.avx2);
+#endif
+#if XSIMD_WITH_AVX512F
+  bench_state_groups<xsimd::avx512f>(seed, fill_buffer, available.avx512f);
+#endif
+
+  prng::XoshiroPlusNative native_plus(seed);
+  prng::XoshiroStarStarNative native_starstar(seed);
+  prng::XoshiroPlusSIMD dispatch_plus(seed);
+  make_bench("Scramblers", "sample", static_cast<double>(fill_size))
+    .run("xoshiro256++ fill_uniform DOUBLE", [&] {
+      rng.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("xoshiro256+ fill_uniform DOUBLE", [&] {
+      native_plus.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("xoshiro256** fill_uniform DOUBLE", [&] {
+      native_starstar.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("Dispatch xoshiro256+ fill_uniform DOUBLE", [&] {
+      dispatch_plus.fill_uniform(fill_uniform_buffer.data(), fill_uniform_buffer.size());
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("xoshiro256++ loop DOUBLE", [&] {
+      for (auto &value : fill_uniform_buffer) {
+        value = rng.uniform();
+      }
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    })
+    .run("xoshiro256+ loop DOUBLE", [&] {
+      for (auto &value : fill_uniform_buffer) {
+        value = native_plus.uniform();
+      }
+      doNotOptimizeAway(fill_uniform_buffer.data());
+    });
+
+  prng::Xoshiro128Scalar scalar128(seed);
+  prng::Xoshiro128Native native128(seed);
+  prng::Xoshiro128SIMD dispatch128(seed);
+  std::vector<std::uint32_t> fill_buffer32(fill_size);
+  std::vector<float> fill_uniform_buffer32(fill_size);
+  make_bench("32-bit lanes", "sample", static_cast<double>(fill_size))
+    .run("xoshiro256++ fill UINT64 as 2x UINT32", [&] {
+      // the same number of random bytes as one 32-bit fill
+      rng.fill(fill_buffer.data(), fill_buffer32.size() / 2);
+      doNotOptimizeAway(fill_buffer.data());
+    })
+    .run("xoshiro128++ fill UINT32", [&] {
+      native128.fill(fill_buffer32.data(), fill_buffer32.size());
+      doNotOptimizeAway(fill_buffer32.data());
+    })
+    .run("Dispatch xoshiro128++ fill UINT32", [&] {
+      dispatch128.fill(fill_buffer32.data(), fill_buffer32.size());
+      doNotOptimizeAway(fill_buffer32.data());
+    })
+    .run("xoshiro128++ fill_uniform FLOAT", [&] {
+      native128.fill_uniform(fill_uniform_buffer32.data(), fill_uniform_buffer32.size());
+      doNotOptimizeAway(fill_uniform_buffer32.data());
+    })
+    .run("Dispatch xoshiro128++ fill_uniform FLOAT", [&] {
+      dispatch128.fill_uniform(fill_uniform_buffer32.data(), fill_uniform_buffer32.size());
+      doNotOptimizeAway(fill_uniform_buffer32.data());
+    })
+    .run("xoshiro128++ scalar loop UINT32", [&] {
+      for (auto &value : fill_buffer32) {
+        value = scalar128();
+      }
+      doNotOptimizeAway(fill_buffer32.data());
+    })
+    .run("xoshiro128++ loop UINT32", [&] {
+      for (auto &value : fill_buffer32) {
+        value = native128();
+      }
+      doNotOptimizeAway(fill_buffer32.data());
+    })
+    .run("Dispatch xoshiro128++ loop UINT32", [&] {
+      for (auto &value : fill_buffer32) {
+        value = dispatch128();
+      }
+      doNotOptimizeAway(fill_buffer32.data());
+    });
+
+  make_bench("Construction", "generator", 1.0)
+    .run("XoshiroNative construct", [&] {
+      prng::XoshiroNative generator(seed);
+      doNotOptimizeAway(generator());
+    })
+    .run("Dispatch Xoshiro construct", [&] {
+      prng::XoshiroSIMD generator(seed);
+      doNotOptimizeAway(generator());
+    })
+    .run("Dispatch Xoshiro copy", [&] {
+      auto generator = dispatch;
+      doNotOptimizeAway(generator());
+    });
+
+  constexpr auto spawn_count = std::size_t{1} << 16;
+  std::vector<prng::SeedSequence> children(spawn_count, prng::SeedSequence(seed));
+  make_bench("Child generators", "child", static_cast<double>(spawn_count))
+    .run("XoshiroScalar thread_id jump", [&] {
+      for (auto i = std::size_t{0}; i < spawn_count; ++i) {
+        prng::XoshiroScalar generator(seed, i);
+        doNotOptimizeAway(generator.getState());
+      }
+    })
+    .run("SeedSequence spawn", [&] {
+      prng::SeedSequence root(seed);
+      root.spawn(children.data(), children.size());
+      doNotOptimizeAway(children.data());
+    })
+    .run("SeedSequence spawn XoshiroScalar", [&] {
+      prng::SeedSequence root(seed);
+      root.spawn(children.data(), children.size());
+      for (const auto &child : children) {
+        prng::XoshiroScalar generator(child.generate_state<std::uint64_t, 4>());
+        doNotOptimizeAway(generator.getState());
+      }
     });
 
   make_bench("Unit-interval doubles", "sample", static_cast<double>(iterations))
@@ -153,4 +828,33 @@ int main() {
       }
     });
 
+  // threads drawing from one logical stream: lock-free chunk claims against a mutex around a single generator
+  constexpr auto per_thread = std::size_t{1} << 16;
+  prng::SharedChaChaStream<20> shared_stream(chacha_key, chacha_counter, chacha_nonce);
+  ScalarChaCha20 locked_chacha(chacha_key, chacha_counter, chacha_nonce);
+  std::mutex locked_chacha_mutex;
+  const auto max_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (auto thread_count = 1U; thread_count <= max_threads; thread_count *= 2) {
+    const auto title = "ChaCha20 shared stream, " + std::to_string(thread_count) + " threads";
+    make_bench(title.c_str(), "sample", static_cast<double>(thread_count * per_thread))
+      .minEpochIterations(1)
+      .run("ChaCha20 mutex-guarded scalar", [&] {
+        run_threads(thread_count, [&] {
+          std::vector<std::uint64_t> values(per_thread);
+          for (auto &value : values) {
+            const std::lock_guard<std::mutex> lock(locked_chacha_mutex);
+            value = locked_chacha();
+          }
+          doNotOptimizeAway(values.data());
+        });
+      })
+      .run("SharedChaChaStream cursor fill", [&] {
+        run_threads(thread_count, [&] {
+          std::vector<std::uint64_t> values(per_thread);
+          auto cursor = shared_stream.cursor();
+          cursor.fill(values.data(), values.size());
+          doNotOptimizeAway(values.data());
+        });
+      });
+  }
 }
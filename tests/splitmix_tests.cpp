@@ -1,7 +1,10 @@
+#include <cstddef>
 #include <cstdint>
 #include <random>
+#include <vector>
 #include <catch2/catch_all.hpp>
 #include <random/splitmix.hpp>
+#include <random/splitmix_simd.hpp>
 
 #include "splitmix64.c"
 
@@ -15,3 +18,51 @@ TEST_CASE("splitmix", "[splitmix]") {
         REQUIRE(splitmix() == next());
     }
 }
+
+TEST_CASE("splitmix at", "[splitmix]") {
+    const auto seed = std::random_device{}();
+    INFO("SEED: " << seed);
+    prng::SplitMix splitmix(seed);
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        REQUIRE(prng::SplitMix::at(seed, i) == splitmix());
+    }
+    static_assert(prng::SplitMix::at(0, 0) == 0xe220a8397b1dcdaf);
+
+    std::mt19937_64 rng64(seed);
+    std::vector<std::uint64_t> indices(1001), values(indices.size());
+    for (auto &index : indices) {
+        index = rng64();
+    }
+    prng::SplitMixSIMD<>::at(seed, indices.data(), values.data(), indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        REQUIRE(values[i] == prng::SplitMix::at(seed, indices[i]));
+    }
+}
+
+TEST_CASE("splitmix simd", "[splitmix]") {
+    const auto seed = std::random_device{}();
+    INFO("SEED: " << seed);
+    prng::SplitMix reference(seed);
+    prng::SplitMixSIMD<> splitmix(seed);
+    for (int i = 0; i < 100; ++i) {
+        const auto batch = splitmix.next_batch();
+        for (std::size_t lane = 0; lane < prng::SplitMixSIMD<>::SIMD_WIDTH; ++lane) {
+            REQUIRE(batch.get(lane) == reference());
+        }
+        REQUIRE(splitmix() == reference());
+    }
+    for (const auto n : {std::size_t{1}, std::size_t{3}, std::size_t{8}, std::size_t{1001}}) {
+        INFO("n: " << n);
+        std::vector<std::uint64_t> values(n);
+        splitmix.fill(values.data(), n);
+        for (const auto value : values) {
+            REQUIRE(value == reference());
+        }
+        std::vector<double> uniforms(n);
+        splitmix.fill_uniform(uniforms.data(), n);
+        for (const auto value : uniforms) {
+            REQUIRE(value == static_cast<double>(reference() >> 11) * 0x1.0p-53);
+        }
+        REQUIRE(splitmix.getState() == reference.getState());
+    }
+}
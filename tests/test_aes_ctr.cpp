@@ -0,0 +1,164 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/aes_ctr.hpp>
+#include <random/aes_ctr_simd.hpp>
+#include <random/chacha.hpp>
+
+using prng::internal::aes_block;
+using prng::internal::aes_key;
+
+TEST_CASE("KNOWN ANSWER", "[aes]") {
+  // FIPS-197, appendix C.1
+  aes_key key;
+  aes_block plaintext;
+  for (auto i = 0; i < 16; ++i) {
+    key[i] = static_cast<std::uint8_t>(i);
+    plaintext[i] = static_cast<std::uint8_t>(i << 4 | i);
+  }
+  const aes_block expected = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+                              0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+  REQUIRE(prng::internal::aes_encrypt<10>(plaintext, prng::internal::aes_expand_key(key)) == expected);
+
+  // the first output is the first half of the encrypted counter block, little-endian
+  prng::AESCTR10 generator(key, 0x7766554433221100, 0xffeeddccbbaa9988);
+  REQUIRE(generator() == 0x30047b6ad8e0c469);
+  REQUIRE(generator() == 0x5ac5b47080b7cdd8);
+}
+
+TEST_CASE("SCALAR POSITION", "[aes]") {
+  const aes_key key{1, 2, 3};
+  prng::AESCTR5 generator(key, 10, 3);
+  prng::AESCTR5 reference(key, 10, 3);
+  REQUIRE(generator.getCounter() == 10);
+  generator();
+  REQUIRE(generator.getCounter() == 10);
+  generator();
+  REQUIRE(generator.getCounter() == 11);
+  generator.discard(7);
+  for (auto i = 0; i < 9; ++i) {
+    reference();
+  }
+  REQUIRE(generator.getCounter() == reference.getCounter());
+  REQUIRE(generator() == reference());
+  REQUIRE(generator.getNonce() == 3);
+}
+
+template <std::uint8_t R, class Generator>
+void check_against_scalar(Generator &generator, const aes_key &key, const std::uint64_t counter,
+                          const std::uint64_t nonce) {
+  prng::AESCTR<R> reference(key, counter, nonce);
+  for (auto i = 0; i < 1000; ++i) {
+    REQUIRE(generator.getCounter() == reference.getCounter());
+    REQUIRE(generator() == reference());
+  }
+  for (const auto n : {std::size_t{1}, std::size_t{2}, std::size_t{31}, std::size_t{128}, std::size_t{129},
+                       std::size_t{1001}}) {
+    INFO("n: " << n);
+    std::vector<std::uint64_t> values(n);
+    generator.fill(values.data(), n);
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+    std::vector<double> uniforms(n);
+    generator.fill_uniform(uniforms.data(), n);
+    for (const auto value : uniforms) {
+      REQUIRE(value == reference.uniform());
+    }
+  }
+  generator.discard(12345);
+  reference.discard(12345);
+  REQUIRE(generator.getCounter() == reference.getCounter());
+  REQUIRE(generator() == reference());
+  generator.set_counter(counter);
+  reference.set_counter(counter);
+  REQUIRE(generator.uniform() == reference.uniform());
+}
+
+template <std::uint8_t R> void check_dispatch() {
+  const auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937_64 rng64(seed);
+  aes_key key;
+  for (auto &byte : key) {
+    byte = static_cast<std::uint8_t>(rng64());
+  }
+  const auto counter = rng64(), nonce = rng64();
+  prng::AESCTRDispatch<R> generator(key, counter, nonce);
+  check_against_scalar<R>(generator, key, counter, nonce);
+
+  // the counter wraps modulo 2^64 inside a group of blocks
+  constexpr auto last = ~std::uint64_t{0};
+  prng::AESCTRDispatch<R> wrapping(key, last - 3, nonce);
+  check_against_scalar<R>(wrapping, key, last - 3, nonce);
+}
+
+TEST_CASE("DISPATCH", "[aes]") {
+  INFO("accelerated: " << prng::AESCTRDispatch<10>::accelerated());
+  static_assert(std::is_trivially_copyable_v<prng::AESCTRDispatch<10>>);
+  check_dispatch<5>();
+  check_dispatch<10>();
+}
+
+template <class Table>
+void check_table(const Table *table, const prng::internal::AESCTRTable &reference) {
+  prng::internal::AESCTRState state{prng::internal::aes_expand_key({9, 8, 7}), ~std::uint64_t{0} - 20, 42};
+  auto reference_state = state;
+  for (const auto n : {std::size_t{1}, std::size_t{7}, std::size_t{16}, std::size_t{33}}) {
+    std::vector<std::uint64_t> values(2 * n), expected(2 * n);
+    table->blocks(&state, values.data(), n);
+    reference.blocks(&reference_state, expected.data(), n);
+    REQUIRE(values == expected);
+    REQUIRE(state.counter == reference_state.counter);
+  }
+}
+
+template <class Arch> void check_target(const bool available) {
+  if (!available) {
+    WARN("architecture not supported by this CPU");
+    return;
+  }
+  const auto &software = prng::internal::AESCTRKernels<10, prng::internal::aes_software>::table;
+  check_table(prng::internal::AESCTRTableCreator<10>{}(Arch{}), software);
+}
+
+TEST_CASE("DISPATCH TARGETS", "[aes]") {
+  const auto available = xsimd::available_architectures();
+  const auto aes = prng::internal::cpu_has_aes();
+  const auto vaes = aes && prng::internal::cpu_has_vaes();
+  SECTION("sse2") { check_target<xsimd::sse2>(aes && available.sse2); }
+  SECTION("sse4_2") { check_target<xsimd::sse4_2>(aes && available.sse4_2); }
+  SECTION("fma3<avx2>") { check_target<xsimd::fma3<xsimd::avx2>>(vaes && available.fma3_avx2); }
+  SECTION("avx512f") { check_target<xsimd::avx512f>(vaes && available.avx512f); }
+}
+
+TEST_CASE("CRYPTO FALLBACK", "[aes]") {
+  const std::array<std::uint32_t, 8> key = {0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+                                            0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c};
+  prng::CryptoDispatch generator(key, 5, 6);
+  std::vector<std::uint64_t> values(300);
+  generator.fill(values.data(), values.size());
+  if (prng::internal::cpu_has_aes()) {
+    REQUIRE(generator.cipher() == prng::CryptoCipher::aes128);
+    aes_key aes_key;
+    for (auto i = 0; i < 16; ++i) {
+      aes_key[i] = static_cast<std::uint8_t>(i);
+    }
+    prng::AESCTR10 reference(aes_key, 5, 6);
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+  } else {
+    REQUIRE(generator.cipher() == prng::CryptoCipher::chacha20);
+    prng::ChaCha<20> reference(key, 5, 6);
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+  }
+}
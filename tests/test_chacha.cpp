@@ -1,10 +1,12 @@
 #include <random>
 #include <cstring>
+#include <vector>
 
 #include <catch2/catch_all.hpp>
 #include <monocypher.h>
 
 #include <random/chacha.hpp>
+#include <random/chacha_simd.hpp>
 
 static constexpr auto tests = 1 << 15;
 
@@ -57,3 +59,95 @@ TEST_CASE("ChaChaScalar", "[chacha]") {
         REQUIRE(std::memcmp(referenceOutput, chachaOutput.data(), 64) == 0);
     }
 }
+
+namespace {
+
+using ChaCha20Dispatch = prng::ChaChaDispatch<20>;
+
+/**
+ * Returns `blocks` keystream blocks of Monocypher's ChaCha20 (DJB variant), starting at the counter of `state`.
+ */
+std::vector<uint8_t> reference_keystream(const ChaCha20Dispatch::matrix_type &state, const std::size_t blocks) {
+    uint8_t key[32];
+    std::memcpy(key, state.data() + 4, sizeof(key));
+    uint8_t nonce[8];
+    std::memcpy(nonce, state.data() + 14, sizeof(nonce));
+    const uint64_t ctr = (static_cast<uint64_t>(state[13]) << 32) | static_cast<uint64_t>(state[12]);
+    std::vector<uint8_t> zeros(blocks * 64);
+    std::vector<uint8_t> keystream(blocks * 64);
+    crypto_chacha20_djb(keystream.data(), zeros.data(), keystream.size(), key, nonce, ctr);
+    return keystream;
+}
+
+/**
+ * Checks the entry points of one dispatch target against Monocypher, including a counter that wraps its low word.
+ */
+template <class Arch> void check_dispatch_target(const ChaCha20Dispatch::matrix_type &state, const bool available) {
+    if (!available) {
+        WARN("architecture not supported by this CPU");
+        return;
+    }
+    const auto *table = prng::internal::ChaChaSIMDTableCreator<20>{}(Arch{});
+    for (const uint32_t low_counter : {state[12], 0xFFFFFFFFu - 3}) {
+        auto matrix = state;
+        matrix[12] = low_counter;
+        const auto expected = reference_keystream(matrix, 67);
+        // an odd block count exercises the partial last batch
+        std::vector<uint64_t> out(67 * 8);
+        table->blocks(matrix.data(), out.data(), 3);
+        table->blocks(matrix.data(), out.data() + 3 * 8, 64);
+        REQUIRE(std::memcmp(out.data(), expected.data(), expected.size()) == 0);
+        const auto advanced = ((static_cast<uint64_t>(state[13]) << 32) | low_counter) + 67;
+        REQUIRE(matrix[12] == static_cast<uint32_t>(advanced));
+        REQUIRE(matrix[13] == static_cast<uint32_t>(advanced >> 32));
+    }
+}
+
+} // namespace
+
+TEST_CASE("ChaChaDispatch", "[chacha]") {
+    auto seed = std::random_device{}();
+    INFO("SEED: " << seed);
+    std::mt19937 rng32(seed);
+    std::mt19937_64 rng64(seed);
+    ChaCha20Dispatch::input_word counter = rng64(), nonce = rng64();
+    std::array<ChaCha20Dispatch::matrix_word, 8> key;
+    for (int i = 0; i < 8; i++) {
+        key[i] = rng32();
+    }
+
+    ChaCha20Dispatch rngChaCha(key, counter, nonce);
+    const auto state = rngChaCha.getState();
+    const auto expected = reference_keystream(state, 1 << 10);
+    std::vector<uint64_t> output(expected.size() / 8);
+    // mix single draws, whole blocks and bulk fills to cover the cache bookkeeping
+    std::size_t i = 0;
+    for (; i < 13; ++i) {
+        output[i] = rngChaCha();
+    }
+    rngChaCha.fill(output.data() + i, 1000);
+    i += 1000;
+    REQUIRE(rngChaCha.getState()[12] == static_cast<uint32_t>(counter + i / 8));
+    output[i++] = rngChaCha();
+    const auto block = rngChaCha.block();
+    std::memcpy(output.data() + i - i % 8, block.data(), sizeof(block));
+    i += 8 - i % 8;
+    rngChaCha.fill(output.data() + i, output.size() - i);
+    REQUIRE(std::memcmp(output.data(), expected.data(), expected.size()) == 0);
+
+    ChaCha20Dispatch uniformChaCha(key, counter, nonce);
+    ChaCha20Dispatch uniformReference(key, counter, nonce);
+    std::vector<double> uniforms(1000);
+    uniformChaCha();
+    uniformReference();
+    uniformChaCha.fill_uniform(uniforms.data(), uniforms.size());
+    for (const auto value : uniforms) {
+        REQUIRE(value == uniformReference.uniform());
+    }
+
+    const auto available = xsimd::available_architectures();
+    SECTION("sse2") { check_dispatch_target<xsimd::sse2>(state, available.sse2); }
+    SECTION("sse4_2") { check_dispatch_target<xsimd::sse4_2>(state, available.sse4_2); }
+    SECTION("fma3<avx2>") { check_dispatch_target<xsimd::fma3<xsimd::avx2>>(state, available.fma3_avx2); }
+    SECTION("avx512f") { check_dispatch_target<xsimd::avx512f>(state, available.avx512f); }
+}
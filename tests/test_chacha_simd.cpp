@@ -1,8 +1,18 @@
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_all.hpp>
 
 #include <random/chacha.hpp>
+#include <random/chacha_bank.hpp>
+#include <random/chacha_row.hpp>
+#include <random/chacha_shared.hpp>
 #include <random/chacha_simd.hpp>
 
 using ChaCha20Reference = prng::ChaCha<20>;
@@ -55,3 +65,555 @@ TEST_CASE("COUNTER OVERFLOW", "[chacha]") {
     }
   }
 }
+
+TEST_CASE("FILL UNIFORM", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  ChaCha20SIMD::input_word counter = rng64(), nonce = rng64();
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+
+  ChaCha20Reference chaCha20Reference(key, counter, nonce);
+  ChaCha20SIMD chaCha20SIMD(key, counter, nonce);
+  std::vector<double> buffer(1 << 10);
+  for (const auto size : {0UL, 1UL, 7UL, 8UL, 9UL, 100UL, buffer.size()}) {
+    INFO("size: " << size);
+    chaCha20SIMD.fill_uniform(buffer.data(), size);
+    for (auto i = 0UL; i < size; ++i) {
+      REQUIRE(buffer[i] == chaCha20Reference.uniform());
+    }
+  }
+}
+
+TEST_CASE("NEXT BATCH", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  ChaCha20SIMD::input_word counter = rng64(), nonce = rng64();
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+
+  ChaCha20Reference chaCha20Reference(key, counter, nonce);
+  ChaCha20SIMD chaCha20SIMD(key, counter, nonce);
+  constexpr auto width = ChaCha20SIMD::batch_type::size;
+  for (auto i = 0; i < 100; ++i) {
+    const auto batch = chaCha20SIMD.next_batch();
+    for (auto lane = 0UL; lane < width; ++lane) {
+      REQUIRE(batch.get(lane) == chaCha20Reference());
+    }
+    // an odd number of scalar draws makes the next batch straddle blocks every so often
+    REQUIRE(chaCha20SIMD() == chaCha20Reference());
+    const auto uniform = chaCha20SIMD.next_uniform_batch();
+    for (auto lane = 0UL; lane < width; ++lane) {
+      REQUIRE(uniform.get(lane) == chaCha20Reference.uniform());
+    }
+  }
+}
+
+namespace {
+
+/**
+ * Checks discard(), seek(), set_counter() and set_nonce() of one ChaCha generator against sequential generation.
+ */
+template <class Generator>
+void check_seek(const std::array<ChaCha20SIMD::matrix_word, 8> &key, const ChaCha20SIMD::input_word counter,
+                const ChaCha20SIMD::input_word nonce, const std::vector<std::uint64_t> &expected,
+                std::mt19937_64 &rng64) {
+  std::uniform_int_distribution<std::size_t> position(0, expected.size() / 2);
+  for (auto i = 0; i < 100; ++i) {
+    // a few draws first, so the generator seeks from a partially consumed block and a partially consumed cache
+    const auto drawn = position(rng64) % 20;
+    const auto skipped = position(rng64);
+    Generator rng(key, counter, nonce);
+    for (auto j = 0UL; j < drawn; ++j) {
+      REQUIRE(rng() == expected[j]);
+    }
+    rng.discard(skipped);
+    for (auto j = drawn + skipped; j < drawn + skipped + 20; ++j) {
+      INFO("drawn: " << drawn << " skipped: " << skipped << " j: " << j);
+      REQUIRE(rng() == expected[j]);
+    }
+    const auto target = position(rng64);
+    rng.seek(counter + target / 8, static_cast<std::uint8_t>(target % 8));
+    for (auto j = target; j < target + 20; ++j) {
+      REQUIRE(rng() == expected[j]);
+    }
+  }
+  // words past the end of a block carry into the following blocks
+  for (const auto word : {7, 8, 9, 17, 255}) {
+    INFO("word: " << word);
+    Generator rng(key, counter, nonce);
+    rng();
+    rng.seek(counter + 1, static_cast<std::uint8_t>(word));
+    REQUIRE(rng() == expected[8 + word]);
+  }
+  Generator rng(key, counter, nonce);
+  rng();
+  rng.set_counter(counter + 3);
+  REQUIRE(rng() == expected[3 * 8]);
+  rng.set_nonce(nonce + 1);
+  ChaCha20Reference renonced(key, counter + 3, nonce + 1);
+  REQUIRE(rng.getState() == renonced.getState());
+  REQUIRE(rng() == renonced());
+}
+
+} // namespace
+
+TEST_CASE("SEEK", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  const ChaCha20SIMD::input_word nonce = rng64();
+  // the second counter makes the low counter word wrap inside the checked range
+  for (const ChaCha20SIMD::input_word counter : {rng64(), (static_cast<std::uint64_t>(rng32()) << 32) | 0xFFFFFF00u}) {
+    INFO("counter: " << counter);
+    ChaCha20Reference reference(key, counter, nonce);
+    std::vector<std::uint64_t> expected(1 << 12);
+    for (auto &value : expected) {
+      value = reference();
+    }
+    check_seek<ChaCha20Reference>(key, counter, nonce, expected, rng64);
+    check_seek<ChaCha20SIMD>(key, counter, nonce, expected, rng64);
+    check_seek<prng::ChaChaRow<20>>(key, counter, nonce, expected, rng64);
+    check_seek<prng::ChaChaDispatch<20>>(key, counter, nonce, expected, rng64);
+  }
+}
+
+TEST_CASE("FILL BYTES", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  ChaCha20SIMD::input_word counter = rng64(), nonce = rng64();
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+
+  ChaCha20Reference reference(key, counter, nonce);
+  std::vector<std::uint64_t> expected(1 << 12);
+  for (auto &value : expected) {
+    value = reference();
+  }
+  std::vector<std::byte> keystream(expected.size() * 8);
+  std::memcpy(keystream.data(), expected.data(), keystream.size());
+
+  ChaCha20SIMD filled(key, counter, nonce);
+  ChaCha20SIMD xored(key, counter, nonce);
+  ChaCha20SIMD words(key, counter, nonce);
+  std::vector<std::byte> buffer(1 << 13);
+  std::vector<std::byte> data(buffer.size());
+  std::vector<std::uint64_t> values(buffer.size() / 8);
+  auto filled_position = std::size_t{0};
+  auto xored_position = std::size_t{0};
+  auto word_position = std::size_t{0};
+  // odd sizes and misaligned starts cover the partial words and blocks at both ends
+  for (const auto size : {0UL, 1UL, 7UL, 8UL, 9UL, 63UL, 64UL, 65UL, 1000UL, 4096UL, 8000UL}) {
+    for (const auto offset : {0UL, 3UL}) {
+      INFO("size: " << size << " offset: " << offset);
+      const auto filled_size = size > offset ? size - offset : size;
+      filled.fill_bytes(buffer.data() + offset, filled_size);
+      REQUIRE(std::memcmp(buffer.data() + offset, keystream.data() + filled_position, filled_size) == 0);
+      filled_position += filled_size;
+
+      for (auto i = 0UL; i < size; ++i) {
+        data[i] = static_cast<std::byte>(rng32());
+      }
+      auto original = data;
+      xored.xor_keystream(data.data(), size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(data[i] == (original[i] ^ keystream[xored_position + i]));
+      }
+      xored_position += size;
+
+      const auto word_count = (size + 7) / 8;
+      words.fill(values.data(), word_count);
+      for (auto i = 0UL; i < word_count; ++i) {
+        REQUIRE(values[i] == expected[word_position + i]);
+      }
+      word_position += word_count;
+    }
+  }
+  // word-level calls skip the unused bytes of a partial word
+  REQUIRE(filled() == expected[(filled_position + 7) / 8]);
+}
+
+TEST_CASE("CHUNKED KEYSTREAM", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  ChaCha20SIMD::input_word counter = rng64(), nonce = rng64();
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+
+  std::vector<std::byte> message(1 << 14);
+  for (auto &byte : message) {
+    byte = static_cast<std::byte>(rng32());
+  }
+  auto whole = message;
+  ChaCha20SIMD once(key, counter, nonce);
+  once.xor_keystream(whole.data(), whole.size());
+  // chunks of random sizes, from empty to several batches, must encrypt exactly like one call
+  for (const auto max_chunk : {9UL, 70UL, 3000UL}) {
+    INFO("max chunk: " << max_chunk);
+    auto chunked = message;
+    std::vector<std::byte> bytes(message.size());
+    ChaCha20SIMD xored(key, counter, nonce);
+    ChaCha20SIMD filled(key, counter, nonce);
+    for (auto position = std::size_t{0}; position < message.size();) {
+      auto size = std::size_t{rng32() % (max_chunk + 1)};
+      size = size < message.size() - position ? size : message.size() - position;
+      xored.xor_keystream(chunked.data() + position, size);
+      filled.fill_bytes(bytes.data() + position, size);
+      position += size;
+    }
+    REQUIRE(chunked == whole);
+    for (auto i = std::size_t{0}; i < message.size(); ++i) {
+      REQUIRE((bytes[i] ^ message[i]) == whole[i]);
+    }
+  }
+  // repositioning drops the unused bytes of a partial word
+  ChaCha20SIMD reset(key, counter, nonce);
+  std::array<std::byte, 8> first{};
+  std::array<std::byte, 8> again{};
+  reset.fill_bytes(first.data(), 3);
+  reset.set_counter(counter);
+  reset.fill_bytes(again.data(), 8);
+  REQUIRE(std::memcmp(first.data(), again.data(), 3) == 0);
+  // word-level calls continue after the partial word, whose unused bytes come out in the next byte-level call
+  ChaCha20Reference reference(key, counter, nonce);
+  std::array<std::uint64_t, 3> words{};
+  for (auto &word : words) {
+    word = reference();
+  }
+  ChaCha20SIMD mixed(key, counter, nonce);
+  std::array<std::byte, 11> bytes{};
+  mixed.fill_bytes(bytes.data(), 3);
+  REQUIRE(mixed() == words[1]);
+  mixed.fill_bytes(bytes.data() + 3, 8);
+  REQUIRE(std::memcmp(bytes.data(), &words[0], 8) == 0);
+  REQUIRE(std::memcmp(bytes.data() + 8, &words[2], 3) == 0);
+  REQUIRE(mixed() == reference());
+}
+
+namespace {
+
+/**
+ * Checks the row-vectorized generator block by block against the scalar one, including a low counter word wrap.
+ */
+template <std::uint8_t R>
+void check_row(const std::array<ChaCha20SIMD::matrix_word, 8> &key, const ChaCha20SIMD::input_word nonce,
+               std::mt19937_64 &rng64) {
+  for (const ChaCha20SIMD::input_word counter : {rng64(), (rng64() & ~std::uint64_t{0xFFFFFFFF}) | 0xFFFFFFF0u}) {
+    INFO("rounds: " << int{R} << " counter: " << counter);
+    prng::ChaCha<R> reference(key, counter, nonce);
+    prng::ChaChaRow<R> row(key, counter, nonce);
+    for (auto i = 0; i < 64; ++i) {
+      REQUIRE(row.getState() == reference.getState());
+      REQUIRE(row.block() == reference.block());
+    }
+    for (auto i = 0; i < 1000; ++i) {
+      REQUIRE(row() == reference());
+      REQUIRE(row.getState() == reference.getState());
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("ROW", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  const ChaCha20SIMD::input_word nonce = rng64();
+  check_row<8>(key, nonce, rng64);
+  check_row<12>(key, nonce, rng64);
+  check_row<20>(key, nonce, rng64);
+}
+
+namespace {
+
+/**
+ * Checks a ChaChaSIMD of the given round count and batch depth against the scalar generator, through block(),
+ * operator() and fill(), including a low counter word wrap.
+ */
+template <std::uint8_t R, std::uint8_t Depth>
+void check_depth(const std::array<ChaCha20SIMD::matrix_word, 8> &key, const ChaCha20SIMD::input_word nonce,
+                 std::mt19937_64 &rng64) {
+  for (const ChaCha20SIMD::input_word counter : {rng64(), (rng64() & ~std::uint64_t{0xFFFFFFFF}) | 0xFFFFFFC0u}) {
+    INFO("rounds: " << int{R} << " depth: " << int{Depth} << " counter: " << counter);
+    prng::ChaCha<R> reference(key, counter, nonce);
+    prng::ChaChaSIMD<R, xsimd::best_arch, Depth> rng(key, counter, nonce);
+    for (auto i = 0; i < 200; ++i) {
+      REQUIRE(rng.getState() == reference.getState());
+      REQUIRE(rng.block() == reference.block());
+    }
+    for (auto i = 0; i < 1000; ++i) {
+      REQUIRE(rng() == reference());
+    }
+    std::vector<std::uint64_t> values(3000);
+    rng.fill(values.data(), values.size());
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+    REQUIRE(rng.getState() == reference.getState());
+  }
+}
+
+template <std::uint8_t R>
+void check_depths(const std::array<ChaCha20SIMD::matrix_word, 8> &key, const ChaCha20SIMD::input_word nonce,
+                  std::mt19937_64 &rng64) {
+  check_depth<R, 1>(key, nonce, rng64);
+  check_depth<R, 2>(key, nonce, rng64);
+  check_depth<R, 3>(key, nonce, rng64);
+  check_depth<R, 4>(key, nonce, rng64);
+}
+
+} // namespace
+
+TEST_CASE("DEPTH", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  const ChaCha20SIMD::input_word nonce = rng64();
+  check_depths<8>(key, nonce, rng64);
+  check_depths<12>(key, nonce, rng64);
+  check_depths<20>(key, nonce, rng64);
+}
+
+TEST_CASE("BANK", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  // not a multiple of any SIMD width, so the last group is padded
+  std::vector<ChaCha20SIMD::input_word> nonces(37);
+  for (auto &nonce : nonces) {
+    nonce = rng64();
+  }
+  const ChaCha20SIMD::input_word counter = rng64();
+  prng::ChaChaBank<20> bank(key, nonces, counter);
+  REQUIRE(bank.size() == nonces.size());
+  std::vector<prng::ChaCha<20>> references;
+  for (const auto nonce : nonces) {
+    references.emplace_back(key, counter, nonce);
+  }
+  // a few streams are moved so that their low counter word wraps, one of them past the high word as well
+  bank.set_counter(3, 0x00000001FFFFFFFEULL);
+  references[3] = prng::ChaCha<20>(key, 0x00000001FFFFFFFEULL, nonces[3]);
+  bank.set_counter(36, ~ChaCha20SIMD::input_word{0});
+  references[36] = prng::ChaCha<20>(key, ~ChaCha20SIMD::input_word{0}, nonces[36]);
+  bank.set_nonce(5, nonces[5] + 1);
+  references[5] = prng::ChaCha<20>(key, counter, nonces[5] + 1);
+
+  std::vector<prng::ChaChaBank<20>::matrix_type> blocks(bank.size());
+  for (auto i = 0; i < 64; ++i) {
+    for (auto stream = std::size_t{0}; stream < bank.size(); ++stream) {
+      INFO("stream: " << stream << " block: " << i);
+      REQUIRE(bank.stream(stream).getState() == references[stream].getState());
+      REQUIRE(bank.counter(stream) == (std::uint64_t{references[stream].getState()[13]} << 32 |
+                                       references[stream].getState()[12]));
+    }
+    bank.next_blocks(blocks.data());
+    for (auto stream = std::size_t{0}; stream < bank.size(); ++stream) {
+      INFO("stream: " << stream << " block: " << i);
+      REQUIRE(blocks[stream] == references[stream].block());
+    }
+  }
+  REQUIRE(bank.nonce(5) == nonces[5] + 1);
+  REQUIRE(bank.counter(36) == 63);
+
+  prng::ChaChaBank<8> numbered(key, std::size_t{3}, counter);
+  std::vector<prng::ChaChaBank<8>::matrix_type> numbered_blocks(numbered.size());
+  numbered.next_blocks(numbered_blocks.data());
+  for (auto stream = std::size_t{0}; stream < numbered.size(); ++stream) {
+    REQUIRE(numbered.nonce(stream) == stream);
+    REQUIRE(numbered_blocks[stream] == prng::ChaCha<8>(key, counter, stream).block());
+  }
+}
+
+TEST_CASE("SHARED STREAM", "[chacha]") {
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  const ChaCha20SIMD::input_word counter = rng64(), nonce = rng64();
+  // a small chunk that is not a multiple of the cache, so the cursors claim often and the chunks interleave
+  prng::SharedChaChaStream<20> stream(key, counter, nonce, 5);
+  static_assert(!std::is_copy_constructible_v<prng::SharedChaChaStream<20>::Cursor>);
+  static_assert(!std::is_copy_assignable_v<prng::SharedChaChaStream<20>::Cursor>);
+  static_assert(std::is_move_constructible_v<prng::SharedChaChaStream<20>::Cursor>);
+  constexpr auto thread_count = 4;
+  constexpr auto draws = std::size_t{5000};
+  std::vector<std::vector<std::uint64_t>> values(thread_count);
+  std::vector<std::vector<prng::SharedChaChaStream<20>::Range>> ranges(thread_count);
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&, t] {
+      auto cursor = stream.cursor();
+      values[t].resize(draws);
+      // half one by one, half in bulk, ending in the middle of a block
+      for (auto i = std::size_t{0}; i < draws / 2; ++i) {
+        values[t][i] = cursor();
+      }
+      cursor.fill(values[t].data() + draws / 2, draws - draws / 2 - 3);
+      for (auto i = draws - 3; i < draws; ++i) {
+        values[t][i] = cursor();
+      }
+      ranges[t] = cursor.ranges();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<bool> used(static_cast<std::size_t>(stream.claimed().count));
+  for (auto t = 0; t < thread_count; ++t) {
+    INFO("thread: " << t);
+    auto next = values[t].begin();
+    for (const auto range : ranges[t]) {
+      prng::ChaCha<20> reference(key, range.first, nonce);
+      for (auto block = std::uint64_t{0}; block < range.count; ++block) {
+        const auto index = static_cast<std::size_t>(range.first - counter + block);
+        REQUIRE(index < used.size());
+        REQUIRE(!used[index]);
+        used[index] = true;
+        for (auto word = 0; word < 8 && next != values[t].end(); ++word, ++next) {
+          REQUIRE(*next == reference());
+        }
+      }
+    }
+    REQUIRE(next == values[t].end());
+  }
+}
+
+TEST_CASE("SHARED STREAM MOVE", "[chacha]") {
+  const std::array<ChaCha20SIMD::matrix_word, 8> key{1, 2, 3, 4, 5, 6, 7, 8};
+  const auto counter = ChaCha20SIMD::input_word{0}, nonce = ChaCha20SIMD::input_word{0};
+  prng::SharedChaChaStream<20> stream(key, counter, nonce, 5);
+  prng::ChaCha<20> reference(key, counter, nonce);
+  auto source = stream.cursor();
+  REQUIRE(source() == reference());
+  // the moved-to cursor continues the claimed chunk, the moved-from one has to claim the next
+  auto moved = std::move(source);
+  REQUIRE(source.ranges().empty());
+  source();
+  REQUIRE(source.ranges().size() == 1);
+  REQUIRE(source.ranges()[0].first == counter + 5);
+  REQUIRE(moved() == reference());
+  REQUIRE(moved.ranges().size() == 1);
+  REQUIRE(moved.ranges()[0].first == counter);
+  moved = std::move(source);
+  REQUIRE(source.ranges().empty());
+  source();
+  REQUIRE(source.ranges()[0].first == counter + 10);
+  REQUIRE(moved.ranges()[0].first == counter + 5);
+}
+
+TEST_CASE("LANE INTERLEAVED", "[chacha]") {
+  using Interleaved = prng::ChaChaSIMD<20, xsimd::best_arch, 2, prng::ChaChaOrder::lane_interleaved>;
+  constexpr auto width = Interleaved::simd_type::size;
+  auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937 rng32(seed);
+  std::mt19937_64 rng64(seed);
+  std::array<ChaCha20SIMD::matrix_word, 8> key;
+  for (int i = 0; i < 8; i++) {
+    key[i] = rng32();
+  }
+  const ChaCha20SIMD::input_word nonce = rng64();
+  for (const ChaCha20SIMD::input_word counter : {rng64(), (rng64() & ~std::uint64_t{0xFFFFFFFF}) | 0xFFFFFFC0u}) {
+    INFO("counter: " << counter);
+    // word i of blocks c..c+W-1, then word i+1, and so on, two words per output
+    ChaCha20Reference reference(key, counter, nonce);
+    std::vector<std::uint64_t> expected;
+    for (auto batch = 0; batch < 40; ++batch) {
+      std::vector<ChaCha20Reference::matrix_type> blocks(width);
+      for (auto &block : blocks) {
+        block = reference.block();
+      }
+      std::vector<std::uint32_t> words;
+      for (auto word = 0; word < 16; ++word) {
+        for (const auto &block : blocks) {
+          words.push_back(block[word]);
+        }
+      }
+      for (auto i = std::size_t{0}; i < words.size(); i += 2) {
+        expected.push_back(std::uint64_t{words[i]} | std::uint64_t{words[i + 1]} << 32);
+      }
+    }
+
+    Interleaved rng(key, counter, nonce);
+    for (auto i = std::size_t{0}; i < expected.size() / 2; ++i) {
+      REQUIRE(rng() == expected[i]);
+    }
+    Interleaved filled(key, counter, nonce);
+    std::vector<std::uint64_t> values(expected.size());
+    filled.fill(values.data(), 3);
+    filled.fill(values.data() + 3, values.size() - 3);
+    REQUIRE(values == expected);
+    Interleaved xored(key, counter, nonce);
+    std::vector<std::uint64_t> zeros(expected.size());
+    xored.xor_keystream(reinterpret_cast<std::byte *>(zeros.data()), zeros.size() * sizeof(std::uint64_t));
+    REQUIRE(zeros == expected);
+    REQUIRE(filled.getState() == reference.getState());
+
+    // discard(n) is n calls to operator(), from any position within a batch
+    for (const auto start : {0UL, 3UL, 17UL}) {
+      for (const auto n : {0UL, 1UL, 7UL, 8UL, 9UL, 8 * width - 1, 8 * width + 5, 100UL, 301UL}) {
+        INFO("start: " << start << " n: " << n);
+        Interleaved skipped(key, counter, nonce);
+        for (auto i = 0UL; i < start; ++i) {
+          skipped();
+        }
+        skipped.discard(n);
+        for (auto i = 0UL; i < 2 * 8 * width; ++i) {
+          REQUIRE(skipped() == expected[start + n + i]);
+        }
+      }
+    }
+    // seek() and set_nonce() address 64-byte chunks of the interleaved output
+    Interleaved sought(key, counter, nonce);
+    sought.seek(counter + 5, 3);
+    REQUIRE(sought() == expected[5 * 8 + 3]);
+    sought.seek(counter + 4, 11);
+    REQUIRE(sought() == expected[5 * 8 + 3]);
+    sought.discard(8);
+    REQUIRE(sought.getState()[12] == static_cast<std::uint32_t>(counter + 6));
+    sought.set_nonce(nonce);
+    REQUIRE(sought() == expected[6 * 8]);
+  }
+}
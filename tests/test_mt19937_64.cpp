@@ -0,0 +1,92 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/mt19937_64_simd.hpp>
+
+template <class Generator> void check_against_std(const std::uint64_t seed) {
+  std::mt19937_64 reference(seed);
+  Generator generator(seed);
+  for (auto i = 0; i < 1000; ++i) {
+    REQUIRE(generator() == reference());
+  }
+  for (const auto n : {std::size_t{1}, std::size_t{7}, std::size_t{311}, std::size_t{312}, std::size_t{313},
+                       std::size_t{624}, std::size_t{2000}}) {
+    INFO("n: " << n);
+    std::vector<std::uint64_t> values(n);
+    generator.fill(values.data(), n);
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+    std::vector<double> uniforms(n);
+    generator.fill_uniform(uniforms.data(), n);
+    for (const auto value : uniforms) {
+      REQUIRE(value == static_cast<double>(reference() >> 11) * 0x1.0p-53);
+    }
+  }
+  for (const auto n : {0ULL, 5ULL, 312ULL, 1000ULL, 12345ULL}) {
+    INFO("discard: " << n);
+    generator.discard(n);
+    reference.discard(n);
+    REQUIRE(generator() == reference());
+  }
+  generator.seed(seed + 1);
+  reference.seed(seed + 1);
+  REQUIRE(generator() == reference());
+}
+
+TEST_CASE("DEFAULT SEED", "[mt19937_64]") {
+  // the 10000th output of a default-constructed std::mt19937_64, required by the standard
+  prng::MT19937_64Dispatch generator;
+  generator.discard(9999);
+  REQUIRE(generator() == 9981545732273789042ULL);
+}
+
+TEST_CASE("STD COMPATIBILITY", "[mt19937_64]") {
+  const auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  static_assert(std::is_trivially_copyable_v<prng::MT19937_64Dispatch>);
+  check_against_std<prng::MT19937_64SIMD<>>(seed);
+  check_against_std<prng::MT19937_64Dispatch>(seed);
+  check_against_std<prng::MT19937_64Dispatch>(~std::uint64_t{0});
+}
+
+template <class Arch> void check_target(const bool available) {
+  if (!available) {
+    WARN("architecture not supported by this CPU");
+    return;
+  }
+  // the state of std::mt19937_64(42) before its first regeneration
+  alignas(64) std::array<std::uint64_t, prng::internal::MT_N> state{};
+  state[0] = 42;
+  for (auto i = std::size_t{1}; i < state.size(); ++i) {
+    state[i] = prng::internal::MT_INIT_MULTIPLIER * (state[i - 1] ^ (state[i - 1] >> 62)) + i;
+  }
+  std::mt19937_64 reference(42);
+  const auto *table = prng::internal::MT19937_64SIMDTableCreator{}(Arch{});
+  std::vector<std::uint64_t> values(prng::internal::MT_N);
+  std::vector<double> uniforms(prng::internal::MT_N);
+  for (auto block = 0; block < 3; ++block) {
+    table->generate(state.data(), values.data());
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+    table->generate_uniform(state.data(), uniforms.data());
+    for (const auto value : uniforms) {
+      REQUIRE(value == static_cast<double>(reference() >> 11) * 0x1.0p-53);
+    }
+  }
+}
+
+TEST_CASE("DISPATCH TARGETS", "[mt19937_64]") {
+  const auto available = xsimd::available_architectures();
+  SECTION("sse2") { check_target<xsimd::sse2>(available.sse2); }
+  SECTION("sse4_2") { check_target<xsimd::sse4_2>(available.sse4_2); }
+  SECTION("fma3<avx2>") { check_target<xsimd::fma3<xsimd::avx2>>(available.fma3_avx2); }
+  SECTION("avx512f") { check_target<xsimd::avx512f>(available.avx512f); }
+}
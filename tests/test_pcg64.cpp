@@ -0,0 +1,153 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/pcg64.hpp>
+#include <random/pcg64_simd.hpp>
+
+using state_type = prng::PCG64DXSM::state_type;
+
+TEST_CASE("KNOWN ANSWERS", "[pcg64]") {
+  // seeded the way numpy.random.PCG64DXSM seeds from the words 0x0123456789abcdef, 0xfedcba9876543210,
+  // 0x1111111122222222 and 0x3333333344444444 of its SeedSequence
+  const auto generator = prng::PCG64DXSM::seeded({0xfedcba9876543210, 0x0123456789abcdef},
+                                                 {0x3333333344444444, 0x1111111122222222});
+  REQUIRE(generator.getState() == state_type{0xaff2ae970e41d9c6, 0x0aec8437bbc938d3});
+  REQUIRE(generator.getIncrement() == state_type{0x6666666688888889, 0x2222222244444444});
+  auto copy = generator;
+  REQUIRE(copy() == 0x40700cf146fea9ef);
+  REQUIRE(copy() == 0x7f7fc440337b5bc9);
+  REQUIRE(copy() == 0x08c7dc4fc72f93f1);
+}
+
+TEST_CASE("NEXT UINT32", "[pcg64]") {
+  prng::PCG64DXSM generator({1, 2}, {3, 4});
+  prng::PCG64DXSM reference({1, 2}, {3, 4});
+  const auto first = reference(), second = reference();
+  REQUIRE(generator.next_uint32() == static_cast<std::uint32_t>(first));
+  REQUIRE(generator.next_uint32() == static_cast<std::uint32_t>(first >> 32));
+  REQUIRE(generator() == second);
+}
+
+TEST_CASE("ADVANCE", "[pcg64]") {
+  const auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937_64 rng64(seed);
+  const state_type state{rng64(), rng64()}, inc{rng64() | 1, rng64()};
+
+  // advancing by n is the same as drawing n outputs
+  prng::PCG64DXSM advanced(state, inc), reference(state, inc);
+  advanced.advance(std::uint64_t{1000});
+  for (auto i = 0; i < 1000; ++i) {
+    reference();
+  }
+  REQUIRE(advanced.getState() == reference.getState());
+  REQUIRE(advanced() == reference());
+
+  // the step is taken modulo the 2^128 period
+  prng::PCG64DXSM wrapped(state, inc);
+  wrapped.advance(state_type{12345, 0x8000000000000000});
+  wrapped.advance(state_type{0 - std::uint64_t{12345}, 0x7FFFFFFFFFFFFFFF});
+  REQUIRE(wrapped.getState() == state);
+
+  // jump() is advance() by the step of NumPy's jumped() and drops a pending 32-bit half
+  prng::PCG64DXSM jumped(state, inc), stepped(state, inc);
+  jumped.next_uint32();
+  jumped.jump();
+  stepped();
+  stepped.advance(prng::internal::PCG_JUMP);
+  REQUIRE(jumped.getState() == stepped.getState());
+  REQUIRE(jumped.next_uint32() == static_cast<std::uint32_t>(stepped()));
+}
+
+template <class Generator> void check_against_scalar(const state_type &initstate, const state_type &initseq) {
+  constexpr auto streams = Generator::STREAMS;
+  std::vector<prng::PCG64DXSM> references;
+  for (auto lane = std::size_t{0}; lane < streams; ++lane) {
+    references.push_back(prng::PCG64DXSM::seeded(initstate, prng::internal::pcg_add(initseq, {lane, 0})));
+  }
+  auto initial = references;
+  Generator generator(initstate, initseq);
+  std::size_t position = 0;
+  const auto next = [&]() { return references[position++ % streams](); };
+  for (auto i = 0; i < 1000; ++i) {
+    REQUIRE(generator() == next());
+  }
+  for (const auto n : {std::size_t{1}, std::size_t{7}, std::size_t{8}, std::size_t{255}, std::size_t{256},
+                       std::size_t{257}, std::size_t{1001}}) {
+    INFO("n: " << n);
+    std::vector<std::uint64_t> values(n);
+    generator.fill(values.data(), n);
+    for (const auto value : values) {
+      REQUIRE(value == next());
+    }
+    std::vector<double> uniforms(n);
+    generator.fill_uniform(uniforms.data(), n);
+    for (const auto value : uniforms) {
+      REQUIRE(value == references[position++ % streams].uniform());
+    }
+  }
+  // mid-step, the current step is the one whose outputs are being handed out
+  const auto current = std::uint64_t{position / streams};
+  for (auto lane = std::size_t{0}; lane < streams; ++lane) {
+    INFO("lane: " << lane);
+    auto reference = initial[lane];
+    reference.advance(current);
+    REQUIRE(generator.getState(lane) == reference.getState());
+    REQUIRE(generator.getIncrement(lane) == reference.getIncrement());
+  }
+  generator.advance(std::uint64_t{77});
+  for (auto &reference : initial) {
+    reference.advance(current + 77);
+  }
+  for (auto i = std::size_t{0}; i < 3 * streams; ++i) {
+    REQUIRE(generator() == initial[i % streams]());
+  }
+}
+
+TEST_CASE("SIMD", "[pcg64]") {
+  const auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937_64 rng64(seed);
+  static_assert(std::is_trivially_copyable_v<prng::PCG64DXSMDispatch>);
+  check_against_scalar<prng::PCG64DXSMSIMD<>>({rng64(), rng64()}, {rng64(), rng64()});
+  check_against_scalar<prng::PCG64DXSMDispatch>({rng64(), rng64()}, {rng64(), rng64()});
+  // the stream selectors of the lanes carry into the high word
+  check_against_scalar<prng::PCG64DXSMDispatch>({rng64(), rng64()}, {~std::uint64_t{0} - 3, rng64()});
+}
+
+template <class Arch> void check_target(const bool available) {
+  if (!available) {
+    WARN("architecture not supported by this CPU");
+    return;
+  }
+  prng::internal::PCG64DXSMLanes lanes{};
+  std::vector<prng::PCG64DXSM> references;
+  for (auto lane = std::size_t{0}; lane < prng::internal::PCG64_SIMD_STREAMS; ++lane) {
+    const state_type state{lane * 0x9E3779B97F4A7C15, ~lane}, inc{2 * lane + 1, lane << 60};
+    lanes.state_lo[lane] = state[0];
+    lanes.state_hi[lane] = state[1];
+    lanes.inc_lo[lane] = inc[0];
+    lanes.inc_hi[lane] = inc[1];
+    references.emplace_back(state, inc);
+  }
+  const auto *table = prng::internal::PCG64DXSMSIMDTableCreator{}(Arch{});
+  std::vector<std::uint64_t> values(33 * prng::internal::PCG64_SIMD_STREAMS);
+  table->steps(&lanes, values.data(), 33);
+  for (auto i = std::size_t{0}; i < values.size(); ++i) {
+    REQUIRE(values[i] == references[i % prng::internal::PCG64_SIMD_STREAMS]());
+  }
+}
+
+TEST_CASE("DISPATCH TARGETS", "[pcg64]") {
+  const auto available = xsimd::available_architectures();
+  SECTION("sse2") { check_target<xsimd::sse2>(available.sse2); }
+  SECTION("sse4_2") { check_target<xsimd::sse4_2>(available.sse4_2); }
+  SECTION("fma3<avx2>") { check_target<xsimd::fma3<xsimd::avx2>>(available.fma3_avx2); }
+  SECTION("avx512f") { check_target<xsimd::avx512f>(available.avx512f); }
+}
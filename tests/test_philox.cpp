@@ -0,0 +1,113 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/philox.hpp>
+#include <random/philox_simd.hpp>
+
+using PhiloxSIMD = prng::PhiloxSIMD<xsimd::best_arch>;
+using counter_type = prng::Philox::counter_type;
+using key_type = prng::Philox::key_type;
+
+TEST_CASE("KNOWN ANSWERS", "[philox]") {
+  // philox4x64_10 known-answer vectors from Random123
+  using prng::internal::philox4x64;
+  REQUIRE(philox4x64({0, 0, 0, 0}, {0, 0}) ==
+          counter_type{0x16554d9eca36314c, 0xdb20fe9d672d0fdc, 0xd7e772cee186176b, 0x7e68b68aec7ba23b});
+  constexpr auto ones = ~std::uint64_t{0};
+  REQUIRE(philox4x64({ones, ones, ones, ones}, {ones, ones}) ==
+          counter_type{0x87b092c3013fe90b, 0x438c3c67be8d0224, 0x9cc7d7c69cd777b6, 0xa09caebf594f0ba0});
+  REQUIRE(philox4x64({0x243f6a8885a308d3, 0x13198a2e03707344, 0xa4093822299f31d0, 0x082efa98ec4e6c89},
+                     {0x452821e638d01377, 0xbe5466cf34e90c6c}) ==
+          counter_type{0xa528f45403e61d95, 0x38c72dbd566e9788, 0xa5a1610e72fd18b5, 0x57bd43b5e52b7fe6});
+
+  // like NumPy, the counter is incremented before the first block
+  prng::Philox philox({0, 0}, {ones, ones, ones, ones});
+  REQUIRE(philox() == 0x16554d9eca36314c);
+  REQUIRE(philox.getCounter() == counter_type{0, 0, 0, 0});
+}
+
+TEST_CASE("NEXT UINT32", "[philox]") {
+  prng::Philox philox({1, 2});
+  prng::Philox reference({1, 2});
+  const auto first = reference(), second = reference();
+  REQUIRE(philox.next_uint32() == static_cast<std::uint32_t>(first));
+  REQUIRE(philox.next_uint32() == static_cast<std::uint32_t>(first >> 32));
+  REQUIRE(philox() == second);
+}
+
+template <class Generator> void check_against_scalar(const key_type &key, const counter_type &counter) {
+  prng::Philox reference(key, counter);
+  Generator generator(key, counter);
+  for (auto i = 0; i < 1000; ++i) {
+    REQUIRE(generator.getCounter() == reference.getCounter());
+    REQUIRE(generator() == reference());
+  }
+  for (const auto n : {std::size_t{1}, std::size_t{3}, std::size_t{4}, std::size_t{63}, std::size_t{64},
+                       std::size_t{65}, std::size_t{1001}}) {
+    INFO("n: " << n);
+    std::vector<std::uint64_t> values(n);
+    generator.fill(values.data(), n);
+    for (const auto value : values) {
+      REQUIRE(value == reference());
+    }
+    std::vector<double> uniforms(n);
+    generator.fill_uniform(uniforms.data(), n);
+    for (const auto value : uniforms) {
+      REQUIRE(value == reference.uniform());
+    }
+    REQUIRE(generator.getCounter() == reference.getCounter());
+  }
+  for (auto i = 0; i < 5; ++i) {
+    REQUIRE(generator.next_uint32() == reference.next_uint32());
+  }
+  generator.advance({3, 0, 1, 0});
+  reference.advance({3, 0, 1, 0});
+  REQUIRE(generator.getCounter() == reference.getCounter());
+  REQUIRE(generator.next_uint32() == reference.next_uint32());
+  generator.jump();
+  reference.jump();
+  for (auto i = 0; i < 100; ++i) {
+    REQUIRE(generator() == reference());
+  }
+  generator.advance(std::uint64_t{12345});
+  reference.advance(std::uint64_t{12345});
+  REQUIRE(generator.uniform() == reference.uniform());
+  REQUIRE(generator.getKey() == reference.getKey());
+}
+
+TEST_CASE("SIMD", "[philox]") {
+  const auto seed = std::random_device{}();
+  INFO("SEED: " << seed);
+  std::mt19937_64 rng64(seed);
+  const key_type key{rng64(), rng64()};
+  check_against_scalar<PhiloxSIMD>(key, {rng64(), rng64(), rng64(), rng64()});
+  check_against_scalar<prng::PhiloxDispatch>(key, {rng64(), rng64(), rng64(), rng64()});
+}
+
+TEST_CASE("COUNTER CARRY", "[philox]") {
+  // the low words wrap inside a SIMD batch and carry into the higher ones
+  constexpr auto ones = ~std::uint64_t{0};
+  for (auto offset = std::uint64_t{1}; offset <= 9; ++offset) {
+    INFO("offset: " << offset);
+    check_against_scalar<PhiloxSIMD>({5, 7}, {ones - offset, ones, ones - 1, 0});
+    check_against_scalar<prng::PhiloxDispatch>({5, 7}, {ones - offset, ones, ones, ones});
+  }
+}
+
+TEST_CASE("ADVANCE", "[philox]") {
+  // advancing by n blocks is the same as drawing 4n outputs from a fresh generator
+  prng::Philox advanced({9, 10});
+  prng::Philox reference({9, 10});
+  advanced.advance(std::uint64_t{100});
+  for (auto i = 0; i < 400; ++i) {
+    reference();
+  }
+  for (auto i = 0; i < 16; ++i) {
+    REQUIRE(advanced() == reference());
+  }
+}
@@ -0,0 +1,169 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/chacha.hpp>
+#include <random/pcg64.hpp>
+#include <random/seed_sequence.hpp>
+#include <random/xoshiro_scalar.hpp>
+#include <random/xoshiro_simd.hpp>
+
+using words32 = std::vector<std::uint32_t>;
+using words64 = std::vector<std::uint64_t>;
+
+template <class T, class Arch = xsimd::best_arch>
+std::vector<T> state_of(const prng::SeedSequence &seq, const std::size_t n) {
+  std::vector<T> state(n);
+  seq.generate_state<T, Arch>(state.data(), n);
+  return state;
+}
+
+TEST_CASE("KNOWN ANSWERS", "[seed_sequence]") {
+  // computed with numpy.random.SeedSequence
+  const prng::SeedSequence seq(0);
+  REQUIRE(seq.pool() == std::array<std::uint32_t, 4>{0xfe40eb07, 0x4f363a36, 0x4eb2009d, 0xc89a7aa7});
+  REQUIRE(state_of<std::uint32_t>(seq, 8) ==
+          words32{0xb0f478be, 0xdb2cd7e7, 0x2c71ba49, 0xabf4641a, 0x9d7b8d41, 0x20c6ed6d, 0x223c39d4, 0x2c4099de});
+  REQUIRE(state_of<std::uint64_t>(seq, 3) == words64{0xdb2cd7e7b0f478be, 0xabf4641a2c71ba49, 0x20c6ed6d9d7b8d41});
+
+  // entropy and spawn key integers of 64 bits take two words
+  const prng::SeedSequence keyed({1, (std::uint64_t{1} << 40) + 5}, {3, 7});
+  REQUIRE(keyed.pool() == std::array<std::uint32_t, 4>{0x0684a42a, 0x616b5bd1, 0x4bf6b6f3, 0x2acad9c4});
+  REQUIRE(state_of<std::uint32_t>(keyed, 5) == words32{0xcd960309, 0xf3fbf093, 0x71da110c, 0x0b8e64ef, 0xef7c37e3});
+
+  // more than four entropy words
+  const prng::SeedSequence long_entropy({1, 2, 3, 4, 5, 6});
+  REQUIRE(state_of<std::uint32_t>(long_entropy, 4) == words32{0x1d1bca21, 0xebcd001d, 0xb202608b, 0xcfea83a4});
+
+  // numpy.random.PCG64(0).state
+  const auto words = seq.generate_state<std::uint64_t, 4>();
+  const auto pcg = prng::PCG64DXSM::seeded({words[1], words[0]}, {words[3], words[2]});
+  REQUIRE(pcg.getState() == prng::PCG64DXSM::state_type{0x09585eb7a69561e3, 0x1aa1b5345996452d});
+  REQUIRE(pcg.getIncrement() == prng::PCG64DXSM::state_type{0x588133bc447873a9, 0x418ddadb3af71a82});
+}
+
+TEST_CASE("SPAWN", "[seed_sequence]") {
+  // SeedSequence(12345).spawn(3)[2].spawn(2)[1] in NumPy
+  prng::SeedSequence root(12345);
+  auto children = root.spawn(3);
+  REQUIRE(root.children_spawned() == 3);
+  auto grandchildren = children[2].spawn(2);
+  REQUIRE(children[2].children_spawned() == 2);
+  REQUIRE(grandchildren[1].children_spawned() == 0);
+  REQUIRE(state_of<std::uint64_t>(grandchildren[1], 4) ==
+          words64{0xef5db3e9b95fa22b, 0xf311d76945bee559, 0x5aa6a182c5378fb3, 0x7c9cf5b469bcef1b});
+
+  // a spawned child has the pool of the sequence constructed with its spawn key
+  for (auto i = std::uint64_t{0}; i < 3; ++i) {
+    REQUIRE(children[i].pool() == prng::SeedSequence({12345}, {i}).pool());
+  }
+  REQUIRE(grandchildren[0].pool() == prng::SeedSequence({12345}, {2, 0}).pool());
+  // further spawns continue the indices
+  REQUIRE(root.spawn(1)[0].pool() == prng::SeedSequence({12345}, {3}).pool());
+
+  // indices of 2^32 and above take two words
+  REQUIRE(state_of<std::uint32_t>(prng::SeedSequence({12345}, {std::uint64_t{1} << 33}), 4) ==
+          words32{0xf90e301c, 0x24d65818, 0xd8815de7, 0x801cc93f});
+
+  // distinct children give distinct states
+  std::set<std::array<std::uint64_t, 4>> states;
+  for (const auto &child : prng::SeedSequence(42).spawn(10000)) {
+    states.insert(child.generate_state<std::uint64_t, 4>());
+  }
+  REQUIRE(states.size() == 10000);
+}
+
+TEST_CASE("SPAWN MANY", "[seed_sequence]") {
+  prng::SeedSequence root(7);
+  const auto start = std::chrono::steady_clock::now();
+  const auto children = root.spawn(1'000'000);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  INFO("spawning a million children took " << std::chrono::duration<double>(elapsed).count() << " s");
+  REQUIRE(children.size() == 1'000'000);
+  REQUIRE(children.back().pool() == prng::SeedSequence({7}, {999'999}).pool());
+}
+
+// generate_state as written in NumPy, one word at a time
+std::vector<std::uint32_t> reference_state(const prng::SeedSequence &seq, const std::size_t n) {
+  std::vector<std::uint32_t> state(n);
+  std::uint32_t hash = 0x8b51f9dd;
+  for (auto i = std::size_t{0}; i < n; ++i) {
+    auto value = seq.pool()[i % 4] ^ hash;
+    hash *= 0x58f38ded;
+    value *= hash;
+    state[i] = value ^ (value >> 16);
+  }
+  return state;
+}
+
+template <class Arch> void check_target(const bool available) {
+  if (!available) {
+    WARN("architecture not supported by this CPU");
+    return;
+  }
+  const prng::SeedSequence seq({0xdeadbeef, 0x0123456789abcdef}, {5});
+  for (const auto n : {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{17}, std::size_t{100}}) {
+    INFO("n: " << n);
+    const auto words = state_of<std::uint32_t, Arch>(seq, 2 * n);
+    REQUIRE(words == reference_state(seq, 2 * n));
+    const auto pairs = state_of<std::uint64_t, Arch>(seq, n);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+      REQUIRE(pairs[i] == (words[2 * i] | std::uint64_t{words[2 * i + 1]} << 32));
+    }
+  }
+}
+
+TEST_CASE("SIMD", "[seed_sequence]") {
+  const auto available = xsimd::available_architectures();
+  // only the instruction sets this file is compiled for can be instantiated
+#if XSIMD_WITH_SSE2
+  SECTION("sse2") { check_target<xsimd::sse2>(available.sse2); }
+#endif
+#if XSIMD_WITH_SSE4_2
+  SECTION("sse4_2") { check_target<xsimd::sse4_2>(available.sse4_2); }
+#endif
+#if XSIMD_WITH_FMA3_AVX2
+  SECTION("fma3<avx2>") { check_target<xsimd::fma3<xsimd::avx2>>(available.fma3_avx2); }
+#endif
+#if XSIMD_WITH_AVX512F
+  SECTION("avx512f") { check_target<xsimd::avx512f>(available.avx512f); }
+#endif
+  SECTION("best_arch") { check_target<xsimd::best_arch>(true); }
+}
+
+TEST_CASE("ENGINES", "[seed_sequence]") {
+  prng::SeedSequence root(2024);
+  const auto children = root.spawn(2);
+  const auto state = children[0].generate_state<std::uint64_t, 4>();
+
+  // the 256-bit state seeds the first lane, the other lanes are jumps apart as with a 64-bit seed
+  prng::XoshiroScalar scalar(state);
+  REQUIRE(scalar.getState() == state);
+  prng::XoshiroNative native(state);
+  prng::XoshiroSIMD dispatch(state);
+  for (auto i = 0; i < 1000; ++i) {
+    REQUIRE(native() == dispatch());
+  }
+  prng::XoshiroNative from_seed(2024);
+  REQUIRE(prng::XoshiroNative(prng::XoshiroScalar(2024).getState())() == from_seed());
+
+  const auto key = children[1].generate_state<std::uint32_t, 8>();
+  prng::ChaCha20 chacha(key, 0, 0);
+  prng::ChaCha20 other(children[0].generate_state<std::uint32_t, 8>(), 0, 0);
+  REQUIRE(chacha() != other());
+
+  // a standard seed sequence
+  std::mt19937_64 mt(root);
+  REQUIRE(mt() == std::mt19937_64(root)());
+  std::array<std::uint32_t, 4> generated{};
+  root.generate(generated.begin(), generated.end());
+  REQUIRE(generated == root.generate_state<std::uint32_t, 4>());
+  static_assert(std::is_trivially_copyable_v<prng::SeedSequence>);
+}
@@ -0,0 +1,171 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include <random/sobol.hpp>
+#include <random/splitmix.hpp>
+
+namespace {
+
+// Burley's scalar nested uniform scrambling
+std::uint32_t reverse(std::uint32_t x) {
+  auto result = std::uint32_t{0};
+  for (auto i = 0; i < 32; ++i, x >>= 1) {
+    result = result << 1 | (x & 1);
+  }
+  return result;
+}
+
+std::uint32_t owen(std::uint32_t x, const std::uint32_t seed) {
+  x = reverse(x);
+  x += seed;
+  x ^= x * 0x6c50b47cu;
+  x ^= x * 0xb82f1e52u;
+  x ^= x * 0xc7afe638u;
+  x ^= x * 0x8d22f6e6u;
+  return reverse(x);
+}
+
+// every elementary box 2^-a x 2^-(k - a) of the first 2^k points of dimensions 0 and 1 holds exactly one point, and
+// every dimension alone takes each multiple of 2^-k once
+template <std::size_t Dims> void check_stratified(prng::Sobol<Dims> sobol, const int k) {
+  std::vector<std::array<std::uint32_t, Dims>> points(std::size_t{1} << k);
+  for (auto &point : points) {
+    sobol.next(point.data());
+  }
+  for (auto d = std::size_t{0}; d < Dims; ++d) {
+    INFO("dimension: " << d);
+    std::set<std::uint32_t> cells;
+    for (const auto &point : points) {
+      cells.insert(point[d] >> (32 - k));
+    }
+    REQUIRE(cells.size() == points.size());
+  }
+  for (auto a = 1; a < k; ++a) {
+    INFO("split: " << a);
+    std::set<std::uint32_t> boxes;
+    for (const auto &point : points) {
+      boxes.insert(point[0] >> (32 - a) << (k - a) | point[1] >> (32 - k + a));
+    }
+    REQUIRE(boxes.size() == points.size());
+  }
+}
+
+} // namespace
+
+TEST_CASE("KNOWN POINTS", "[sobol]") {
+  // the first points of scipy.stats.qmc.Sobol(2, scramble=False)
+  const std::vector<std::array<double, 2>> expected{{0, 0},         {0.5, 0.5},     {0.75, 0.25},   {0.25, 0.75},
+                                                    {0.375, 0.375}, {0.875, 0.875}, {0.625, 0.125}, {0.125, 0.625}};
+  prng::Sobol<2> sobol;
+  for (const auto &point : expected) {
+    REQUIRE(sobol() == point);
+  }
+  // the first direction number of every dimension is 1/2
+  prng::Sobol<prng::internal::SOBOL_MAX_DIMENSIONS> wide;
+  wide();
+  for (const auto x : wide()) {
+    REQUIRE(x == 0.5);
+  }
+}
+
+TEST_CASE("STRATIFICATION", "[sobol]") {
+  check_stratified(prng::Sobol<prng::internal::SOBOL_MAX_DIMENSIONS>(), 10);
+  check_stratified(prng::Sobol<prng::internal::SOBOL_MAX_DIMENSIONS>(42, prng::SobolScrambling::linear_matrix), 10);
+  check_stratified(prng::Sobol<prng::internal::SOBOL_MAX_DIMENSIONS>(42, prng::SobolScrambling::owen), 10);
+  check_stratified(prng::Sobol<5>(7, prng::SobolScrambling::owen), 14);
+}
+
+TEST_CASE("OWEN SCRAMBLING", "[sobol]") {
+  constexpr auto seed = std::uint64_t{12345};
+  prng::Sobol<7> plain;
+  prng::Sobol<7> scrambled(seed, prng::SobolScrambling::owen);
+  prng::SplitMix rng(seed);
+  std::array<std::uint32_t, 7> seeds{};
+  for (auto &value : seeds) {
+    value = static_cast<std::uint32_t>(rng() >> 32);
+  }
+  std::array<std::uint32_t, 7> expected{}, actual{};
+  for (auto i = 0; i < 1000; ++i) {
+    plain.next(expected.data());
+    scrambled.next(actual.data());
+    for (auto d = std::size_t{0}; d < 7; ++d) {
+      REQUIRE(actual[d] == owen(expected[d], seeds[d]));
+    }
+  }
+}
+
+template <std::size_t Dims> void check_access(const prng::SobolScrambling scrambling) {
+  prng::Sobol<Dims> reference(99, scrambling);
+  std::vector<std::array<double, Dims>> points(3000);
+  for (auto &point : points) {
+    point = reference();
+  }
+  for (const auto index : {std::size_t{0}, std::size_t{1}, std::size_t{2}, std::size_t{255}, std::size_t{1024},
+                           std::size_t{2047}, std::size_t{2999}}) {
+    INFO("index: " << index);
+    prng::Sobol<Dims> sobol(99, scrambling);
+    sobol.seek(index);
+    REQUIRE(sobol.index() == index);
+    REQUIRE(sobol() == points[index]);
+  }
+  prng::Sobol<Dims> skipped(99, scrambling);
+  skipped();
+  skipped.skip(1500);
+  REQUIRE(skipped() == points[1501]);
+
+  // fill writes the points row by row
+  prng::Sobol<Dims> filled(99, scrambling);
+  filled();
+  std::vector<double> matrix(100 * Dims);
+  filled.fill(matrix.data(), 100);
+  for (auto i = std::size_t{0}; i < 100; ++i) {
+    for (auto d = std::size_t{0}; d < Dims; ++d) {
+      REQUIRE(matrix[i * Dims + d] == points[i + 1][d]);
+    }
+  }
+  REQUIRE(filled.index() == 101);
+
+  // doubles are the 32-bit coordinates scaled by 2^-32
+  prng::Sobol<Dims> integers(99, scrambling);
+  std::array<std::uint32_t, Dims> coordinates{};
+  for (auto i = std::size_t{0}; i < 50; ++i) {
+    integers.next(coordinates.data());
+    for (auto d = std::size_t{0}; d < Dims; ++d) {
+      REQUIRE(points[i][d] == coordinates[d] * 0x1.0p-32);
+    }
+  }
+}
+
+TEST_CASE("RANDOM ACCESS", "[sobol]") {
+  for (const auto scrambling :
+       {prng::SobolScrambling::none, prng::SobolScrambling::linear_matrix, prng::SobolScrambling::owen}) {
+    check_access<1>(scrambling);
+    check_access<3>(scrambling);
+    check_access<8>(scrambling);
+    check_access<13>(scrambling);
+    check_access<prng::internal::SOBOL_MAX_DIMENSIONS>(scrambling);
+  }
+}
+
+TEST_CASE("SEEDS", "[sobol]") {
+  for (const auto scrambling : {prng::SobolScrambling::linear_matrix, prng::SobolScrambling::owen}) {
+    prng::Sobol<4> a(1, scrambling), b(1, scrambling), c(2, scrambling);
+    REQUIRE(a.scrambling() == scrambling);
+    const auto first = a();
+    REQUIRE(first == b());
+    REQUIRE(first != c());
+    // scrambled points are spread over the whole cube, not starting at the origin
+    auto sum = 0.0;
+    for (auto i = 0; i < 4095; ++i) {
+      for (const auto x : a()) {
+        sum += x;
+      }
+    }
+    REQUIRE(sum / (4 * 4095) == Catch::Approx(0.5).margin(1e-3));
+  }
+}
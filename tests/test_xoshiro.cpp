@@ -5,6 +5,14 @@
 
 #include "xoshiro256plusplus.c"
 
+// the other reference implementations reuse the same names, so they get their own namespaces
+namespace plus {
+#include "xoshiro256plus.c"
+}
+namespace starstar {
+#include "xoshiro256starstar.c"
+}
+
 static constexpr auto tests = 1 << 15;
 
 TEST_CASE("xoshiro256++", "[xoshiro256++]") {
@@ -28,3 +36,79 @@ TEST_CASE("xoshiro256++", "[xoshiro256++]") {
         REQUIRE(result < 1);
     }
 }
+
+TEST_CASE("discard", "[xoshiro256++]") {
+    const auto seed = std::random_device()();
+    INFO("SEED: " << seed);
+    for (const auto n : {0ULL, 1ULL, 255ULL, 256ULL, 257ULL, 1000ULL, 12345ULL}) {
+        INFO("n: " << n);
+        prng::XoshiroScalar rng(seed);
+        prng::XoshiroScalar reference(seed);
+        rng.discard(n);
+        for (auto i = 0ULL; i < n; ++i) {
+            reference();
+        }
+        REQUIRE(rng.getState() == reference.getState());
+    }
+    // distances composed from arbitrary bits must add up
+    prng::XoshiroScalar rng(seed);
+    prng::XoshiroScalar reference(seed);
+    rng.discard(0xdeadbeefcafef00dULL);
+    rng.discard(0x0123456789abcdefULL);
+    reference.discard(0xdeadbeefcafef00dULL + 0x0123456789abcdefULL);
+    REQUIRE(rng.getState() == reference.getState());
+}
+
+TEST_CASE("jump_to_stream", "[xoshiro256++]") {
+    const auto seed = std::random_device()();
+    INFO("SEED: " << seed);
+    prng::XoshiroScalar reference(seed);
+    for (auto k = 0ULL; k < 8; ++k) {
+        INFO("k: " << k);
+        prng::XoshiroScalar rng(seed);
+        rng.jump_to_stream(k);
+        REQUIRE(rng.getState() == reference.getState());
+        REQUIRE(prng::XoshiroScalar(seed, k).getState() == reference.getState());
+        reference.jump();
+    }
+    prng::XoshiroScalar cluster(seed, 3, 2);
+    prng::XoshiroScalar manual(seed);
+    for (auto i = 0; i < 3; ++i) {
+        manual.jump();
+    }
+    manual.long_jump();
+    manual.long_jump();
+    REQUIRE(cluster.getState() == manual.getState());
+}
+
+TEST_CASE("xoshiro256+", "[xoshiro256+]") {
+    const auto seed = std::random_device()();
+    INFO("SEED: " << seed);
+    prng::XoshiroPlusScalar rng(seed);
+    for (auto i = 0; i < 4; ++i) {
+        plus::s[i] = rng.getState()[i];
+    }
+    for (int i = 0; i < tests; ++i) { REQUIRE(rng() == plus::next()); }
+    rng.jump();
+    plus::jump();
+    for (auto i = 0; i < 4; ++i) {
+        REQUIRE(rng.getState()[i] == plus::s[i]);
+    }
+    for (int i = 0; i < tests; ++i) { REQUIRE(rng() == plus::next()); }
+}
+
+TEST_CASE("xoshiro256**", "[xoshiro256**]") {
+    const auto seed = std::random_device()();
+    INFO("SEED: " << seed);
+    prng::XoshiroStarStarScalar rng(seed);
+    for (auto i = 0; i < 4; ++i) {
+        starstar::s[i] = rng.getState()[i];
+    }
+    for (int i = 0; i < tests; ++i) { REQUIRE(rng() == starstar::next()); }
+    rng.jump();
+    starstar::jump();
+    for (auto i = 0; i < 4; ++i) {
+        REQUIRE(rng.getState()[i] == starstar::s[i]);
+    }
+    for (int i = 0; i < tests; ++i) { REQUIRE(rng() == starstar::next()); }
+}
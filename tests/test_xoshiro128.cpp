@@ -0,0 +1,247 @@
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <random/xoshiro128_simd.hpp>
+
+// the reference implementations reuse the same names, so each gets its own namespace
+namespace plusplus {
+#include "xoshiro128plusplus.c"
+}
+namespace starstar {
+#include "xoshiro128starstar.c"
+}
+
+static constexpr auto tests = 1 << 12; // 4096
+constexpr auto SIMD_WIDTH = xsimd::simd_type<prng::Xoshiro128Native::result_type>::size;
+
+namespace {
+
+/**
+ * Checks a scalar engine against the reference implementation, including both jumps.
+ */
+template <class Scalar, class Next, class Jump, class LongJump>
+void check_reference(const std::uint64_t seed, std::uint32_t (&s)[4], Next next, Jump jump, LongJump long_jump) {
+  Scalar rng(seed);
+  for (auto i = 0; i < 4; ++i) {
+    s[i] = rng.getState()[i];
+  }
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(rng() == next());
+  }
+  rng.jump();
+  jump();
+  for (auto i = 0; i < 4; ++i) {
+    REQUIRE(rng.getState()[i] == s[i]);
+  }
+  rng.long_jump();
+  long_jump();
+  for (auto i = 0; i < 4; ++i) {
+    REQUIRE(rng.getState()[i] == s[i]);
+  }
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(rng() == next());
+  }
+}
+
+/**
+ * Returns `width` scalar engines, lane `i` starting `i` jumps after the engine seeded with `seed`.
+ */
+template <class Scalar> std::vector<Scalar> make_lanes(const std::uint64_t seed, const std::size_t width) {
+  std::vector<Scalar> lanes;
+  Scalar scalar(seed);
+  for (auto i = 0UL; i < width; ++i) {
+    lanes.push_back(scalar);
+    scalar.jump();
+  }
+  return lanes;
+}
+
+/**
+ * Checks that the native and dispatched engines of one scrambler follow the matching scalar engine, lane by lane.
+ */
+template <class Scalar, class Native, class Dispatch> void check_simd(const std::uint64_t seed) {
+  auto lanes = make_lanes<Scalar>(seed, SIMD_WIDTH);
+  Native native(seed);
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(native() == lanes[i % SIMD_WIDTH]());
+  }
+  // the dispatched engine may run a different SIMD width, so every dispatch target is tried
+  Dispatch dispatch(seed);
+  std::vector<std::uint32_t> buffer(tests);
+  dispatch.fill(buffer.data(), buffer.size());
+  auto matched = false;
+  for (const auto width : {4UL, 8UL, 16UL}) {
+    auto candidate = make_lanes<Scalar>(seed, width);
+    auto i = 0UL;
+    while (i < buffer.size() && buffer[i] == candidate[i % width]()) {
+      ++i;
+    }
+    matched = matched || i == buffer.size();
+  }
+  REQUIRE(matched);
+}
+
+} // namespace
+
+TEST_CASE("xoshiro128++", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  check_reference<prng::Xoshiro128Scalar>(seed, plusplus::s, plusplus::next, plusplus::jump, plusplus::long_jump);
+  check_simd<prng::Xoshiro128Scalar, prng::Xoshiro128Native, prng::Xoshiro128SIMD>(seed);
+}
+
+TEST_CASE("xoshiro128**", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  check_reference<prng::Xoshiro128StarStarScalar>(seed, starstar::s, starstar::next, starstar::jump,
+                                                  starstar::long_jump);
+  check_simd<prng::Xoshiro128StarStarScalar, prng::Xoshiro128StarStarNative, prng::Xoshiro128StarStarSIMD>(seed);
+}
+
+TEST_CASE("SEED", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  // the native generator points into its own cache, so it must not be copied or moved
+  static_assert(!std::is_copy_constructible_v<prng::Xoshiro128Native>);
+  static_assert(!std::is_move_constructible_v<prng::Xoshiro128Native>);
+  prng::Xoshiro128Native rng(seed, 2);
+  prng::Xoshiro128Scalar reference(seed, 2);
+  for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+    REQUIRE(rng.getState(i) == reference.getState());
+    reference.jump();
+  }
+  rng.long_jump();
+  rng.jump();
+  reference = prng::Xoshiro128Scalar(seed, 3);
+  reference.jump();
+  for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+    REQUIRE(rng.getState(i) == reference.getState());
+    reference.jump();
+  }
+}
+
+TEST_CASE("FILL", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::Xoshiro128Native native(seed);
+  prng::Xoshiro128Native native_reference(seed);
+  prng::Xoshiro128SIMD dispatch(seed);
+  prng::Xoshiro128SIMD dispatch_reference(seed);
+  std::vector<std::uint32_t> buffer(tests + 1);
+  std::vector<float> uniforms(tests + 1);
+  for (const auto size : {0UL, 1UL, 3UL, 255UL, 256UL, 257UL, 1000UL, static_cast<unsigned long>(tests)}) {
+    for (const auto offset : {0UL, 1UL}) {
+      INFO("size: " << size << " offset: " << offset);
+      native.fill(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == native_reference());
+      }
+      dispatch.fill(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == dispatch_reference());
+      }
+      native.fill_uniform(uniforms.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(uniforms[offset + i] == native_reference.uniform());
+      }
+      dispatch.fill_uniform(uniforms.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(uniforms[offset + i] == dispatch_reference.uniform());
+        REQUIRE(uniforms[offset + i] >= 0);
+        REQUIRE(uniforms[offset + i] < 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("NEXT BATCH", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::Xoshiro128Native rng(seed);
+  auto lanes = make_lanes<prng::Xoshiro128Scalar>(seed, SIMD_WIDTH);
+  for (auto i = 0; i < tests; i += SIMD_WIDTH) {
+    const auto batch = rng.next_uniform_batch();
+    for (auto lane = 0UL; lane < SIMD_WIDTH; ++lane) {
+      REQUIRE(batch.get(lane) == lanes[lane].uniform());
+    }
+  }
+  // edges of the 24-bit mantissa range
+  using batch = xsimd::batch<std::uint32_t, xsimd::best_arch>;
+  for (const auto edge : {0U, 0xFFU, 0x100U, 0x7FFFFFFFU, 0x80000000U, 0xFFFFFFFFU}) {
+    INFO("value: " << edge);
+    REQUIRE(prng::internal::to_uniform(batch(edge)).get(0) == prng::internal::to_uniform(edge));
+  }
+}
+
+TEST_CASE("DISCARD", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  for (const auto n : {0ULL, 1ULL, 128ULL, 129ULL, 1000ULL, 12345ULL}) {
+    INFO("n: " << n);
+    prng::Xoshiro128Scalar scalar(seed);
+    prng::Xoshiro128Scalar scalar_reference(seed);
+    scalar.discard(n);
+    prng::Xoshiro128Native native(seed);
+    prng::Xoshiro128Native native_reference(seed);
+    native();
+    native.discard(n);
+    prng::Xoshiro128SIMD dispatch(seed);
+    prng::Xoshiro128SIMD dispatch_reference(seed);
+    dispatch.discard(n);
+    for (auto i = 0ULL; i < n; ++i) {
+      scalar_reference();
+      native_reference();
+      dispatch_reference();
+    }
+    native_reference();
+    REQUIRE(scalar.getState() == scalar_reference.getState());
+    for (auto i = 0; i < 300; ++i) {
+      REQUIRE(native() == native_reference());
+      REQUIRE(dispatch() == dispatch_reference());
+    }
+  }
+  // output j of the native generator is value j / SIMD_WIDTH of lane j % SIMD_WIDTH
+  const auto n = 0xdeadbeefcafef00dULL;
+  prng::Xoshiro128Native rng(seed);
+  rng.discard(n);
+  for (auto j = n; j < n + 2 * SIMD_WIDTH; ++j) {
+    auto lane = make_lanes<prng::Xoshiro128Scalar>(seed, j % SIMD_WIDTH + 1).back();
+    lane.discard(j / SIMD_WIDTH);
+    REQUIRE(rng() == lane());
+  }
+}
+
+TEST_CASE("STREAM", "[xoshiro128]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  for (const auto k : {1ULL, 2ULL, 5ULL, 37ULL}) {
+    INFO("k: " << k);
+    prng::Xoshiro128Scalar manual(seed);
+    for (auto i = 0ULL; i < k; ++i) {
+      manual.long_jump();
+    }
+    REQUIRE(prng::Xoshiro128Scalar(seed, k).getState() == manual.getState());
+    prng::Xoshiro128Native rng(seed, k);
+    prng::Xoshiro128Native streamed(seed);
+    streamed.jump_to_stream(k);
+    for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+      REQUIRE(rng.getState(i) == manual.getState());
+      REQUIRE(streamed.getState(i) == manual.getState());
+      manual.jump();
+    }
+    prng::Xoshiro128SIMD dispatch(seed, k);
+    prng::Xoshiro128SIMD dispatch_streamed(seed);
+    dispatch_streamed.jump_to_stream(k);
+    for (auto i = 0; i < 300; ++i) {
+      REQUIRE(dispatch() == dispatch_streamed());
+    }
+  }
+  // the period is 2^128 - 1, so 2^32 long jumps land one step ahead
+  prng::Xoshiro128Scalar wrapped(seed, 1ULL << 32);
+  prng::Xoshiro128Scalar reference(seed);
+  reference.discard(1);
+  REQUIRE(wrapped.getState() == reference.getState());
+}
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 #include <random/xoshiro_simd.hpp>
@@ -100,3 +105,422 @@ TEST_CASE("GENERATE DOUBLE", "[xoshiro256++]") {
     }
   }
 }
+
+TEST_CASE("FILL", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::XoshiroNative native(seed);
+  prng::XoshiroNative native_reference(seed);
+  prng::XoshiroSIMD dispatch(seed);
+  prng::XoshiroSIMD dispatch_reference(seed);
+  // odd sizes and a misaligned start exercise the cache drain, the unaligned path and the tail
+  std::vector<prng::XoshiroNative::result_type> buffer(tests + 1);
+  for (const auto size : {0UL, 1UL, 3UL, 255UL, 256UL, 257UL, 1000UL, static_cast<unsigned long>(tests)}) {
+    for (const auto offset : {0UL, 1UL}) {
+      INFO("size: " << size << " offset: " << offset);
+      native.fill(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == native_reference());
+      }
+      dispatch.fill(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == dispatch_reference());
+      }
+      REQUIRE(native() == native_reference());
+      REQUIRE(dispatch() == dispatch_reference());
+    }
+  }
+}
+
+TEST_CASE("FILL UNIFORM", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::XoshiroNative native(seed);
+  prng::XoshiroNative native_reference(seed);
+  prng::XoshiroSIMD dispatch(seed);
+  prng::XoshiroSIMD dispatch_reference(seed);
+  std::vector<double> buffer(tests + 1);
+  for (const auto size : {0UL, 1UL, 3UL, 255UL, 256UL, 257UL, 1000UL, static_cast<unsigned long>(tests)}) {
+    for (const auto offset : {0UL, 1UL}) {
+      INFO("size: " << size << " offset: " << offset);
+      native.fill_uniform(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == native_reference.uniform());
+      }
+      dispatch.fill_uniform(buffer.data() + offset, size);
+      for (auto i = 0UL; i < size; ++i) {
+        REQUIRE(buffer[offset + i] == dispatch_reference.uniform());
+      }
+    }
+  }
+}
+
+template <class T> using aligned_vector = std::vector<T, xsimd::aligned_allocator<T>>;
+
+/**
+ * Fills from every offset of an aligned buffer, after a few values were drawn, and checks the output against the same
+ * values written by operator() and uniform(). The size reaches the non-temporal path.
+ */
+template <class Engine> static void check_fill_alignment(const std::uint64_t seed) {
+  using result_type = typename Engine::result_type;
+  constexpr auto size = (std::size_t{32} << 20) / sizeof(result_type) + 3;
+  constexpr auto width = prng::internal::MAX_SIMD_WIDTH;
+  aligned_vector<result_type> expected(size);
+  aligned_vector<double> expected_uniform(size);
+  aligned_vector<result_type> buffer(size + width);
+  aligned_vector<double> buffer_uniform(size + width);
+  for (const auto drawn : {0UL, 1UL, 3UL}) {
+    Engine reference(seed);
+    for (auto i = 0UL; i < drawn; ++i) {
+      reference();
+    }
+    std::generate(expected.begin(), expected.end(), [&reference] { return reference(); });
+    std::generate(expected_uniform.begin(), expected_uniform.end(), [&reference] { return reference.uniform(); });
+    for (auto offset = 0UL; offset < width; ++offset) {
+      INFO("drawn: " << drawn << " offset: " << offset);
+      Engine rng(seed);
+      for (auto i = 0UL; i < drawn; ++i) {
+        rng();
+      }
+      rng.fill(buffer.data() + offset, size);
+      REQUIRE(std::equal(expected.begin(), expected.end(), buffer.begin() + offset));
+      rng.fill_uniform(buffer_uniform.data() + offset, size);
+      REQUIRE(std::equal(expected_uniform.begin(), expected_uniform.end(), buffer_uniform.begin() + offset));
+    }
+  }
+}
+
+TEST_CASE("FILL ALIGNMENT", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  check_fill_alignment<prng::XoshiroNative>(seed);
+  check_fill_alignment<prng::BasicXoshiroNative<256, 4>>(seed);
+  check_fill_alignment<prng::XoshiroSIMD>(seed);
+}
+
+TEST_CASE("UNIFORM CONVERSION", "[xoshiro256++]") {
+  using batch = xsimd::batch<std::uint64_t, xsimd::best_arch>;
+  // extremes of the 53-bit mantissa range, plus values straddling the 32-bit split
+  constexpr std::uint64_t edges[] = {0, 1, 0x7FF, 0x800, 0xFFFFFFFF, 0x100000000, 0x7FFFFFFFFFFFFFFF,
+                                     0x8000000000000000, 0xFFFFFFFFFFFFF800, 0xFFFFFFFFFFFFFFFF};
+  for (const auto edge : edges) {
+    INFO("value: " << edge);
+    const auto converted = prng::internal::to_uniform(batch(edge));
+    REQUIRE(converted.get(0) == prng::internal::to_uniform(edge));
+  }
+}
+
+TEST_CASE("DISCARD", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  // discard(n) must match n calls to operator(), from a fresh generator and from the middle of the cache
+  for (const auto skip : {0ULL, 3ULL}) {
+    for (const auto n : {0ULL, 1ULL, 5ULL, 253ULL, 256ULL, 257ULL, 1000ULL, 12345ULL}) {
+      INFO("skip: " << skip << " n: " << n);
+      prng::XoshiroNative rng(seed);
+      prng::XoshiroNative reference(seed);
+      prng::XoshiroSIMD dispatch(seed);
+      prng::XoshiroSIMD dispatch_reference(seed);
+      for (auto i = 0ULL; i < skip; ++i) {
+        rng();
+        dispatch();
+      }
+      rng.discard(n);
+      dispatch.discard(n);
+      for (auto i = 0ULL; i < skip + n; ++i) {
+        reference();
+        dispatch_reference();
+      }
+      for (auto i = 0; i < 300; ++i) {
+        REQUIRE(rng() == reference());
+        REQUIRE(dispatch() == dispatch_reference());
+      }
+    }
+  }
+  // output j of the native generator is value j / SIMD_WIDTH of lane j % SIMD_WIDTH
+  for (const auto n : {0xdeadbeefcafef00dULL, 0x0123456789abcdefULL}) {
+    INFO("n: " << n);
+    prng::XoshiroNative rng(seed);
+    rng.discard(n);
+    for (auto j = n; j < n + 2 * SIMD_WIDTH; ++j) {
+      prng::XoshiroScalar lane(seed);
+      for (auto i = 0UL; i < j % SIMD_WIDTH; ++i) {
+        lane.jump();
+      }
+      lane.discard(j / SIMD_WIDTH);
+      REQUIRE(rng() == lane());
+    }
+  }
+  // distances composed from arbitrary bits must add up
+  prng::XoshiroSIMD dispatch(seed);
+  prng::XoshiroSIMD dispatch_reference(seed);
+  dispatch.discard(0xdeadbeefcafef00dULL);
+  dispatch.discard(0x0123456789abcdefULL);
+  dispatch_reference.discard(0xdeadbeefcafef00dULL + 0x0123456789abcdefULL);
+  for (auto i = 0; i < 300; ++i) {
+    REQUIRE(dispatch() == dispatch_reference());
+  }
+}
+
+TEST_CASE("STREAM", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::XoshiroNative rng(seed, 5, 3);
+  prng::XoshiroNative manual(seed);
+  for (auto i = 0; i < 5; ++i) {
+    manual.mid_jump();
+  }
+  for (auto i = 0; i < 3; ++i) {
+    manual.long_jump();
+  }
+  for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+    REQUIRE(rng.getState(i) == manual.getState(i));
+  }
+  prng::XoshiroNative streamed(seed);
+  streamed.jump_to_stream(5);
+  prng::XoshiroNative threaded(seed, 5);
+  for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+    REQUIRE(streamed.getState(i) == threaded.getState(i));
+  }
+}
+
+TEST_CASE("CACHE SIZE", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  // the cache only changes how often the state is advanced, never the sequence
+  prng::XoshiroNative native(seed);
+  prng::BasicXoshiroNative<0> native_uncached(seed);
+  prng::BasicXoshiroNative<64> native_small(seed);
+  prng::BasicXoshiroNative<1024> native_large(seed);
+  prng::XoshiroSIMD dispatch(seed);
+  prng::BasicXoshiroSIMD<0> dispatch_uncached(seed);
+  prng::BasicXoshiroSIMD<64> dispatch_small(seed);
+  prng::BasicXoshiroSIMD<1024> dispatch_large(seed);
+  for (auto i = 0; i < tests; ++i) {
+    const auto expected = native();
+    REQUIRE(native_uncached() == expected);
+    REQUIRE(native_small() == expected);
+    REQUIRE(native_large() == expected);
+    const auto dispatched = dispatch();
+    REQUIRE(dispatch_uncached() == dispatched);
+    REQUIRE(dispatch_small() == dispatched);
+    REQUIRE(dispatch_large() == dispatched);
+  }
+  std::vector<prng::XoshiroNative::result_type> buffer(tests + 1);
+  dispatch_small.fill(buffer.data(), 3);
+  for (auto i = 0; i < 3; ++i) {
+    REQUIRE(buffer[i] == dispatch());
+  }
+  native_uncached.fill(buffer.data() + 1, tests);
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(buffer[1 + i] == native());
+  }
+  REQUIRE(native_uncached() == native());
+  REQUIRE(dispatch_small() == dispatch());
+}
+
+TEST_CASE("STATE GROUPS", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  constexpr auto groups = 4UL;
+  prng::BasicXoshiroNative<256, groups> rng(seed);
+  prng::BasicXoshiroNative<256, groups> filled(seed);
+  prng::XoshiroScalar scalar(seed);
+  for (auto i = 0UL; i < SIMD_WIDTH * groups; ++i) {
+    REQUIRE(rng.getState(i) == scalar.getState());
+    scalar.jump();
+  }
+  // group g behaves like a single-group generator whose lanes start g * SIMD_WIDTH jumps further
+  std::vector<std::unique_ptr<prng::XoshiroNative>> references;
+  for (auto g = 0UL; g < groups; ++g) {
+    references.push_back(std::make_unique<prng::XoshiroNative>(seed));
+    for (auto i = 0UL; i < g * SIMD_WIDTH; ++i) {
+      references.back()->jump();
+    }
+  }
+  std::vector<prng::XoshiroNative::result_type> buffer(tests + 1);
+  filled.fill(buffer.data() + 1, tests);
+  for (auto i = 0UL; i < static_cast<unsigned long>(tests); i += SIMD_WIDTH) {
+    auto &reference = *references[i / SIMD_WIDTH % groups];
+    for (auto lane = 0UL; lane < SIMD_WIDTH; ++lane) {
+      const auto expected = reference();
+      REQUIRE(rng() == expected);
+      REQUIRE(buffer[1 + i + lane] == expected);
+    }
+  }
+}
+
+TEST_CASE("STATE GROUPS WIDER THAN THE UNROLL", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  // one block spans more than 256 values, so every refill step has to cover a whole block
+  constexpr auto groups = 256UL / SIMD_WIDTH + 1;
+  prng::BasicXoshiroNative<0, groups> rng(seed);
+  prng::BasicXoshiroNative<0, groups> filled(seed);
+  std::vector<prng::XoshiroNative::result_type> buffer(3 * SIMD_WIDTH * groups);
+  filled.fill(buffer.data(), buffer.size());
+  for (const auto expected : buffer) {
+    REQUIRE(rng() == expected);
+  }
+}
+
+namespace {
+
+/**
+ * Checks the first values of a canonical implementation created for a specific target against the scalar reference.
+ */
+template <class Arch>
+void check_canonical_target(const std::uint64_t seed, const std::vector<std::uint64_t> &expected,
+                            const bool available) {
+  if (!available) {
+    WARN(Arch::name() << " is not available on this CPU, skipping");
+    return;
+  }
+  INFO("target: " << Arch::name());
+  const auto *const table = prng::internal::XoshiroSIMDTableCreator<prng::ScramblerPlusPlus>{true}(Arch{});
+  alignas(64) std::array<std::uint64_t, prng::internal::XOSHIRO_SIMD_STATE_SIZE> state{};
+  table->seed(state.data(), seed, 0, 0);
+  std::vector<std::uint64_t> buffer(expected.size());
+  REQUIRE(table->fill_batches(state.data(), buffer.data(), buffer.size()) == buffer.size());
+  REQUIRE(buffer == expected);
+}
+
+} // namespace
+
+TEST_CASE("CANONICAL", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  // logical lane l is the seed jumped l times, and each block of CANONICAL_LANES values walks the lanes in order
+  constexpr auto lanes = prng::internal::CANONICAL_LANES;
+  std::vector<prng::XoshiroScalar> references;
+  prng::XoshiroScalar scalar(seed);
+  for (auto l = 0UL; l < lanes; ++l) {
+    references.push_back(scalar);
+    scalar.jump();
+  }
+  std::vector<std::uint64_t> expected(tests);
+  for (auto i = 0UL; i < expected.size(); ++i) {
+    expected[i] = references[i % lanes]();
+  }
+
+  prng::XoshiroNativeCanonical native(seed);
+  prng::XoshiroSIMDCanonical dispatch(seed);
+  prng::XoshiroSIMDCanonical filled(seed);
+  std::vector<std::uint64_t> buffer(tests + 1);
+  filled.fill(buffer.data() + 1, 3);
+  filled.fill(buffer.data() + 4, tests - 3);
+  for (auto i = 0UL; i < expected.size(); ++i) {
+    REQUIRE(native() == expected[i]);
+    REQUIRE(dispatch() == expected[i]);
+    REQUIRE(buffer[1 + i] == expected[i]);
+  }
+
+  const auto available = xsimd::available_architectures();
+  SECTION("sse2") { check_canonical_target<xsimd::sse2>(seed, expected, available.sse2); }
+  SECTION("sse4_2") { check_canonical_target<xsimd::sse4_2>(seed, expected, available.sse4_2); }
+  SECTION("fma3<avx2>") { check_canonical_target<xsimd::fma3<xsimd::avx2>>(seed, expected, available.fma3_avx2); }
+  SECTION("avx512f") { check_canonical_target<xsimd::avx512f>(seed, expected, available.avx512f); }
+}
+
+TEST_CASE("COPY", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  static_assert(std::is_trivially_copyable_v<prng::XoshiroSIMD>);
+  // the native generators point into their own cache, so they must not be copied or moved
+  static_assert(!std::is_copy_constructible_v<prng::XoshiroNative>);
+  static_assert(!std::is_move_constructible_v<prng::XoshiroNative>);
+  static_assert(!std::is_move_assignable_v<prng::BasicXoshiroNative<256, 4>>);
+  prng::XoshiroSIMD rng(seed);
+  for (auto i = 0; i < 100; ++i) {
+    rng();
+  }
+  auto copy = rng;
+  prng::XoshiroSIMD moved(seed);
+  moved = std::move(copy);
+  for (auto i = 0; i < tests; ++i) {
+    const auto expected = rng();
+    REQUIRE(moved() == expected);
+  }
+  rng.jump();
+  moved.jump();
+  REQUIRE(moved() == rng());
+}
+
+TEST_CASE("NEXT BATCH", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  prng::XoshiroNative rng(seed);
+  prng::XoshiroNative reference(seed);
+  // a fresh generator has an empty cache, so the batches follow the operator() stream
+  for (auto i = 0; i < 3; ++i) {
+    const auto batch = rng.next_batch();
+    for (auto lane = 0UL; lane < SIMD_WIDTH; ++lane) {
+      REQUIRE(batch.get(lane) == reference());
+    }
+  }
+  const auto uniform = rng.next_uniform_batch();
+  for (auto lane = 0UL; lane < SIMD_WIDTH; ++lane) {
+    REQUIRE(uniform.get(lane) == reference.uniform());
+  }
+  // once the cache holds values, the batch skips ahead and operator() still returns the cached values
+  std::vector<prng::XoshiroNative::result_type> expected(256 + SIMD_WIDTH);
+  for (auto &value : expected) {
+    value = reference();
+  }
+  REQUIRE(rng() == expected[0]);
+  const auto batch = rng.next_batch();
+  for (auto lane = 0UL; lane < SIMD_WIDTH; ++lane) {
+    REQUIRE(batch.get(lane) == expected[256 + lane]);
+  }
+  for (auto i = 1UL; i < 256; ++i) {
+    REQUIRE(rng() == expected[i]);
+  }
+  REQUIRE(rng() == reference());
+}
+
+namespace {
+
+/**
+ * Checks that the native and dispatched engines of one scrambler follow the matching scalar engine, lane by lane.
+ */
+template <class Scalar, class Native, class Dispatch> void check_scrambler(const std::uint64_t seed) {
+  std::vector<Scalar> lanes;
+  Scalar scalar(seed);
+  for (auto i = 0UL; i < SIMD_WIDTH; ++i) {
+    lanes.push_back(scalar);
+    scalar.jump();
+  }
+  Native native(seed);
+  Dispatch dispatch(seed);
+  Dispatch dispatch_reference(seed);
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(native() == lanes[i % SIMD_WIDTH]());
+  }
+  // the dispatched engine may run a different SIMD width, so it is compared with itself through fill()
+  std::vector<std::uint64_t> buffer(tests);
+  dispatch.fill(buffer.data(), buffer.size());
+  for (const auto value : buffer) {
+    REQUIRE(value == dispatch_reference());
+  }
+}
+
+} // namespace
+
+TEST_CASE("SCRAMBLERS", "[xoshiro256++]") {
+  const auto seed = std::random_device()();
+  INFO("SEED: " << seed);
+  check_scrambler<prng::XoshiroScalar, prng::XoshiroNative, prng::XoshiroSIMD>(seed);
+  check_scrambler<prng::XoshiroPlusScalar, prng::XoshiroPlusNative, prng::XoshiroPlusSIMD>(seed);
+  check_scrambler<prng::XoshiroStarStarScalar, prng::XoshiroStarStarNative, prng::XoshiroStarStarSIMD>(seed);
+  // all three share the linear engine, so canonical dispatch can be checked against the scalar engine on any target
+  prng::BasicXoshiroSIMD<256, true, prng::ScramblerStarStar> canonical(seed);
+  std::vector<prng::XoshiroStarStarScalar> lanes;
+  prng::XoshiroStarStarScalar scalar(seed);
+  for (auto i = 0UL; i < prng::internal::CANONICAL_LANES; ++i) {
+    lanes.push_back(scalar);
+    scalar.jump();
+  }
+  for (auto i = 0; i < tests; ++i) {
+    REQUIRE(canonical() == lanes[i % prng::internal::CANONICAL_LANES]());
+  }
+}